@@ -3,38 +3,35 @@
 /***************************** Include Files *******************************/
 #include "PmodENC544.h"
 
-/***************************** Global variables ****************************/
-static uint32_t baseAddress = 0L;
-static bool isInitialized = false;
-
 /************************** Function Definitions ***************************/
 /**
  * Initializes the PmodENC544 peripheral and runs the self-test
  *
- * @param   baseaddr_p  base address of the PmodENC544 peripheral
+ * @param   enc  PmodENC544 instance
+ *          baseaddr_p  base address of the PmodENC544 peripheral
  *
  * @return  returns XST_SUCCESS if the PmodENC544 is intialized, false otherwise
  *
  */
-XStatus PMODENC544_initialize(uint32_t baseaddr_p)
+XStatus PMODENC544_initialize(ptr_pmodenc544_t enc, uint32_t baseaddr_p)
 {
     XStatus sts;
     
     if (baseaddr_p == NULL) {
-        isInitialized = false;
+        enc->isInitialized = false;
         return XST_FAILURE;  
     }
     
-    if (isInitialized) {
+    if (enc->isInitialized) {
         return XST_SUCCESS;
     }
     else {
-        baseAddress = baseaddr_p;
-        sts = PMODENC544_Reg_SelfTest(baseAddress);
+        enc->baseAddress = baseaddr_p;
+        sts = PMODENC544_Reg_SelfTest(enc->baseAddress);
         if (sts != XST_SUCCESS)
             return XST_FAILURE;
-        PMODENC544_clearRotaryCount();
-        isInitialized = true;
+        PMODENC544_clearRotaryCount(enc);
+        enc->isInitialized = true;
     }
     return XST_SUCCESS; 
 }
@@ -43,17 +40,17 @@ XStatus PMODENC544_initialize(uint32_t baseaddr_p)
 /**
  * Returns the rotary encoder count
  *
- * @param   NONE - The base address is set with PMODENCE544_Initialize()
+ * @param   enc  PmodENC544 instance
  *
  * @return  The current rotary count
  *
  */
-uint32_t PMODENC544_getRotaryCount(void)
+uint32_t PMODENC544_getRotaryCount(ptr_pmodenc544_t enc)
 {
     uint32_t count;
     
-    if (isInitialized) {
-        count = PMODENC544_mReadReg(baseAddress, PMODENC544_ROTARY_COUNT_REG_OFFSET);
+    if (enc->isInitialized) {
+        count = PMODENC544_mReadReg(enc->baseAddress, PMODENC544_ROTARY_COUNT_REG_OFFSET);
     }
     else {
         count = 0xDEADBEEF;
@@ -66,17 +63,17 @@ uint32_t PMODENC544_getRotaryCount(void)
  * Returns the PmodENC button and switch values.  button is returned in bit[0].
  * switch is returned in bit[1].  All other bits are unused/reserved
  *
- * @param   NONE - The base address is set with PMODENCE544_Initialize()
+ * @param   enc  PmodENC544 instance
  *
  * @return  The "raw" values (just the bits) of the button and switch
  *
  */
-uint32_t PMODENC544_getBtnSwReg(void)
+uint32_t PMODENC544_getBtnSwReg(ptr_pmodenc544_t enc)
 {
     uint32_t btnsw;
     
-    if (isInitialized) {
-        btnsw = PMODENC544_mReadReg(baseAddress, PMODENC544_BTNSWT_REG_OFFSET);
+    if (enc->isInitialized) {
+        btnsw = PMODENC544_mReadReg(enc->baseAddress, PMODENC544_BTNSWT_REG_OFFSET) & PMODENC544_BTNSW_MASK;
     }
     else {
         btnsw = 0xDEADBEEF;
@@ -88,21 +85,21 @@ uint32_t PMODENC544_getBtnSwReg(void)
 /**
  * Sets the rotary encoder count register to 0
  *
- * @param   NONE - The base address is set with PMODENCE544_Initialize()
+ * @param   enc  PmodENC544 instance
  *
  * @return  rotary encoder count...which should be 0
  *
  */
-uint32_t PMODENC544_clearRotaryCount(void)
+uint32_t PMODENC544_clearRotaryCount(ptr_pmodenc544_t enc)
 {
     uint32_t count;
     
-    if (isInitialized) {
+    if (enc->isInitialized) {
         // toggle bit[0] of the clear rotary count register
-        count = 0x00000001;
-        PMODENC544_mWriteReg(baseAddress, PMODENC544_CLR_ROTARY_COUNT_REG_OFFSET, count);
-        PMODENC544_mWriteReg(baseAddress, PMODENC544_CLR_ROTARY_COUNT_REG_OFFSET, 0x0);
-        count = PMODENC544_getRotaryCount();
+        count = 0x00000001 | (enc->irqEnable << PMODENC544_IRQ_SHIFT);
+        PMODENC544_mWriteReg(enc->baseAddress, PMODENC544_CLR_ROTARY_COUNT_REG_OFFSET, count);
+        PMODENC544_mWriteReg(enc->baseAddress, PMODENC544_CLR_ROTARY_COUNT_REG_OFFSET, enc->irqEnable << PMODENC544_IRQ_SHIFT);
+        count = PMODENC544_getRotaryCount(enc);
     }
     else {
         count = 0xDEADBEEF;
@@ -114,19 +111,59 @@ uint32_t PMODENC544_clearRotaryCount(void)
 /**
  * Returns 1 if the PmodENC button (the rotary encoder shaft) is pressed
  *
- * @param   NONE - The base address is set with PMODENCE544_Initialize()
+ * @param   enc  PmodENC544 instance
  *
  * @return  returns true if the button is pressed, false otherwise
  *
  */
-bool PMODENC544_isBtnPressed(void)
+bool PMODENC544_isBtnPressed(ptr_pmodenc544_t enc)
 {
     uint32_t btnsw;
     
-    if (isInitialized){
-        btnsw = PMODENC544_mReadReg(baseAddress, PMODENC544_BTNSWT_REG_OFFSET);
+    if (enc->isInitialized){
+        btnsw = PMODENC544_mReadReg(enc->baseAddress, PMODENC544_BTNSWT_REG_OFFSET);
         return (btnsw & 0x1) ? true : false;
     }
     else
         return false; 
 }
+
+/**
+ * Enables the encoder change interrupt
+ *
+ * @param   enc  PmodENC544 instance
+ *          sources     PMODENC544_IRQ_ROTARY and/or PMODENC544_IRQ_BTNSW, 0 disables
+ *
+ * @return  void
+ *
+ */
+void PMODENC544_enableInterrupt(ptr_pmodenc544_t enc, uint32_t sources)
+{
+    if (enc->isInitialized) {
+        enc->irqEnable = sources & (PMODENC544_IRQ_ROTARY | PMODENC544_IRQ_BTNSW);
+        // drop anything that latched while disabled
+        PMODENC544_mWriteReg(enc->baseAddress, PMODENC544_BTNSWT_REG_OFFSET,
+                             (PMODENC544_IRQ_ROTARY | PMODENC544_IRQ_BTNSW) << PMODENC544_IRQ_SHIFT);
+        PMODENC544_mWriteReg(enc->baseAddress, PMODENC544_CLR_ROTARY_COUNT_REG_OFFSET, enc->irqEnable << PMODENC544_IRQ_SHIFT);
+    }
+}
+
+
+/**
+ * Clears the pending encoder change interrupts. Call from the interrupt
+ * handler before reading the count and button/switch, so a change after
+ * the read raises the interrupt again
+ *
+ * @param   enc  PmodENC544 instance
+ *
+ * @return  the enabled sources that were pending
+ *
+ */
+uint32_t PMODENC544_ackInterrupt(ptr_pmodenc544_t enc)
+{
+    uint32_t status;
+
+    status = (PMODENC544_mReadReg(enc->baseAddress, PMODENC544_BTNSWT_REG_OFFSET) >> PMODENC544_IRQ_SHIFT) & enc->irqEnable;
+    PMODENC544_mWriteReg(enc->baseAddress, PMODENC544_BTNSWT_REG_OFFSET, status << PMODENC544_IRQ_SHIFT);
+    return status;
+}
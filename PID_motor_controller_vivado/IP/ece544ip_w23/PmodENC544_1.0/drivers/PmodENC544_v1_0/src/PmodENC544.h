@@ -14,8 +14,26 @@
 #define PMODENC544_CLR_ROTARY_COUNT_REG_OFFSET 8
 #define PMODENC544_SPARE_REG_OFFSET 12
 
+// button/switch register fields. The interrupt status bits read back in
+// [9:8] and are cleared by writing 1s there, the enables are the same bits
+// of the clear rotary count register
+#define PMODENC544_BTNSW_MASK 0x3
+#define PMODENC544_IRQ_SHIFT 8
+
+// encoder change interrupt sources
+#define PMODENC544_IRQ_ROTARY 0x1 // knob moved one detent
+#define PMODENC544_IRQ_BTNSW 0x2 // debounced button or switch changed
+
 
 /**************************** Type Definitions *****************************/
+// one per PmodENC544, every PMODENC544_ call takes the instance. Zero it
+// before PMODENC544_initialize()
+typedef struct pmodenc544 {
+    uint32_t baseAddress;
+    bool isInitialized;
+    uint32_t irqEnable;     // kept in the clear register next to the clear bit
+} pmodenc544_t, *ptr_pmodenc544_t;
+
 /**
  *
  * Write a value to a PMODENC544 register. A 32 bit write is performed.
@@ -79,10 +97,12 @@
 XStatus PMODENC544_Reg_SelfTest(uint32_t baseaddr_p);
 
 // API function prototypes
-XStatus PMODENC544_initialize(uint32_t baseaddr_p);
-uint32_t PMODENC544_getRotaryCount(void);
-uint32_t PMODENC544_getBtnSwReg(void);
-uint32_t PMODENC544_clearRotaryCount(void);
-bool PMODENC544_isBtnPressed(void);
+XStatus PMODENC544_initialize(ptr_pmodenc544_t enc, uint32_t baseaddr_p);
+uint32_t PMODENC544_getRotaryCount(ptr_pmodenc544_t enc);
+uint32_t PMODENC544_getBtnSwReg(ptr_pmodenc544_t enc);
+uint32_t PMODENC544_clearRotaryCount(ptr_pmodenc544_t enc);
+bool PMODENC544_isBtnPressed(ptr_pmodenc544_t enc);
+void PMODENC544_enableInterrupt(ptr_pmodenc544_t enc, uint32_t sources);
+uint32_t PMODENC544_ackInterrupt(ptr_pmodenc544_t enc);
 
 #endif // PMODENC544_H
@@ -19,6 +19,7 @@
         input wire encB,
         input wire encBTN,   // pushbutton input from PmodENC
         input wire encSWT,   // slide switch input from PmodENC
+        output wire enc_irq,
 		// User ports ends
 		// Do not modify the ports beyond this line
 
@@ -54,6 +55,7 @@
 	    .encB(encB),
 	    .encBTN(encBTN),
 	    .encSWT(encSWT),
+	    .enc_irq(enc_irq),
 	    
 		.S_AXI_ACLK(s00_axi_aclk),
 		.S_AXI_ARESETN(s00_axi_aresetn),
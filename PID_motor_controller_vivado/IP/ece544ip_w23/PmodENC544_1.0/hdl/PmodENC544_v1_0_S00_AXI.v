@@ -19,6 +19,7 @@
         input wire encB,
         input wire encBTN,   // pushbutton input from PmodENC
         input wire encSWT,   // slide switch input from PmodENC
+        output wire enc_irq, // level high while an enabled encoder change is pending
 		// User ports ends
 		// Do not modify the ports beyond this line
 
@@ -108,8 +109,8 @@
 	//------------------------------------------------
 	//-- Number of Slave Registers 4
 	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg0;     // rotary count - read-only
-	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg1;     // button [bit[0]) and slide switch (bit[1])
-	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg2;     // clear rotary count.  Set bit[0] to clear.  must set back to 0 after reset.
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg1;     // button [bit[0]) and slide switch (bit[1]), irq status bits[9:8]
+	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg2;     // clear rotary count.  Set bit[0] to clear.  must set back to 0 after reset.  irq enable bits[9:8]
 	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg3;     // *RESERVED* (spare)
 	
 	wire	 slv_reg_rden;
@@ -416,6 +417,8 @@
 	wire db_encBTN, db_encSWT;          // debounce encoder button and switch
 	wire rotary_event, rotary_left;    // rotary_event toggled every time toe rotary encoder shaft is turned, rotary_left gives the direction of rotation
 	wire clr_rotary_cnt;               // clear rotary count signal
+	reg [1:0] enc_status;              // pending encoder interrupts [1]=button/switch [0]=rotary
+	reg [1:0] btnsw_prev;              // debounced button and switch one clock ago
 	
 	// instantiate the quadrature decoder for the rotary encoder shaft
 	rotary_filter ROTFILTER (
@@ -449,9 +452,28 @@
     // map the slave register
     always @* begin
         slv_reg0 = rotary_count;
-        slv_reg1 = {30'b000000000000000000000000000000, db_encSWT, db_encBTN};
+        slv_reg1 = {22'b0000000000000000000000, enc_status, 6'b000000, db_encSWT, db_encBTN};
     end
     
+    // encoder change interrupt. slv_reg2[9:8] enables the button/switch and
+    // rotary sources, writing a 1 to bits[9:8] of the read-only button and
+    // switch register (0x04) clears them. A change in the same clock as the
+    // clear wins. The rotary source is set once per detent
+    always @(posedge S_AXI_ACLK) begin
+        if (S_AXI_ARESETN == 1'b0) begin
+            btnsw_prev <= 2'b00;
+            enc_status <= 2'b00;
+        end
+        else begin
+            btnsw_prev <= {db_encSWT, db_encBTN};
+            if (slv_reg_wren && axi_awaddr[ADDR_LSB+OPT_MEM_ADDR_BITS:ADDR_LSB] == 2'h1)
+                enc_status <= (enc_status & ~S_AXI_WDATA[9:8]) | {btnsw_prev != {db_encSWT, db_encBTN}, rotary_event};
+            else
+                enc_status <= enc_status | {btnsw_prev != {db_encSWT, db_encBTN}, rotary_event};
+        end
+    end
+    assign enc_irq = |(enc_status & slv_reg2[9:8]);
+    
     // implement the clr_rotary_count signal from bit[0] of slv_reg2.  1 to clear
     assign clr_rotary_cnt = slv_reg2[0];
 	// User logic ends
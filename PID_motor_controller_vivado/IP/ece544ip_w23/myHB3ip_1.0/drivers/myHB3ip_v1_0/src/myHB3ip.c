@@ -3,37 +3,44 @@
 /***************************** Include Files *******************************/
 #include "myHB3ip.h"
 
-/***************************** Global variables ****************************/
-static uint32_t baseAddress = 0L;
-static bool isInitialized = false;
-
 /************************** Function Definitions ***************************/
 /**
- * Initializes the PmodENC544 peripheral and runs the self-test
+ * RPM x 100 to whole RPM, truncated, without a divide
+ */
+static inline uint32_t rpm100_to_rpm(uint32_t rpm100)
+{
+    return (rpm100 * HB3_DIV100_RECIP_Q19) >> HB3_DIV100_SHIFT;
+}
+
+/**
+ * Initializes a myHB3ip instance and runs the self-test
  *
- * @param   baseaddr_p  base address of the PmodENC544 peripheral
+ * @param   hb3  myHB3ip instance, one per motor
+ *          baseaddr_p  base address of the myHB3ip peripheral
  *
  * @return  returns XST_SUCCESS if the PmodENC544 is intialized, false otherwise
  *
  */
-XStatus HB3_initialize(uint32_t baseaddr_p)
+XStatus HB3_initialize(ptr_hb3_t hb3, uint32_t baseaddr_p)
 {
     XStatus sts;
     
     if (baseaddr_p == NULL) {
-        isInitialized = false;
+        hb3->isInitialized = false;
         return XST_FAILURE;  
     }
     
-    if (isInitialized) {
+    if (hb3->isInitialized) {
         return XST_SUCCESS;
     }
     else {
-        baseAddress = baseaddr_p;
-        sts = MYHB3IP_Reg_SelfTest(baseAddress);
+        hb3->baseAddress = baseaddr_p;
+        sts = MYHB3IP_Reg_SelfTest(hb3->baseAddress);
         if (sts != XST_SUCCESS)
             return XST_FAILURE;
-        isInitialized = true;
+        hb3->isInitialized = true;
+        hb3->numChannels = HB3_getChannels(hb3);
+        hb3->fabricPID = (MYHB3IP_mReadReg(hb3->baseAddress, HB3_PWM_CFG_OFFSET) & HB3_CFG_PID_ACCEL) != 0;
     }
     return XST_SUCCESS; 
 }
@@ -41,42 +48,156 @@ XStatus HB3_initialize(uint32_t baseaddr_p)
 /**
  * Sets the PWM output of the HB3
  *
- * @param   enable enable signal to turn the PWM signal on or off
+ * @param   hb3  myHB3ip instance
+ *          enable enable signal to turn the PWM signal on or off
  *          DC     u16 value truncated to 10 bits to set duty cycle
  *
  * @return  void
  *
  */
-void HB3_setPWM(bool enable, u16 DC)
+void HB3_setPWM(ptr_hb3_t hb3, bool enable, u16 DC)
+{
+	HB3_setPWMDuty(hb3, enable, (DC & 0x03FF) << HB3_PWM_COUNT_SHIFT);
+}
+
+
+/**
+ * Sets the PWM output of the HB3 at full resolution
+ *
+ * @param   hb3  myHB3ip instance
+ *          enable enable signal to turn the PWM signal on or off
+ *          duty   duty cycle as a 16 bit fraction, 0x8000 is 50%. The IP
+ *                 keeps the top PWM_BITS of it
+ *
+ * @return  void
+ *
+ */
+void HB3_setPWMDuty(ptr_hb3_t hb3, bool enable, u16 duty)
 {
 	u32 cntlreg;
 
-	// initialize the value depending on whether PWM is enabled
-	// enable is Control register[31]
-	cntlreg = (enable) ? 0x80000000 : 0x0000000;
+	// enable is Control register[31], the duty cycle sits below it
+	cntlreg = (enable) ? HB3_PWM_ENABLE : 0x0000000;
+	cntlreg |= ((u32)duty << HB3_PWM_DUTY_SHIFT);
 
-	// add the duty cycles
-	cntlreg |= ((DC & 0x03FF) << 20);
+	if (hb3->isInitialized){
+		MYHB3IP_mWriteReg(hb3->baseAddress, HB3_PWM_OFFSET, cntlreg);
+	}
+}
 
-	if (isInitialized){
-		MYHB3IP_mWriteReg(baseAddress, HB3_PWM_OFFSET, cntlreg);
+
+/**
+ * Sets the PWM output of one channel of a multi-channel myHB3ip
+ *
+ * @param   hb3  myHB3ip instance
+ *          ch     channel, 0 is the same as HB3_setPWM()
+ *          enable enable signal to turn the PWM signal on or off
+ *          DC     u16 value truncated to 10 bits to set duty cycle
+ *
+ * @return  void
+ *
+ */
+void HB3_setChannelPWM(ptr_hb3_t hb3, uint32_t ch, bool enable, u16 DC)
+{
+	u32 cntlreg;
+
+	if (ch == 0) {
+		HB3_setPWM(hb3, enable, DC);
 	}
+	else if (hb3->isInitialized && ch < hb3->numChannels) {
+		cntlreg = (enable) ? HB3_PWM_ENABLE : 0x0000000;
+		cntlreg |= ((u32)(DC & 0x03FF) << (HB3_PWM_COUNT_SHIFT + HB3_PWM_DUTY_SHIFT));
+		MYHB3IP_mWriteReg(hb3->baseAddress, HB3_CH_PWM_OFFSET + (ch - 1) * 4, cntlreg);
+	}
+}
+
+
+/**
+ * Returns the duty cycle resolution the IP was built with
+ *
+ * @param   hb3  myHB3ip instance
+ *
+ * @return  returns PWM_BITS (8 to 16) if initialized, 0 otherwise
+ *
+ */
+uint32_t HB3_getPWMBits(ptr_hb3_t hb3)
+{
+    uint32_t bits = 0;
+    if (hb3->isInitialized) {
+        bits = (MYHB3IP_mReadReg(hb3->baseAddress, HB3_PWM_CFG_OFFSET) >> HB3_PWM_BITS_SHIFT) & HB3_PWM_BITS_MASK;
+    }
+    return bits;
+}
+
+
+/**
+ * Sets the PWM carrier frequency
+ *
+ * @param   hb3  myHB3ip instance
+ *          hz  carrier frequency, rounded to the nearest the prescaler can
+ *              make and held to what it can reach
+ *
+ * @return  returns the carrier frequency set in Hz if initialized, 0 otherwise
+ *
+ * @note    divides, so call it at setup rather than from the control loop
+ *
+ */
+uint32_t HB3_setPWMCarrier(ptr_hb3_t hb3, uint32_t hz)
+{
+    uint32_t period;    // clocks per count at the requested carrier
+    uint32_t bits;
+
+    if (!hb3->isInitialized || hz == 0) {
+        return 0;
+    }
+    bits = HB3_getPWMBits(hb3);
+    period = ((HB3_AXI_CLK_FREQ_HZ >> bits) + hz / 2) / hz;
+    if (period < 1) {
+        period = 1;
+    }
+    else if (period > HB3_PWM_PRESCALE_MASK + 1) {
+        period = HB3_PWM_PRESCALE_MASK + 1;
+    }
+    MYHB3IP_mWriteReg(hb3->baseAddress, HB3_PWM_CFG_OFFSET, period - 1);
+    return HB3_getPWMCarrier(hb3);
+}
+
+
+/**
+ * Returns the PWM carrier frequency
+ *
+ * @param   hb3  myHB3ip instance
+ *
+ * @return  returns the carrier frequency in Hz, truncated, if initialized,
+ *          0 otherwise
+ *
+ */
+uint32_t HB3_getPWMCarrier(ptr_hb3_t hb3)
+{
+    uint32_t cfg;
+
+    if (!hb3->isInitialized) {
+        return 0;
+    }
+    cfg = MYHB3IP_mReadReg(hb3->baseAddress, HB3_PWM_CFG_OFFSET);
+    return (HB3_AXI_CLK_FREQ_HZ >> ((cfg >> HB3_PWM_BITS_SHIFT) & HB3_PWM_BITS_MASK))
+           / ((cfg & HB3_PWM_PRESCALE_MASK) + 1);
 }
 
 
 /**
  * Returns the number of ticks per second, value updated every 0.25s
  *
- * @param   void
+ * @param   hb3  myHB3ip instance
  *
  * @return  returns count if initialized it returns the ticks/second
  *
  */
-uint32_t HB3_getTicks(void)
+uint32_t HB3_getTicks(ptr_hb3_t hb3)
 {
     uint32_t count;
-    if (isInitialized) {
-        count = MYHB3IP_mReadReg(baseAddress, HB3_TICKS_OFFSET);
+    if (hb3->isInitialized) {
+        count = MYHB3IP_mReadReg(hb3->baseAddress, HB3_TICKS_OFFSET);
     }
     else{
         count = 0xDEADBEEF;
@@ -88,21 +209,561 @@ uint32_t HB3_getTicks(void)
 /**
  * Returns the RPM of the motor, value updated every 0.25s
  *
- * @param   void
+ * @param   hb3  myHB3ip instance
  *
  * @return  returns rpm if initialized returns the rpm
  *
  */
-uint32_t HB3_getRPM(void)
+uint32_t HB3_getRPM(ptr_hb3_t hb3)
+{
+    uint32_t rpm;
+    if(hb3->isInitialized){
+        rpm = rpm100_to_rpm(MYHB3IP_mReadReg(hb3->baseAddress, HB3_RPM100_WINDOW_OFFSET));
+    }
+    else{
+        rpm = 0xDEADBEEF;
+    }
+    return rpm;
+}
+
+
+/**
+ * Returns the number of clocks between the last two tachA rising edges,
+ * value updated on every edge
+ *
+ * @param   hb3  myHB3ip instance
+ *
+ * @return  returns the period if initialized, 0 if the motor is stopped
+ *
+ */
+uint32_t HB3_getPeriod(ptr_hb3_t hb3)
+{
+    uint32_t period;
+    if (hb3->isInitialized) {
+        period = MYHB3IP_mReadReg(hb3->baseAddress, HB3_PERIOD_OFFSET);
+    }
+    else{
+        period = 0xDEADBEEF;
+    }
+    return period;
+}
+
+
+/**
+ * Returns the running average of the tachA period, value updated on every edge
+ *
+ * @param   hb3  myHB3ip instance
+ *
+ * @return  returns the average period if initialized, 0 if the motor is stopped
+ *
+ */
+uint32_t HB3_getPeriodAvg(ptr_hb3_t hb3)
+{
+    uint32_t period;
+    if (hb3->isInitialized) {
+        period = MYHB3IP_mReadReg(hb3->baseAddress, HB3_PERIOD_AVG_OFFSET);
+    }
+    else{
+        period = 0xDEADBEEF;
+    }
+    return period;
+}
+
+
+/**
+ * Returns the free running count of tachA rising edges. A change in the
+ * count means a new period has been captured
+ *
+ * @param   hb3  myHB3ip instance
+ *
+ * @return  returns the edge count if initialized
+ *
+ */
+uint32_t HB3_getEdgeCount(ptr_hb3_t hb3)
+{
+    uint32_t count;
+    if (hb3->isInitialized) {
+        count = MYHB3IP_mReadReg(hb3->baseAddress, HB3_EDGE_COUNT_OFFSET);
+    }
+    else{
+        count = 0xDEADBEEF;
+    }
+    return count;
+}
+
+
+/**
+ * Returns the RPM of the motor from the averaged tachA period, value
+ * updated on every tach edge instead of every 0.25s
+ *
+ * @param   hb3  myHB3ip instance
+ *
+ * @return  returns rpm if initialized, 0 if the motor is stopped
+ *
+ */
+uint32_t HB3_getRPMFast(ptr_hb3_t hb3)
 {
     uint32_t rpm;
-    if(isInitialized){
-        rpm = MYHB3IP_mReadReg(baseAddress, HB3_TICKS_OFFSET);
-        rpm *= 60; //60 seconds per minute
-        rpm /= 823.13; // 11 ticks * 74.83 gear ratio
+    if(hb3->isInitialized){
+        rpm = rpm100_to_rpm(MYHB3IP_mReadReg(hb3->baseAddress, HB3_RPM100_PERIOD_OFFSET));
+    }
+    else{
+        rpm = 0xDEADBEEF;
+    }
+    return rpm;
+}
+
+
+/**
+ * Returns RPM x 100 of the motor from the 0.25s tick window, computed in
+ * fabric. Value updated every 0.25s
+ *
+ * @param   hb3  myHB3ip instance
+ *
+ * @return  returns rpm * 100 if initialized
+ *
+ */
+uint32_t HB3_getRPM100(ptr_hb3_t hb3)
+{
+    uint32_t rpm100;
+    if(hb3->isInitialized){
+        rpm100 = MYHB3IP_mReadReg(hb3->baseAddress, HB3_RPM100_WINDOW_OFFSET);
+    }
+    else{
+        rpm100 = 0xDEADBEEF;
+    }
+    return rpm100;
+}
+
+
+/**
+ * Returns RPM x 100 of the motor from the averaged tachA period, computed
+ * in fabric. Value updated on every tach edge
+ *
+ * @param   hb3  myHB3ip instance
+ *
+ * @return  returns rpm * 100 if initialized, 0 if the motor is stopped
+ *
+ */
+uint32_t HB3_getRPM100Fast(ptr_hb3_t hb3)
+{
+    uint32_t rpm100;
+    if(hb3->isInitialized){
+        rpm100 = MYHB3IP_mReadReg(hb3->baseAddress, HB3_RPM100_PERIOD_OFFSET);
+    }
+    else{
+        rpm100 = 0xDEADBEEF;
+    }
+    return rpm100;
+}
+
+
+/**
+ * Returns the signed x4 quadrature position of the motor. Every edge on
+ * tachA or tachB counts, positive is tachA leading tachB
+ *
+ * @param   hb3  myHB3ip instance
+ *
+ * @return  returns the position if initialized
+ *
+ */
+int32_t HB3_getPosition(ptr_hb3_t hb3)
+{
+    int32_t position;
+    if (hb3->isInitialized) {
+        position = (int32_t)MYHB3IP_mReadReg(hb3->baseAddress, HB3_QUAD_POSITION_OFFSET);
+    }
+    else{
+        position = 0xDEADBEEF;
+    }
+    return position;
+}
+
+
+/**
+ * Returns the signed quadrature speed in counts/second, value updated
+ * every 0.25s
+ *
+ * @param   hb3  myHB3ip instance
+ *
+ * @return  returns the speed if initialized
+ *
+ */
+int32_t HB3_getQuadSpeed(ptr_hb3_t hb3)
+{
+    int32_t speed;
+    if (hb3->isInitialized) {
+        speed = (int32_t)MYHB3IP_mReadReg(hb3->baseAddress, HB3_QUAD_SPEED_OFFSET);
+    }
+    else{
+        speed = 0xDEADBEEF;
+    }
+    return speed;
+}
+
+
+/**
+ * Returns the signed RPM of the motor from the quadrature speed, negative
+ * when the motor is turning backwards. Value updated every 0.25s
+ *
+ * @param   hb3  myHB3ip instance
+ *
+ * @return  returns rpm if initialized
+ *
+ */
+int32_t HB3_getQuadRPM(ptr_hb3_t hb3)
+{
+    int32_t rpm;
+    if(hb3->isInitialized){
+        int32_t speed = (int32_t)MYHB3IP_mReadReg(hb3->baseAddress, HB3_QUAD_SPEED_OFFSET);
+        // scale the magnitude so the shift rounds toward zero for both directions
+        uint32_t mag = (speed < 0) ? -speed : speed;
+        mag = (mag * HB3_QUAD_RPM_RECIP_Q20) >> HB3_RPM_SHIFT;
+        rpm = (speed < 0) ? -(int32_t)mag : (int32_t)mag;
     }
     else{
         rpm = 0xDEADBEEF;
     }
     return rpm;
-}
\ No newline at end of file
+}
+
+
+/**
+ * Returns the direction of the last quadrature edge
+ *
+ * @param   hb3  myHB3ip instance
+ *
+ * @return  returns true if the motor is turning backwards
+ *
+ */
+bool HB3_isReversed(ptr_hb3_t hb3)
+{
+    bool reversed = false;
+    if(hb3->isInitialized){
+        reversed = MYHB3IP_mReadReg(hb3->baseAddress, HB3_QUAD_DIRECTION_OFFSET) & 0x1;
+    }
+    return reversed;
+}
+
+
+/**
+ * Enables the new sample interrupt. With both sources enabled the cached
+ * RPM comes from the period, which is the newer of the two
+ *
+ * @param   hb3  myHB3ip instance
+ *          sources     HB3_IRQ_WINDOW and/or HB3_IRQ_PERIOD, 0 disables
+ *
+ * @return  void
+ *
+ */
+void HB3_enableSampleInterrupt(ptr_hb3_t hb3, uint32_t sources)
+{
+    if (hb3->isInitialized) {
+        hb3->irqSources = sources & (HB3_IRQ_WINDOW | HB3_IRQ_PERIOD);
+        // drop anything that latched while disabled
+        MYHB3IP_mWriteReg(hb3->baseAddress, HB3_IRQ_STATUS_OFFSET, HB3_IRQ_WINDOW | HB3_IRQ_PERIOD);
+        MYHB3IP_mWriteReg(hb3->baseAddress, HB3_IRQ_ENABLE_OFFSET, hb3->irqSources);
+    }
+}
+
+
+/**
+ * New sample interrupt handler. Reads the new RPM x 100 once and caches it
+ * so readers do not go back out on the bus. The interrupt is raised after
+ * the fabric conversion so the register is already up to date. The status
+ * is cleared before the read, so a sample that lands after the clear
+ * raises the interrupt again instead of being acknowledged unread
+ *
+ * @param   CallBackRef the hb3_t instance, connect with XIntc_Connect()
+ *          one handler per myHB3ip with its own instance
+ *
+ * @return  void
+ *
+ */
+void HB3_SampleHandler(void *CallBackRef)
+{
+    ptr_hb3_t hb3 = (ptr_hb3_t)CallBackRef;
+    uint32_t status = MYHB3IP_mReadReg(hb3->baseAddress, HB3_IRQ_STATUS_OFFSET) & hb3->irqSources;
+
+    MYHB3IP_mWriteReg(hb3->baseAddress, HB3_IRQ_STATUS_OFFSET, status);
+    if (status) {
+        uint32_t rpm100 = MYHB3IP_mReadReg(hb3->baseAddress, (status & HB3_IRQ_PERIOD) ?
+                                           HB3_RPM100_PERIOD_OFFSET : HB3_RPM100_WINDOW_OFFSET);
+        hb3->cachedRPM100 = rpm100;
+        hb3->cachedRPM = rpm100_to_rpm(rpm100);
+        hb3->sampleSeq++;
+    }
+}
+
+
+/**
+ * Checks for a new speed measurement since the last call
+ *
+ * @param   hb3  myHB3ip instance
+ *
+ * @return  returns true if any sample came in since the last call. The
+ *          handler only counts and this only compares, so a sample that
+ *          comes in during the call is reported by the next one
+ *
+ */
+bool HB3_isNewSample(ptr_hb3_t hb3)
+{
+    uint32_t seq = hb3->sampleSeq;
+    bool isNew = (seq != hb3->seenSeq);
+
+    hb3->seenSeq = seq;
+    return isNew;
+}
+
+
+/**
+ * Returns the RPM converted by the last new sample interrupt. No bus access
+ *
+ * @param   hb3  myHB3ip instance
+ *
+ * @return  returns the cached rpm
+ *
+ */
+uint32_t HB3_getCachedRPM(ptr_hb3_t hb3)
+{
+    return hb3->cachedRPM;
+}
+
+
+/**
+ * Returns the RPM x 100 read by the last new sample interrupt. No bus access
+ *
+ * @param   hb3  myHB3ip instance
+ *
+ * @return  returns the cached rpm * 100
+ *
+ */
+uint32_t HB3_getCachedRPM100(ptr_hb3_t hb3)
+{
+    return hb3->cachedRPM100;
+}
+
+
+/**
+ * Selects CPU or fabric control of the PWM duty cycle
+ *
+ * @param   hb3  myHB3ip instance
+ *          ctrl    HB3_PID_FABRIC and/or HB3_PID_SRC_PERIOD, 0 hands the
+ *                  duty cycle back to HB3_setPWM() and clears the PID state
+ *
+ * @return  void
+ *
+ */
+void HB3_setPIDMode(ptr_hb3_t hb3, uint32_t ctrl)
+{
+    if (hb3->isInitialized) {
+        MYHB3IP_mWriteReg(hb3->baseAddress, HB3_PID_CTRL_OFFSET, ctrl & (HB3_PID_FABRIC | HB3_PID_SRC_PERIOD));
+    }
+}
+
+
+/**
+ * Loads the fabric PID gains, the integrator is kept
+ *
+ * @param   hb3  myHB3ip instance
+ *          kp, ki, kd  Q16.16 gains, same scale as pid_fixed_set_gains()
+ *
+ * @return  void
+ *
+ */
+void HB3_setPIDGains(ptr_hb3_t hb3, int32_t kp, int32_t ki, int32_t kd)
+{
+    if (hb3->isInitialized) {
+        MYHB3IP_mWriteReg(hb3->baseAddress, HB3_PID_KP_OFFSET, kp);
+        MYHB3IP_mWriteReg(hb3->baseAddress, HB3_PID_KI_OFFSET, ki);
+        MYHB3IP_mWriteReg(hb3->baseAddress, HB3_PID_KD_OFFSET, kd);
+    }
+}
+
+
+/**
+ * Sets the fabric PID clamps
+ *
+ * @param   hb3  myHB3ip instance
+ *          i_limit     Q16.16 rpm, integrator held within +/- i_limit
+ *          out_limit   Q16.16 rpm, correction held within +/- out_limit
+ *
+ * @return  void
+ *
+ */
+void HB3_setPIDLimits(ptr_hb3_t hb3, int32_t i_limit, int32_t out_limit)
+{
+    if (hb3->isInitialized) {
+        MYHB3IP_mWriteReg(hb3->baseAddress, HB3_PID_I_LIMIT_OFFSET, i_limit);
+        MYHB3IP_mWriteReg(hb3->baseAddress, HB3_PID_OUT_LIMIT_OFFSET, out_limit);
+    }
+}
+
+
+/**
+ * Sets the fabric PID setpoint. The duty cycle is feedforward plus the
+ * PID correction times slope, clamped to 0..1023
+ *
+ * @param   hb3  myHB3ip instance
+ *          rpm100      setpoint, RPM x 100
+ *          feedforward PWM count that runs the motor at the setpoint
+ *          slope       Q16.16 PWM counts per rpm around the setpoint
+ *
+ * @return  void
+ *
+ */
+void HB3_setPIDSetpoint(ptr_hb3_t hb3, uint32_t rpm100, uint32_t feedforward, int32_t slope)
+{
+    if (hb3->isInitialized) {
+        MYHB3IP_mWriteReg(hb3->baseAddress, HB3_PID_SETPOINT_OFFSET, rpm100);
+        MYHB3IP_mWriteReg(hb3->baseAddress, HB3_PID_FF_OFFSET, feedforward);
+        MYHB3IP_mWriteReg(hb3->baseAddress, HB3_PID_SLOPE_OFFSET, slope);
+    }
+}
+
+
+/**
+ * Returns the error from the last fabric PID step
+ *
+ * @param   hb3  myHB3ip instance
+ *
+ * @return  returns the Q16.16 rpm error if initialized, 0 otherwise
+ *
+ */
+int32_t HB3_getPIDError(ptr_hb3_t hb3)
+{
+    int32_t error = 0;
+    if (hb3->isInitialized) {
+        error = (int32_t)MYHB3IP_mReadReg(hb3->baseAddress, HB3_PID_ERROR_OFFSET);
+    }
+    return error;
+}
+
+
+/**
+ * Returns the fabric PID integrator
+ *
+ * @param   hb3  myHB3ip instance
+ *
+ * @return  returns the Q16.16 rpm integrator if initialized, 0 otherwise
+ *
+ */
+int32_t HB3_getPIDIntegrator(ptr_hb3_t hb3)
+{
+    int32_t integrator = 0;
+    if (hb3->isInitialized) {
+        integrator = (int32_t)MYHB3IP_mReadReg(hb3->baseAddress, HB3_PID_INTEGRATOR_OFFSET);
+    }
+    return integrator;
+}
+
+
+/**
+ * Returns the PWM count the fabric PID is driving
+ *
+ * @param   hb3  myHB3ip instance
+ *
+ * @return  returns the duty cycle count if initialized, 0 otherwise
+ *
+ */
+uint32_t HB3_getPIDOutput(ptr_hb3_t hb3)
+{
+    uint32_t output = 0;
+    if (hb3->isInitialized) {
+        output = MYHB3IP_mReadReg(hb3->baseAddress, HB3_PID_OUTPUT_OFFSET);
+    }
+    return output;
+}
+
+
+/**
+ * Checks the IP was built with the fabric PID (PID_ACCEL = 1). Only
+ * channel 0 of it has one. No bus access
+ *
+ * @param   hb3  myHB3ip instance
+ *
+ * @return  returns true if HB3_setPIDMode() can hand it the duty cycle
+ *
+ */
+bool HB3_hasFabricPID(ptr_hb3_t hb3)
+{
+    return hb3->fabricPID;
+}
+
+
+/**
+ * Returns the number of motor channels the IP was built with
+ *
+ * @param   hb3  myHB3ip instance
+ *
+ * @return  returns NUM_CHANNELS (1 to 4) if initialized, 0 otherwise. An IP
+ *          from before the field reads 0 there and is 1 channel
+ *
+ */
+uint32_t HB3_getChannels(ptr_hb3_t hb3)
+{
+    uint32_t channels = 0;
+    if (hb3->isInitialized) {
+        channels = (MYHB3IP_mReadReg(hb3->baseAddress, HB3_PWM_CFG_OFFSET) >> HB3_NUM_CH_SHIFT) & HB3_NUM_CH_MASK;
+        if (channels == 0) {
+            channels = 1;
+        }
+        else if (channels > HB3_MAX_CHANNELS) {
+            channels = HB3_MAX_CHANNELS;
+        }
+    }
+    return channels;
+}
+
+
+/**
+ * Latches every channel's speed in the same clock and reads them back to
+ * back, one word per channel, then caches them converted to RPM. The
+ * speeds come from the period when HB3_IRQ_PERIOD is an enabled sample
+ * source, the 0.25s window otherwise, the same choice the sample
+ * interrupt makes. 2 + NUM_CHANNELS bus accesses for the whole IP
+ *
+ * @param   hb3  myHB3ip instance
+ *
+ * @return  returns a bit per channel that had a new sample since the
+ *          previous latch, 0 if not initialized
+ *
+ */
+uint32_t HB3_latchChannels(ptr_hb3_t hb3)
+{
+    uint32_t flags, offset, fresh;
+
+    if (!hb3->isInitialized) {
+        return 0;
+    }
+    MYHB3IP_mWriteReg(hb3->baseAddress, HB3_LATCH_OFFSET, 1);
+    flags = MYHB3IP_mReadReg(hb3->baseAddress, HB3_LATCH_OFFSET);
+    if (hb3->irqSources & HB3_IRQ_PERIOD) {
+        offset = HB3_SNAP_RPM100_PERIOD_OFFSET;
+        fresh = (flags >> HB3_LATCH_FRESH_PERIOD_SHIFT) & HB3_LATCH_FRESH_MASK;
+    }
+    else {
+        offset = HB3_SNAP_RPM100_WINDOW_OFFSET;
+        fresh = (flags >> HB3_LATCH_FRESH_WINDOW_SHIFT) & HB3_LATCH_FRESH_MASK;
+    }
+    for (uint32_t ch = 0; ch < hb3->numChannels; ch++) {
+        hb3->chRPM[ch] = rpm100_to_rpm(MYHB3IP_mReadReg(hb3->baseAddress, offset + ch * 4));
+    }
+    return fresh & ((1 << hb3->numChannels) - 1);
+}
+
+
+/**
+ * Returns the RPM of one channel from the last HB3_latchChannels(). No bus
+ * access
+ *
+ * @param   hb3  myHB3ip instance
+ *          ch   channel
+ *
+ * @return  returns the latched rpm, 0 for a channel the IP does not have
+ *
+ */
+uint32_t HB3_getChannelRPM(ptr_hb3_t hb3, uint32_t ch)
+{
+    return (ch < hb3->numChannels) ? hb3->chRPM[ch] : 0;
+}
@@ -13,9 +13,117 @@
 #define HB3_TICKS_OFFSET 4
 #define MYHB3IP_S00_AXI_SLV_REG2_OFFSET 8
 #define MYHB3IP_S00_AXI_SLV_REG3_OFFSET 12
+#define HB3_PERIOD_OFFSET 16
+#define HB3_PERIOD_AVG_OFFSET 20
+#define HB3_EDGE_COUNT_OFFSET 24
+#define HB3_QUAD_POSITION_OFFSET 28
+#define HB3_QUAD_SPEED_OFFSET 32
+#define HB3_QUAD_DIRECTION_OFFSET 36
+#define HB3_IRQ_ENABLE_OFFSET 8 // slave register 2
+#define HB3_IRQ_STATUS_OFFSET 40 // write 1 to clear
+#define HB3_RPM100_PERIOD_OFFSET 44 // RPM x 100 from the average period
+#define HB3_RPM100_WINDOW_OFFSET 48 // RPM x 100 from the 0.25s tick window
+#define HB3_PID_CTRL_OFFSET 52
+#define HB3_PID_SETPOINT_OFFSET 56 // RPM x 100
+#define HB3_PID_KP_OFFSET 60 // Q16.16
+#define HB3_PID_KI_OFFSET 64 // Q16.16
+#define HB3_PID_KD_OFFSET 68 // Q16.16
+#define HB3_PID_I_LIMIT_OFFSET 72 // Q16.16 rpm
+#define HB3_PID_OUT_LIMIT_OFFSET 76 // Q16.16 rpm
+#define HB3_PID_FF_OFFSET 80 // PWM count
+#define HB3_PID_SLOPE_OFFSET 84 // Q16.16 PWM counts per rpm
+#define HB3_PID_ERROR_OFFSET 88 // Q16.16 rpm, read only
+#define HB3_PID_INTEGRATOR_OFFSET 92 // Q16.16 rpm, read only
+#define HB3_PID_OUTPUT_OFFSET 96 // PWM count, read only
+#define HB3_PWM_CFG_OFFSET 100 // [15:0] prescale, [20:16] PWM_BITS, [23:21] NUM_CHANNELS, [24] PID_ACCEL read only
+#define HB3_CH_PWM_OFFSET 104 // channels 1-3 PWM control, same layout as HB3_PWM_OFFSET
+#define HB3_LATCH_OFFSET 116 // write to latch every channel, read for the fresh bits
+#define HB3_SNAP_RPM100_PERIOD_OFFSET 128 // latched RPM x 100 from the period, one word per channel
+#define HB3_SNAP_RPM100_WINDOW_OFFSET 144 // latched RPM x 100 from the tick window
+#define HB3_SNAP_EDGE_COUNT_OFFSET 160 // latched tachA edge counts
+
+// new sample interrupt sources, bits of the enable and status registers
+#define HB3_IRQ_WINDOW 0x1 // 0.25s tick window closed
+#define HB3_IRQ_PERIOD 0x2 // new tachA period captured (or motor stalled)
+
+// rpm_calc.v converts both measurements to RPM x 100 in fabric, so reading
+// a speed is one AXI read. TICKS_PER_REV_X100 in the IP has to match the
+// motor, 82313 is 11 ticks * 74.83 gear ratio
+#define HB3_RPM100_SCALE 100
+// RPM x 100 to RPM. Exact below 43700 (437 RPM), far past the motor's top
+// speed
+#define HB3_DIV100_RECIP_Q19 5243 // 2^19 / 100
+#define HB3_DIV100_SHIFT 19
+
+// pmodhb3 duty cycle and carrier. The duty cycle field is left aligned
+// under the enable bit, [29:14] for 16 bits, and the IP keeps the top
+// PWM_BITS (8 to 16, an IP parameter). HB3_setPWM() writes a 10 bit count
+// into [29:20] so it means the same duty cycle at any resolution. The
+// carrier is HB3_AXI_CLK_FREQ_HZ / ((prescale + 1) * 2^PWM_BITS)
+#define HB3_AXI_CLK_FREQ_HZ 100000000
+#define HB3_PWM_ENABLE 0x80000000
+#define HB3_PWM_DUTY_SHIFT 14 // 16 bit duty cycle field
+#define HB3_PWM_COUNT_SHIFT 6 // 10 bit count to the 16 bit field
+#define HB3_PWM_PRESCALE_MASK 0xFFFF
+#define HB3_PWM_BITS_SHIFT 16
+#define HB3_PWM_BITS_MASK 0x1F
+
+// NUM_CHANNELS (an IP parameter, 1 to 4) motors on one myHB3ip. Channel 0
+// is the full channel above; 1-3 have their own PWM and tach capture but
+// are only read through the snapshot: writing the latch register copies
+// every channel's speeds in the same clock, then the CPU reads them back
+// to back from consecutive words. The latch register reads back which
+// channels had a new sample between the last two latches
+#define HB3_MAX_CHANNELS 4
+#define HB3_NUM_CH_SHIFT 21
+#define HB3_NUM_CH_MASK 0x7
+#define HB3_LATCH_FRESH_MASK 0xF
+#define HB3_LATCH_FRESH_PERIOD_SHIFT 0 // [3:0] period RPM updated
+#define HB3_LATCH_FRESH_WINDOW_SHIFT 4 // [7:4] window RPM updated
+#define HB3_LATCH_SEQ_SHIFT 16 // [31:16] latches taken
+
+// fabric PID (pid_accel.v), bits of the PID control register. With
+// HB3_PID_FABRIC set the IP steps the PID on every new RPM x 100 and sets
+// the PWM duty cycle itself; HB3_setPWM() then only sets the enable bit.
+// Clearing it zeroes the integrator and derivative history
+#define HB3_PID_FABRIC 0x1
+#define HB3_PID_SRC_PERIOD 0x2 // step on the period RPM, else the 0.25s window
+// PWM config register bit set when the IP was built with PID_ACCEL = 1.
+// It defaults to 0, so the fabric PID is only there for HB3_FABRIC_PID
+#define HB3_CFG_PID_ACCEL 0x01000000
+// the channel pid_accel.v drives, the others only have the PWM and tach
+#define HB3_PID_CHANNEL 0
+
+// ticks/second to RPM in software is ticks * 60 / 823.13. There is no FPU
+// or divider on the MicroBlaze so this is done as a multiply by the
+// reciprocal and a shift. Q20 matches the float result exactly up to ~3400
+// ticks/second (~250 RPM). The driver reads the fabric RPM instead, this
+// is kept for the pid_fixed benchmark
+#define HB3_RPM_RECIP_Q20 76433 // (60 / 823.13) * 2^20
+#define HB3_RPM_SHIFT 20
+
+// the quadrature decoder counts all 4 edges of tachA/tachB, so one output
+// shaft revolution is 4 * 823.13 counts. counts/second to RPM is
+// counts * 60 / 3292.52
+#define HB3_QUAD_RPM_RECIP_Q20 19108 // (60 / 3292.52) * 2^20
 
 
 /**************************** Type Definitions *****************************/
+// one per myHB3ip (one per motor), every HB3_ call takes the instance so
+// several motors run from the same driver. Zero it before HB3_initialize()
+typedef struct hb3 {
+    uint32_t baseAddress;
+    bool isInitialized;
+    uint32_t irqSources;
+    volatile uint32_t cachedRPM;        // converted by HB3_SampleHandler()
+    volatile uint32_t cachedRPM100;
+    volatile uint32_t sampleSeq;        // new samples, counted by HB3_SampleHandler()
+    uint32_t seenSeq;                   // sampleSeq at the last HB3_isNewSample()
+    uint32_t numChannels;               // NUM_CHANNELS the IP was built with
+    bool fabricPID;                     // built with PID_ACCEL, see HB3_hasFabricPID()
+    uint32_t chRPM[HB3_MAX_CHANNELS];   // converted by HB3_latchChannels()
+} hb3_t, *ptr_hb3_t;
+
 /**
  *
  * Write a value to a MYHB3IP register. A 32 bit write is performed.
@@ -80,9 +188,40 @@ XStatus MYHB3IP_Reg_SelfTest(void * baseaddr_p);
 
 
 // API function prototypes
-XStatus HB3_initialize(uint32_t baseaddr_p);
-void HB3_setPWM(bool enable, u16 DC);
-uint32_t HB3_getTicks(void);
-uint32_t HB3_getRPM(void);
+XStatus HB3_initialize(ptr_hb3_t hb3, uint32_t baseaddr_p);
+void HB3_setPWM(ptr_hb3_t hb3, bool enable, u16 DC);
+void HB3_setPWMDuty(ptr_hb3_t hb3, bool enable, u16 duty);
+uint32_t HB3_getPWMBits(ptr_hb3_t hb3);
+uint32_t HB3_setPWMCarrier(ptr_hb3_t hb3, uint32_t hz);
+uint32_t HB3_getPWMCarrier(ptr_hb3_t hb3);
+uint32_t HB3_getTicks(ptr_hb3_t hb3);
+uint32_t HB3_getRPM(ptr_hb3_t hb3);
+uint32_t HB3_getPeriod(ptr_hb3_t hb3);
+uint32_t HB3_getPeriodAvg(ptr_hb3_t hb3);
+uint32_t HB3_getEdgeCount(ptr_hb3_t hb3);
+uint32_t HB3_getRPMFast(ptr_hb3_t hb3);
+uint32_t HB3_getRPM100(ptr_hb3_t hb3);
+uint32_t HB3_getRPM100Fast(ptr_hb3_t hb3);
+int32_t HB3_getPosition(ptr_hb3_t hb3);
+int32_t HB3_getQuadSpeed(ptr_hb3_t hb3);
+int32_t HB3_getQuadRPM(ptr_hb3_t hb3);
+bool HB3_isReversed(ptr_hb3_t hb3);
+void HB3_enableSampleInterrupt(ptr_hb3_t hb3, uint32_t sources);
+void HB3_SampleHandler(void *CallBackRef);
+bool HB3_isNewSample(ptr_hb3_t hb3);
+uint32_t HB3_getCachedRPM(ptr_hb3_t hb3);
+uint32_t HB3_getCachedRPM100(ptr_hb3_t hb3);
+void HB3_setPIDMode(ptr_hb3_t hb3, uint32_t ctrl);
+void HB3_setPIDGains(ptr_hb3_t hb3, int32_t kp, int32_t ki, int32_t kd);
+void HB3_setPIDLimits(ptr_hb3_t hb3, int32_t i_limit, int32_t out_limit);
+void HB3_setPIDSetpoint(ptr_hb3_t hb3, uint32_t rpm100, uint32_t feedforward, int32_t slope);
+int32_t HB3_getPIDError(ptr_hb3_t hb3);
+int32_t HB3_getPIDIntegrator(ptr_hb3_t hb3);
+uint32_t HB3_getPIDOutput(ptr_hb3_t hb3);
+bool HB3_hasFabricPID(ptr_hb3_t hb3);
+uint32_t HB3_getChannels(ptr_hb3_t hb3);
+void HB3_setChannelPWM(ptr_hb3_t hb3, uint32_t ch, bool enable, u16 DC);
+uint32_t HB3_latchChannels(ptr_hb3_t hb3);
+uint32_t HB3_getChannelRPM(ptr_hb3_t hb3, uint32_t ch);
 
 #endif // MYHB3IP_H
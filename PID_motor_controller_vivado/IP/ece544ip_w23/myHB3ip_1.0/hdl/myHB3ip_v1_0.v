@@ -4,16 +4,19 @@
 	module myHB3ip_v1_0 #
 	(
 		// Users to add parameters here
-	       parameter DIVIDE_COUNT = 49,	    // Clock divider terminal count
+	       parameter PWM_PRESCALE = 99,	    // clocks per PWM count - 1 out of reset, ~1 kHz carrier at 10 bits
 	       parameter POLARITY = 1'b1,		// 1 to drive PWM output high when active.  0 to invert the PWM output
-	       parameter MAX_COUNT = 1024,		// maximum count for the PWM counters
+	       parameter PWM_BITS = 10,		// PWM duty cycle resolution, 8 to 16 bits
+	       parameter TICKS_PER_REV_X100 = 82313,	// tachA edges per output shaft rev x 100
+	       parameter PID_ACCEL = 0,		// 1 builds in the fabric PID (pid_accel.v), for HB3_FABRIC_PID
+	       parameter NUM_CHANNELS = 1,		// motors on this slave, 1 to 4
 		// User parameters ends
 		// Do not modify the parameters beyond this line
 
 
 		// Parameters of Axi Slave Bus Interface S00_AXI
 		parameter integer C_S00_AXI_DATA_WIDTH	= 32,
-		parameter integer C_S00_AXI_ADDR_WIDTH	= 4
+		parameter integer C_S00_AXI_ADDR_WIDTH	= 8
 	)
 	(
 		// Users to add ports here
@@ -21,6 +24,11 @@
         input wire tachB,
         output wire direction,
         output wire enable,
+        output wire sample_irq,
+        input wire [2:0] ch_tachA,
+        input wire [2:0] ch_tachB,
+        output wire [2:0] ch_direction,
+        output wire [2:0] ch_enable,
 		// User ports ends
 		// Do not modify the ports beyond this line
 
@@ -50,6 +58,12 @@
 	);
 // Instantiation of Axi Bus Interface S00_AXI
 	myHB3ip_v1_0_S00_AXI # ( 
+		.PWM_PRESCALE(PWM_PRESCALE),
+		.POLARITY(POLARITY),
+		.PWM_BITS(PWM_BITS),
+		.TICKS_PER_REV_X100(TICKS_PER_REV_X100),
+		.PID_ACCEL(PID_ACCEL),
+		.NUM_CHANNELS(NUM_CHANNELS),
 		.C_S_AXI_DATA_WIDTH(C_S00_AXI_DATA_WIDTH),
 		.C_S_AXI_ADDR_WIDTH(C_S00_AXI_ADDR_WIDTH)
 	) myHB3ip_v1_0_S00_AXI_inst (
@@ -57,6 +71,11 @@
 		.tachB(tachB),
 		.direction(direction),
 		.enable(enable),
+		.sample_irq(sample_irq),
+		.ch_tachA(ch_tachA),
+		.ch_tachB(ch_tachB),
+		.ch_direction(ch_direction),
+		.ch_enable(ch_enable),
 		
 		.S_AXI_ACLK(s00_axi_aclk),
 		.S_AXI_ARESETN(s00_axi_aresetn),
@@ -4,16 +4,19 @@
 	module myHB3ip_v1_0_S00_AXI #
 	(
 		// Users to add parameters here
-        parameter DIVIDE_COUNT = 49,	// Clock divider terminal count
+        parameter PWM_PRESCALE = 99,	// clocks per PWM count - 1 out of reset, the carrier register after
         parameter POLARITY = 1'b1,		// 1 to drive PWM output high when active.  0 to invert the PWM output
-        parameter MAX_COUNT = 1024,		// maximum count for the PWM counters
+        parameter PWM_BITS = 10,		// PWM duty cycle resolution, 8 to 16 bits
+        parameter TICKS_PER_REV_X100 = 82313,	// tachA edges per output shaft rev x 100
+        parameter PID_ACCEL = 0,		// 1 builds in the fabric PID (pid_accel.v), for HB3_FABRIC_PID
+        parameter NUM_CHANNELS = 1,		// motors on this slave, 1 to 4. Channels 1-3 are hb3_channel.v
 		// User parameters ends
 		// Do not modify the parameters beyond this line
 
 		// Width of S_AXI data bus
 		parameter integer C_S_AXI_DATA_WIDTH	= 32,
 		// Width of S_AXI address bus
-		parameter integer C_S_AXI_ADDR_WIDTH	= 4
+		parameter integer C_S_AXI_ADDR_WIDTH	= 8
 	)
 	(
 		// Users to add ports here
@@ -21,6 +24,11 @@
         input wire tachB,
         output wire direction,
         output wire enable,
+        output wire sample_irq,     // level high while an enabled new sample is pending
+        input wire [2:0] ch_tachA,  // channels 1-3, bit 0 is channel 1
+        input wire [2:0] ch_tachB,
+        output wire [2:0] ch_direction,
+        output wire [2:0] ch_enable,
         
 		// User ports ends
 		// Do not modify the ports beyond this line
@@ -105,11 +113,11 @@
 	// ADDR_LSB = 2 for 32 bits (n downto 2)
 	// ADDR_LSB = 3 for 64 bits (n downto 3)
 	localparam integer ADDR_LSB = (C_S_AXI_DATA_WIDTH/32) + 1;
-	localparam integer OPT_MEM_ADDR_BITS = 1;
+	localparam integer OPT_MEM_ADDR_BITS = 5;
 	//----------------------------------------------
 	//-- Signals for user logic register space example
 	//------------------------------------------------
-	//-- Number of Slave Registers 4
+	//-- Number of Slave Registers 64 (0-3, 13-21 and 25-28 read/write, the rest status from user logic)
 	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg0;
 	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg1;
 	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg2;
@@ -120,6 +128,55 @@
 	integer	 byte_index;
 	reg	 aw_en;
 	wire [31:0] ticker_out;
+	wire [31:0] period_out;		// clocks between the last two tachA edges
+	wire [31:0] period_avg_out;	// running average of period_out
+	wire [31:0] edge_count_out;	// tachA rising edge count
+	wire [31:0] quad_position;	// signed x4 quadrature position
+	wire [31:0] quad_speed;		// signed counts/second
+	wire quad_direction;		// 1 if the motor is turning backwards
+	wire tick_stb;				// tick window closed
+	wire period_stb;			// new period captured
+	wire [31:0] rpm100_window;	// RPM x 100 from ticker_out
+	wire [31:0] rpm100_period;	// RPM x 100 from period_avg_out
+	wire window_stb;			// rpm100_window updated
+	wire period_rpm_stb;		// rpm100_period updated
+	// fabric PID configuration, see pid_accel.v
+	reg [1:0] pid_ctrl;			// [1]=step on the period RPM, not the window [0]=fabric drives the PWM
+	reg [31:0] pid_setpoint;	// RPM x 100
+	reg [31:0] pid_kp;			// Q16.16 gains
+	reg [31:0] pid_ki;
+	reg [31:0] pid_kd;
+	reg [31:0] pid_i_limit;		// Q16.16 rpm
+	reg [31:0] pid_out_limit;	// Q16.16 rpm
+	reg [31:0] pid_ff;			// PWM count at the setpoint
+	reg [31:0] pid_slope;		// Q16.16 PWM counts per rpm
+	wire [31:0] pid_error;
+	wire [31:0] pid_integrator;
+	wire [9:0] pid_duty;
+	wire [31:0] hb3_control;	// PWM control register to pmodhb3
+	reg [15:0] pwm_prescale;	// clocks per PWM count - 1, sets the carrier
+	localparam [4:0] PWM_BITS_FIELD = PWM_BITS;
+	reg [1:0] irq_status;		// pending new sample interrupts [1]=period [0]=window
+	localparam [2:0] NUM_CHANNELS_FIELD = NUM_CHANNELS;
+	localparam [0:0] PID_ACCEL_FIELD = (PID_ACCEL != 0);
+	// channels 1-3 and the latched snapshot of all of them
+	reg [31:0] ch_pwm1, ch_pwm2, ch_pwm3;	// same layout as slv_reg0
+	wire [31:0] ch_control [1:3];
+	wire [31:0] ch_edge_count [0:3];
+	wire [31:0] ch_rpm100_window [0:3];
+	wire [31:0] ch_rpm100_period [0:3];
+	wire [3:0] ch_window_stb;
+	wire [3:0] ch_period_rpm_stb;
+	reg [31:0] snap_rpm100_period [0:3];
+	reg [31:0] snap_rpm100_window [0:3];
+	reg [31:0] snap_edge_count [0:3];
+	reg [3:0] fresh_period;		// period strobes since the last latch
+	reg [3:0] fresh_window;		// window strobes since the last latch
+	reg [3:0] snap_fresh_period;	// fresh_period as of the last latch
+	reg [3:0] snap_fresh_window;
+	reg [15:0] latch_seq;		// latches taken, wraps
+	wire latch_stb;
+	integer ch_index;
 	// I/O Connections assignments
 
 	assign S_AXI_AWREADY	= axi_awready;
@@ -230,39 +287,66 @@
 	      slv_reg1 <= 0;
 	      slv_reg2 <= 0;
 	      slv_reg3 <= 0;
+	      pid_ctrl <= 0;
+	      pid_setpoint <= 0;
+	      pid_kp <= 0;
+	      pid_ki <= 0;
+	      pid_kd <= 0;
+	      pid_i_limit <= 0;
+	      pid_out_limit <= 0;
+	      pid_ff <= 0;
+	      pid_slope <= 0;
+	      pwm_prescale <= PWM_PRESCALE;
+	      ch_pwm1 <= 0;
+	      ch_pwm2 <= 0;
+	      ch_pwm3 <= 0;
 	    end 
 	  else begin
 	    if (slv_reg_wren)
 	      begin
 	        case ( axi_awaddr[ADDR_LSB+OPT_MEM_ADDR_BITS:ADDR_LSB] )
-	          2'h0:
+	          6'h00:
 	            for ( byte_index = 0; byte_index <= (C_S_AXI_DATA_WIDTH/8)-1; byte_index = byte_index+1 )
 	              if ( S_AXI_WSTRB[byte_index] == 1 ) begin
 	                // Respective byte enables are asserted as per write strobes 
 	                // Slave register 0
 	                slv_reg0[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
 	              end  
-	          2'h1:
+	          6'h01:
 	            for ( byte_index = 0; byte_index <= (C_S_AXI_DATA_WIDTH/8)-1; byte_index = byte_index+1 )
 	              if ( S_AXI_WSTRB[byte_index] == 1 ) begin
 	                // Respective byte enables are asserted as per write strobes 
 	                // Slave register 1
 	                slv_reg1[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
 	              end  
-	          2'h2:
+	          6'h02:
 	            for ( byte_index = 0; byte_index <= (C_S_AXI_DATA_WIDTH/8)-1; byte_index = byte_index+1 )
 	              if ( S_AXI_WSTRB[byte_index] == 1 ) begin
 	                // Respective byte enables are asserted as per write strobes 
 	                // Slave register 2
 	                slv_reg2[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
 	              end  
-	          2'h3:
+	          6'h03:
 	            for ( byte_index = 0; byte_index <= (C_S_AXI_DATA_WIDTH/8)-1; byte_index = byte_index+1 )
 	              if ( S_AXI_WSTRB[byte_index] == 1 ) begin
 	                // Respective byte enables are asserted as per write strobes 
 	                // Slave register 3
 	                slv_reg3[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
 	              end  
+	          // the PID registers are only written as whole words
+	          6'h0D: pid_ctrl <= S_AXI_WDATA[1:0];
+	          6'h0E: pid_setpoint <= S_AXI_WDATA;
+	          6'h0F: pid_kp <= S_AXI_WDATA;
+	          6'h10: pid_ki <= S_AXI_WDATA;
+	          6'h11: pid_kd <= S_AXI_WDATA;
+	          6'h12: pid_i_limit <= S_AXI_WDATA;
+	          6'h13: pid_out_limit <= S_AXI_WDATA;
+	          6'h14: pid_ff <= S_AXI_WDATA;
+	          6'h15: pid_slope <= S_AXI_WDATA;
+	          6'h19: pwm_prescale <= S_AXI_WDATA[15:0];
+	          6'h1A: ch_pwm1 <= S_AXI_WDATA;
+	          6'h1B: ch_pwm2 <= S_AXI_WDATA;
+	          6'h1C: ch_pwm3 <= S_AXI_WDATA;
 	          default : begin
 	                      slv_reg0 <= slv_reg0;
 	                      slv_reg1 <= slv_reg1;
@@ -376,10 +460,48 @@
 	begin
 	      // Address decoding for reading registers
 	      case ( axi_araddr[ADDR_LSB+OPT_MEM_ADDR_BITS:ADDR_LSB] )
-	        2'h0   : reg_data_out <= slv_reg0;
-	        2'h1   : reg_data_out <= ticker_out;
-	        2'h2   : reg_data_out <= slv_reg2;
-	        2'h3   : reg_data_out <= slv_reg3;
+	        6'h00  : reg_data_out <= slv_reg0;
+	        6'h01  : reg_data_out <= ticker_out;
+	        6'h02  : reg_data_out <= slv_reg2;
+	        6'h03  : reg_data_out <= slv_reg3;
+	        6'h04  : reg_data_out <= period_out;
+	        6'h05  : reg_data_out <= period_avg_out;
+	        6'h06  : reg_data_out <= edge_count_out;
+	        6'h07  : reg_data_out <= quad_position;
+	        6'h08  : reg_data_out <= quad_speed;
+	        6'h09  : reg_data_out <= {31'd0, quad_direction};
+	        6'h0A  : reg_data_out <= {30'd0, irq_status};
+	        6'h0B  : reg_data_out <= rpm100_period;
+	        6'h0C  : reg_data_out <= rpm100_window;
+	        6'h0D  : reg_data_out <= {30'd0, pid_ctrl};
+	        6'h0E  : reg_data_out <= pid_setpoint;
+	        6'h0F  : reg_data_out <= pid_kp;
+	        6'h10  : reg_data_out <= pid_ki;
+	        6'h11  : reg_data_out <= pid_kd;
+	        6'h12  : reg_data_out <= pid_i_limit;
+	        6'h13  : reg_data_out <= pid_out_limit;
+	        6'h14  : reg_data_out <= pid_ff;
+	        6'h15  : reg_data_out <= pid_slope;
+	        6'h16  : reg_data_out <= pid_error;
+	        6'h17  : reg_data_out <= pid_integrator;
+	        6'h18  : reg_data_out <= {22'd0, pid_duty};
+	        6'h19  : reg_data_out <= {7'd0, PID_ACCEL_FIELD, NUM_CHANNELS_FIELD, PWM_BITS_FIELD, pwm_prescale};
+	        6'h1A  : reg_data_out <= ch_pwm1;
+	        6'h1B  : reg_data_out <= ch_pwm2;
+	        6'h1C  : reg_data_out <= ch_pwm3;
+	        6'h1D  : reg_data_out <= {latch_seq, 8'd0, snap_fresh_window, snap_fresh_period};
+	        6'h20  : reg_data_out <= snap_rpm100_period[0];
+	        6'h21  : reg_data_out <= snap_rpm100_period[1];
+	        6'h22  : reg_data_out <= snap_rpm100_period[2];
+	        6'h23  : reg_data_out <= snap_rpm100_period[3];
+	        6'h24  : reg_data_out <= snap_rpm100_window[0];
+	        6'h25  : reg_data_out <= snap_rpm100_window[1];
+	        6'h26  : reg_data_out <= snap_rpm100_window[2];
+	        6'h27  : reg_data_out <= snap_rpm100_window[3];
+	        6'h28  : reg_data_out <= snap_edge_count[0];
+	        6'h29  : reg_data_out <= snap_edge_count[1];
+	        6'h2A  : reg_data_out <= snap_edge_count[2];
+	        6'h2B  : reg_data_out <= snap_edge_count[3];
 	        default : reg_data_out <= 0;
 	      endcase
 	end
@@ -415,12 +537,16 @@
    end
     //wire reset;
     //assign reset = ~S_AXI_ARESETN;
-    pmodhb3 HB3(
+    pmodhb3 #(
+        .PWM_BITS(PWM_BITS),
+        .POLARITY(POLARITY)
+    ) HB3(
         .clk(S_AXI_ACLK),
         .reset(S_AXI_ARESETN),
         .tachA(tachA_clean),
         .tachB(tachB_clean),
-        .controlReg(slv_reg0),
+        .controlReg(hb3_control),
+        .prescale(pwm_prescale),
         .direction(direction),
         .enable(enable)
     );
@@ -428,8 +554,171 @@
         .clk(S_AXI_ACLK),
         .reset(S_AXI_ARESETN),
         .tachA(tachA_clean),
-        .tick_out(ticker_out)
+        .tick_out(ticker_out),
+        .period_out(period_out),
+        .period_avg_out(period_avg_out),
+        .edge_count_out(edge_count_out),
+        .tick_stb(tick_stb),
+        .period_stb(period_stb)
     );
+
+    // new sample interrupt. slv_reg2[1:0] enables the period and window
+    // sources, writing a 1 to a bit of the status register (0x28) clears it.
+    // A new sample in the same clock as the clear wins
+    always @(posedge S_AXI_ACLK) begin
+        if (S_AXI_ARESETN == 1'b0) begin
+            irq_status <= 2'b00;
+        end
+        else begin
+            if (slv_reg_wren && axi_awaddr[ADDR_LSB+OPT_MEM_ADDR_BITS:ADDR_LSB] == 6'h0A)
+                irq_status <= (irq_status & ~S_AXI_WDATA[1:0]) | {period_rpm_stb, window_stb};
+            else
+                irq_status <= irq_status | {period_rpm_stb, window_stb};
+        end
+    end
+    assign sample_irq = |(irq_status & slv_reg2[1:0]);
+    // the sample interrupt waits for the RPM conversion so the handler
+    // reads a finished value
+    rpm_calc #(
+        .TICKS_PER_REV_X100(TICKS_PER_REV_X100)
+    ) rpm(
+        .clk(S_AXI_ACLK),
+        .reset(S_AXI_ARESETN),
+        .tick_out(ticker_out),
+        .tick_stb(tick_stb),
+        .period_avg(period_avg_out),
+        .period_stb(period_stb),
+        .rpm100_window(rpm100_window),
+        .window_stb(window_stb),
+        .rpm100_period(rpm100_period),
+        .period_rpm_stb(period_rpm_stb)
+    );
+    // in fabric mode the PID sets the duty cycle, the CPU still owns the
+    // enable bit. The PID works in 10 bit counts, left aligned like the
+    // CPU's so it means the same duty cycle at any PWM_BITS
+    generate
+        if (PID_ACCEL) begin : fabric_pid
+            pid_accel pid(
+                .clk(S_AXI_ACLK),
+                .reset(S_AXI_ARESETN),
+                .enable(pid_ctrl[0]),
+                .setpoint(pid_setpoint),
+                .rpm100(pid_ctrl[1] ? rpm100_period : rpm100_window),
+                .rpm_stb(pid_ctrl[1] ? period_rpm_stb : window_stb),
+                .kp(pid_kp),
+                .ki(pid_ki),
+                .kd(pid_kd),
+                .i_limit(pid_i_limit),
+                .out_limit(pid_out_limit),
+                .feedforward(pid_ff),
+                .slope(pid_slope),
+                .error(pid_error),
+                .integrator(pid_integrator),
+                .correction(),
+                .duty(pid_duty),
+                .step_stb()
+            );
+            assign hb3_control = pid_ctrl[0] ? {slv_reg0[31:30], pid_duty, 20'd0} : slv_reg0;
+        end
+        else begin : no_fabric_pid
+            assign pid_error = 32'd0;
+            assign pid_integrator = 32'd0;
+            assign pid_duty = 10'd0;
+            assign hb3_control = slv_reg0;
+        end
+    endgenerate
+    quadrature quad(
+        .clk(S_AXI_ACLK),
+        .reset(S_AXI_ARESETN),
+        .tachA(tachA_clean),
+        .tachB(tachB_clean),
+        .position_out(quad_position),
+        .speed_out(quad_speed),
+        .direction_out(quad_direction)
+    );
+
+    // channels 1 to NUM_CHANNELS-1 each get their own PWM and tach capture,
+    // the ones not built drive their outputs inactive and read 0
+    assign ch_control[1] = ch_pwm1;
+    assign ch_control[2] = ch_pwm2;
+    assign ch_control[3] = ch_pwm3;
+    assign ch_edge_count[0] = edge_count_out;
+    assign ch_rpm100_window[0] = rpm100_window;
+    assign ch_rpm100_period[0] = rpm100_period;
+    assign ch_window_stb[0] = window_stb;
+    assign ch_period_rpm_stb[0] = period_rpm_stb;
+    genvar ch;
+    generate
+        for (ch = 1; ch < 4; ch = ch + 1) begin : channel
+            if (ch < NUM_CHANNELS) begin : used
+                hb3_channel #(
+                    .PWM_BITS(PWM_BITS),
+                    .POLARITY(POLARITY),
+                    .TICKS_PER_REV_X100(TICKS_PER_REV_X100)
+                ) chan(
+                    .clk(S_AXI_ACLK),
+                    .reset(S_AXI_ARESETN),
+                    .tachA(ch_tachA[ch-1]),
+                    .tachB(ch_tachB[ch-1]),
+                    .controlReg(ch_control[ch]),
+                    .prescale(pwm_prescale),
+                    .enable(ch_enable[ch-1]),
+                    .direction(ch_direction[ch-1]),
+                    .edge_count(ch_edge_count[ch]),
+                    .rpm100_window(ch_rpm100_window[ch]),
+                    .window_stb(ch_window_stb[ch]),
+                    .rpm100_period(ch_rpm100_period[ch]),
+                    .period_rpm_stb(ch_period_rpm_stb[ch])
+                );
+            end
+            else begin : unused
+                assign ch_enable[ch-1] = ~POLARITY;
+                assign ch_direction[ch-1] = 1'b0;
+                assign ch_edge_count[ch] = 32'd0;
+                assign ch_rpm100_window[ch] = 32'd0;
+                assign ch_rpm100_period[ch] = 32'd0;
+                assign ch_window_stb[ch] = 1'b0;
+                assign ch_period_rpm_stb[ch] = 1'b0;
+            end
+        end
+    endgenerate
+
+    // writing the latch register (0x74) copies every channel's speeds and
+    // edge count into the snapshot registers in the same clock, so one
+    // latch and back to back reads of consecutive words give a coherent
+    // set. The fresh bits say which channels had a new sample since the
+    // previous latch; one in the latch clock counts for this latch.
+    assign latch_stb = slv_reg_wren && axi_awaddr[ADDR_LSB+OPT_MEM_ADDR_BITS:ADDR_LSB] == 6'h1D;
+    always @(posedge S_AXI_ACLK) begin
+        if (S_AXI_ARESETN == 1'b0) begin
+            fresh_period <= 4'd0;
+            fresh_window <= 4'd0;
+            snap_fresh_period <= 4'd0;
+            snap_fresh_window <= 4'd0;
+            latch_seq <= 16'd0;
+            for (ch_index = 0; ch_index < 4; ch_index = ch_index + 1) begin
+                snap_rpm100_period[ch_index] <= 32'd0;
+                snap_rpm100_window[ch_index] <= 32'd0;
+                snap_edge_count[ch_index] <= 32'd0;
+            end
+        end
+        else if (latch_stb) begin
+            for (ch_index = 0; ch_index < 4; ch_index = ch_index + 1) begin
+                snap_rpm100_period[ch_index] <= ch_rpm100_period[ch_index];
+                snap_rpm100_window[ch_index] <= ch_rpm100_window[ch_index];
+                snap_edge_count[ch_index] <= ch_edge_count[ch_index];
+            end
+            snap_fresh_period <= fresh_period | ch_period_rpm_stb;
+            snap_fresh_window <= fresh_window | ch_window_stb;
+            fresh_period <= 4'd0;
+            fresh_window <= 4'd0;
+            latch_seq <= latch_seq + 16'd1;
+        end
+        else begin
+            fresh_period <= fresh_period | ch_period_rpm_stb;
+            fresh_window <= fresh_window | ch_window_stb;
+        end
+    end
     
    // always @* begin
  //       slv_reg1 = ticker_output;
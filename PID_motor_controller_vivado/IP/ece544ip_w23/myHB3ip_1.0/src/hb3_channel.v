@@ -0,0 +1,94 @@
+`timescale 1ns / 1ps
+//////////////////////////////////////////////////////////////////////////////////
+// Company: PSU ECE 544 Winter 2023
+// Engineer: Stephen, Drew, Noah
+//
+// Create Date: 10/17/2026
+// Module Name: hb3_channel
+
+// Revision 0.01 - File Created
+// Additional Comments: one extra motor channel for myHB3ip when it is built
+// with NUM_CHANNELS > 1. The same tach synchronizer, PWM, tick/period
+// capture and RPM conversion as channel 0, without the quadrature decoder,
+// the fabric PID or the sample interrupt. Its speeds are only read through
+// the latched snapshot registers, so the CPU gets every channel from one
+// latch and back to back reads instead of one status sequence per motor.
+// The PWM prescale (carrier) is shared with channel 0.
+//////////////////////////////////////////////////////////////////////////////////
+
+
+module hb3_channel
+#(
+    parameter PWM_BITS = 10,                // duty cycle resolution, 8 to 16 bits
+    parameter POLARITY = 1'b1,              // 1 to drive PWM output high when active
+    parameter TICKS_PER_REV_X100 = 82313    // tachA edges per output rev x 100
+)
+(
+    input wire clk,
+    input wire reset,
+    input wire tachA,
+    input wire tachB,
+    input wire [31:0] controlReg,           // same layout as slv_reg0
+    input wire [15:0] prescale,             // clocks per PWM count - 1
+    output wire enable,
+    output wire direction,
+    output wire [31:0] edge_count,          // free running count of tachA rising edges
+    output wire [31:0] rpm100_window,       // RPM x 100 over the 0.25s window
+    output wire window_stb,                 // 1 clock when rpm100_window is updated
+    output wire [31:0] rpm100_period,       // RPM x 100 from the averaged period
+    output wire period_rpm_stb              // 1 clock when rpm100_period is updated
+);
+    // synchronize the tach to clock
+    reg tachA_delay, tachA_clean, tachB_delay, tachB_clean;
+    always @(posedge clk) begin
+        tachA_delay <= tachA;
+        tachA_clean <= tachA_delay;
+        tachB_delay <= tachB;
+        tachB_clean <= tachB_delay;
+    end
+
+    wire [31:0] tick_out;
+    wire [31:0] period_avg;
+    wire tick_stb;
+    wire period_stb;
+
+    pmodhb3 #(
+        .PWM_BITS(PWM_BITS),
+        .POLARITY(POLARITY)
+    ) HB3(
+        .clk(clk),
+        .reset(reset),
+        .tachA(tachA_clean),
+        .tachB(tachB_clean),
+        .controlReg(controlReg),
+        .prescale(prescale),
+        .direction(direction),
+        .enable(enable)
+    );
+    ticks ticker(
+        .clk(clk),
+        .reset(reset),
+        .tachA(tachA_clean),
+        .tick_out(tick_out),
+        .period_out(),
+        .period_avg_out(period_avg),
+        .edge_count_out(edge_count),
+        .tick_stb(tick_stb),
+        .period_stb(period_stb)
+    );
+    rpm_calc #(
+        .TICKS_PER_REV_X100(TICKS_PER_REV_X100)
+    ) rpm(
+        .clk(clk),
+        .reset(reset),
+        .tick_out(tick_out),
+        .tick_stb(tick_stb),
+        .period_avg(period_avg),
+        .period_stb(period_stb),
+        .rpm100_window(rpm100_window),
+        .window_stb(window_stb),
+        .rpm100_period(rpm100_period),
+        .period_rpm_stb(period_rpm_stb)
+    );
+
+endmodule
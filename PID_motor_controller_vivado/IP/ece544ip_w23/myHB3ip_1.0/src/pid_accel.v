@@ -0,0 +1,184 @@
+`timescale 1ns / 1ps
+//////////////////////////////////////////////////////////////////////////////////
+// Company: PSU ECE 544 Winter 2023
+// Engineer: Stephen, Drew, Noah
+//
+// Create Date: 10/17/2026
+// Module Name: pid_accel
+
+// Revision 0.01 - File Created
+// Additional Comments: the firmware's Q16.16 PID (src/pid_fixed.c) in fabric,
+// stepped by every new RPM x 100 from rpm_calc so the CPU is not in the loop.
+//
+// error      = (setpoint - rpm100) / 100 as Q16.16 rpm
+// integrator = clamp(integrator + ki * error, +/- i_limit)
+// correction = clamp(kp * error + integrator + kd * (error - prev error), +/- out_limit)
+// duty       = clamp(feedforward + correction * slope, 0, MAX_DUTY)
+//
+// The P/I/D terms are computed in the same order with the same saturating
+// adds and multiplies as pid_fixed_step(), so for the same error the
+// integrator and correction match the C bit for bit. slope is the PWM
+// counts per rpm at the setpoint (Q16.16) and feedforward the count for
+// the setpoint itself, both loaded by the firmware from rpm_lut.h. duty is
+// recomputed every clock, so a new feedforward takes effect at once rather
+// than on the next tach sample.
+//
+// A step takes 6 clocks from rpm_stb. While enable is low nothing steps
+// and the state is held at 0, so turning it on starts like
+// pid_fixed_reset().
+//////////////////////////////////////////////////////////////////////////////////
+
+
+module pid_accel
+#(
+    parameter MAX_DUTY = 1023               // 10 bit PWM count at 100% duty cycle
+)
+(
+    input wire clk,
+    input wire reset,
+    input wire enable,                      // 1 steps on rpm_stb, 0 clears the state
+    input wire [31:0] setpoint,             // RPM x 100
+    input wire [31:0] rpm100,               // measured RPM x 100
+    input wire rpm_stb,                     // rpm100 has a new value
+    input wire signed [31:0] kp,            // Q16.16 gains
+    input wire signed [31:0] ki,
+    input wire signed [31:0] kd,
+    input wire signed [31:0] i_limit,       // Q16.16 rpm, integrator held within +/-
+    input wire signed [31:0] out_limit,     // Q16.16 rpm, correction held within +/-
+    input wire [31:0] feedforward,          // PWM count at the setpoint
+    input wire signed [31:0] slope,         // Q16.16 PWM counts per rpm
+    output reg signed [31:0] error,         // Q16.16 rpm, last step
+    output reg signed [31:0] integrator,    // Q16.16 rpm
+    output reg signed [31:0] correction,    // Q16.16 rpm, last step
+    output reg [9:0] duty,                  // PWM count for pmodhb3
+    output reg step_stb                     // 1 clock when a step finishes
+);
+    localparam signed [31:0] Q16_MAX = 32'sh7FFFFFFF;
+    localparam signed [31:0] Q16_MIN = 32'sh80000000;
+    localparam signed [63:0] SAT_MAX = 64'sh000000007FFFFFFF;
+    localparam signed [63:0] SAT_MIN = 64'shFFFFFFFF80000000;
+    localparam signed [31:0] RECIP_100_Q24 = 32'sd167772;   // round(2^24 / 100)
+
+    // adds two Q16.16 values, saturating instead of wrapping
+    function signed [31:0] sat_add(input signed [31:0] a, input signed [31:0] b);
+        reg signed [32:0] sum;
+        begin
+            sum = {a[31], a} + {b[31], b};
+            sat_add = (sum[32] != sum[31]) ? (sum[32] ? Q16_MIN : Q16_MAX) : sum[31:0];
+        end
+    endfunction
+
+    // subtracts b from a, saturating instead of wrapping
+    function signed [31:0] sat_sub(input signed [31:0] a, input signed [31:0] b);
+        reg signed [32:0] diff;
+        begin
+            diff = {a[31], a} - {b[31], b};
+            sat_sub = (diff[32] != diff[31]) ? (diff[32] ? Q16_MIN : Q16_MAX) : diff[31:0];
+        end
+    endfunction
+
+    // a 64 bit product shifted right by shift, saturated to 32 bits
+    function signed [31:0] sat_shift(input signed [63:0] prod, input integer shift);
+        reg signed [63:0] shifted;
+        begin
+            shifted = prod >>> shift;
+            if(shifted > SAT_MAX)
+                sat_shift = Q16_MAX;
+            else if(shifted < SAT_MIN)
+                sat_shift = Q16_MIN;
+            else
+                sat_shift = shifted[31:0];
+        end
+    endfunction
+
+    // limits x to [lo, hi]
+    function signed [31:0] clamp(input signed [31:0] x, input signed [31:0] lo, input signed [31:0] hi);
+        begin
+            clamp = (x < lo) ? lo : ((x > hi) ? hi : x);
+        end
+    endfunction
+
+    reg [5:0] stage;                        // rpm_stb delayed, bit n runs stage n + 2
+    reg signed [63:0] diff100;              // setpoint - rpm100
+    reg signed [31:0] prev_error;
+    reg signed [31:0] d_error;
+    reg signed [63:0] p_prod, i_prod, d_prod;
+    reg signed [31:0] p_term, i_term, d_term;
+    reg signed [31:0] pi_sum;
+    reg signed [63:0] duty_prod;
+    reg signed [31:0] duty_sum;
+
+    // integrator update, used in stage 5
+    wire signed [31:0] integrator_next = clamp(sat_add(integrator, i_term), -i_limit, i_limit);
+
+    always @(posedge clk) begin
+        if(~reset | ~enable) begin
+            stage <= 6'd0;
+            diff100 <= 64'sd0;
+            error <= 32'sd0;
+            prev_error <= 32'sd0;
+            d_error <= 32'sd0;
+            p_prod <= 64'sd0;
+            i_prod <= 64'sd0;
+            d_prod <= 64'sd0;
+            p_term <= 32'sd0;
+            i_term <= 32'sd0;
+            d_term <= 32'sd0;
+            pi_sum <= 32'sd0;
+            integrator <= 32'sd0;
+            correction <= 32'sd0;
+            step_stb <= 1'b0;
+        end
+        else begin
+            stage <= {stage[4:0], rpm_stb};
+            step_stb <= stage[5];
+            // 1: error in 0.01 rpm
+            if(rpm_stb) begin
+                diff100 <= $signed({32'd0, setpoint}) - $signed({32'd0, rpm100});
+            end
+            // 2: to Q16.16 rpm
+            if(stage[0]) begin
+                error <= sat_shift(diff100 * RECIP_100_Q24, 8);
+            end
+            // 3: the derivative and the P and I products
+            if(stage[1]) begin
+                d_error <= sat_sub(error, prev_error);
+                prev_error <= error;
+                p_prod <= kp * error;
+                i_prod <= ki * error;
+            end
+            // 4: the D product, P and I back to Q16.16
+            if(stage[2]) begin
+                d_prod <= kd * d_error;
+                p_term <= sat_shift(p_prod, 16);
+                i_term <= sat_shift(i_prod, 16);
+            end
+            // 5: integrator, then P + I
+            if(stage[3]) begin
+                d_term <= sat_shift(d_prod, 16);
+                integrator <= integrator_next;
+                pi_sum <= sat_add(p_term, integrator_next);
+            end
+            // 6: + D and the output clamp
+            if(stage[4]) begin
+                correction <= clamp(sat_add(pi_sum, d_term), -out_limit, out_limit);
+            end
+        end
+    end
+
+    // PWM count from the correction, every clock
+    always @(posedge clk) begin
+        if(~reset) begin
+            duty_prod <= 64'sd0;
+            duty_sum <= 32'sd0;
+            duty <= 10'd0;
+        end
+        else begin
+            duty_prod <= correction * slope;
+            // whole counts, floored like Q16_TO_INT()
+            duty_sum <= sat_add($signed(feedforward), sat_shift(duty_prod, 32));
+            duty <= (duty_sum < 0) ? 10'd0 : ((duty_sum > MAX_DUTY) ? MAX_DUTY : duty_sum[9:0]);
+        end
+    end
+
+endmodule
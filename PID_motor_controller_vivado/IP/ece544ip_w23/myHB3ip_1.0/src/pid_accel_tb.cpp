@@ -0,0 +1,169 @@
+/**
+ * @file pid_accel_tb.cpp
+ *
+ * @authors Stephen, Drew, Noah
+ * @copyright Portland State University, 2023
+ *
+ * @brief
+ * Simulation only, not in the IP file sets. Runs pid_accel.v under
+ * Verilator in closed loop with a first order model of the motor and
+ * checks every step against pid_fixed_step() from src/pid_fixed.c fed the
+ * same error: error, integrator and duty have to match bit for bit. At the
+ * end of each setpoint the model has to be within 1 rpm of it.
+ *
+ * The model is the plant_sim one reduced to its steady state line and time
+ * constant: rpm ~= (duty - 389) * 76 / 634 above the deadband, tau 0.12s.
+ * rpm_stb is pulsed every 4 ms (a tach edge at about 20 rpm) with the
+ * speed truncated to 0.01 rpm, like rpm_calc.
+ *
+ * Build and run from this directory with:
+ *   verilator --cc --exe --build -Wno-fatal pid_accel.v pid_accel_tb.cpp \
+ *       -CFLAGS -I<repo>/src <repo>/src/pid_fixed.c
+ *   ./obj_dir/Vpid_accel
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ * ---------------------
+ * Ver  Who Date    Changes
+ * -----------------------------------
+ * 1.00a DS 17-Oct-2026 First release
+ * </pre>
+************************************************************/
+
+#include <cmath>
+#include <cstdio>
+#include "Vpid_accel.h"
+#include "verilated.h"
+
+extern "C" {
+#include "pid_fixed.h"
+}
+
+/*********Local Constants****************************/
+#define TB_MAX_DUTY             1023
+#define TB_DEADBAND_COUNT       389         // no motion below this count
+#define TB_FULL_RPM             76.0
+#define TB_TAU_S                0.12
+#define TB_SAMPLE_S             0.004       // between rpm_stb pulses
+#define TB_STEP_CLOCKS          10          // rpm_stb to duty out, with margin
+#define TB_SETTLE_S             3.0         // per setpoint
+#define TB_RECIP_100_Q24        167772      // as in pid_accel.v
+
+static Vpid_accel *dut;
+static int errors = 0;
+static int steps = 0;
+
+/**
+ * tick() - one clock
+*/
+static void tick(void) {
+    dut->clk = 0;
+    dut->eval();
+    dut->clk = 1;
+    dut->eval();
+}
+
+/**
+ * model_rpm() - steady state rpm for a PWM count
+*/
+static double model_rpm(uint32_t duty) {
+    if(duty <= TB_DEADBAND_COUNT) {
+        return 0.0;
+    }
+    return (duty - TB_DEADBAND_COUNT) * TB_FULL_RPM / (TB_MAX_DUTY - TB_DEADBAND_COUNT);
+}
+
+/**
+ * ref_duty() - the PWM count pid_accel.v should give for a correction
+*/
+static uint32_t ref_duty(int32_t ff, q16_t correction, q16_t slope) {
+    int64_t prod = ((int64_t)correction * slope) >> 32;
+    q16_t sum = q16_sat_add(ff, (prod > Q16_MAX) ? Q16_MAX : ((prod < Q16_MIN) ? Q16_MIN : (q16_t)prod));
+
+    return (sum < 0) ? 0 : ((sum > TB_MAX_DUTY) ? TB_MAX_DUTY : (uint32_t)sum);
+}
+
+/**
+ * run_setpoint() - closes the loop on one setpoint, checking every step
+*/
+static void run_setpoint(double set_rpm, double *rpm, ptr_pid_fixed_t ref) {
+    uint32_t set100 = (uint32_t)(set_rpm * 100.0);
+    // feedforward and slope from the model line, like the firmware takes them from rpm_lut.h
+    int32_t ff = TB_DEADBAND_COUNT + (int32_t)lround(set_rpm * (TB_MAX_DUTY - TB_DEADBAND_COUNT) / TB_FULL_RPM);
+    q16_t slope = (q16_t)lround((TB_MAX_DUTY - TB_DEADBAND_COUNT) / TB_FULL_RPM * 65536.0);
+
+    dut->setpoint = set100;
+    dut->feedforward = ff;
+    dut->slope = slope;
+    for(int i = 0; i < TB_STEP_CLOCKS; i++) {
+        tick();
+    }
+    for(double t = 0.0; t < TB_SETTLE_S; t += TB_SAMPLE_S) {
+        uint32_t rpm100 = (uint32_t)(*rpm * 100.0);
+        int64_t diff100 = (int64_t)set100 - rpm100;
+        int64_t error = (diff100 * TB_RECIP_100_Q24) >> 8;
+        q16_t ref_error = (error > Q16_MAX) ? Q16_MAX : ((error < Q16_MIN) ? Q16_MIN : (q16_t)error);
+        q16_t ref_out = pid_fixed_step(ref, ref_error);
+        uint32_t duty;
+
+        dut->rpm100 = rpm100;
+        dut->rpm_stb = 1;
+        tick();
+        dut->rpm_stb = 0;
+        for(int i = 0; i < TB_STEP_CLOCKS; i++) {
+            tick();
+        }
+        duty = dut->duty;
+        steps++;
+        if((q16_t)dut->error != ref_error || (q16_t)dut->integrator != ref->integrator
+           || (q16_t)dut->correction != ref_out || duty != ref_duty(ff, ref_out, slope)) {
+            if(errors++ < 10) {
+                printf("MISMATCH set %.0f rpm100 %u: error %d/%d integrator %d/%d correction %d/%d duty %u/%u\n",
+                       set_rpm, rpm100, (q16_t)dut->error, ref_error, (q16_t)dut->integrator,
+                       ref->integrator, (q16_t)dut->correction, ref_out, duty, ref_duty(ff, ref_out, slope));
+            }
+        }
+        // the model runs on the duty until the next sample
+        *rpm += (model_rpm(duty) - *rpm) * (1.0 - exp(-TB_SAMPLE_S / TB_TAU_S));
+    }
+    if(fabs(*rpm - set_rpm) > 1.0) {
+        errors++;
+        printf("NOT SETTLED set %.0f: %.2f rpm\n", set_rpm, *rpm);
+    }
+}
+
+int main(int argc, char **argv) {
+    static const double setpoints[] = {46.0, 54.0, 42.0, 20.0, 70.0};
+    pid_fixed_t ref;
+    double rpm = 0.0;
+
+    Verilated::commandArgs(argc, argv);
+    dut = new Vpid_accel;
+
+    pid_fixed_init(&ref, -Q16_FROM_INT(40), Q16_FROM_INT(40), Q16_FROM_INT(20));
+    pid_fixed_set_gains(&ref, Q16_FROM_INT(1) / 2, Q16_FROM_INT(1) / 8, Q16_FROM_INT(1) / 16);
+    dut->kp = ref.kp;
+    dut->ki = ref.ki;
+    dut->kd = ref.kd;
+    dut->i_limit = ref.i_max;
+    dut->out_limit = ref.out_max;
+    dut->enable = 1;
+    dut->reset = 0;
+    tick();
+    tick();
+    dut->reset = 1;
+
+    for(double set_rpm : setpoints) {
+        run_setpoint(set_rpm, &rpm, &ref);
+    }
+
+    if(errors == 0) {
+        printf("PASS: %d steps\n", steps);
+    }
+    else {
+        printf("FAIL: %d of %d steps\n", errors, steps);
+    }
+    dut->final();
+    delete dut;
+    return errors != 0;
+}
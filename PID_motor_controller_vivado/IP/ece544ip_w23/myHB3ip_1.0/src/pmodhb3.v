@@ -7,16 +7,24 @@
 // Module Name: pmodhb3
 
 // Revision 0.01 - File Created
-// Additional Comments: creates the PWM duty cycle for a 2KHz output using 100MHz
-//  					AXI clock. Based on the rgbPWM module provided by Roy Kravitz
+// Revision 0.02 - PWM_BITS duty resolution, carrier set at run time by prescale
+// Additional Comments: creates the PWM duty cycle from the 100MHz AXI clock,
+//  					at the carrier set below. Based on the rgbPWM module provided by Roy Kravitz
+//
+// The duty cycle is PWM_BITS (8 to 16) wide and left aligned under the
+// enable bit, controlReg[29 -: PWM_BITS], so a 10 bit count in [29:20]
+// means the same duty cycle at any resolution. The counter advances once
+// every prescale + 1 clocks, so the carrier is
+//   clk / ((prescale + 1) * 2^PWM_BITS)
+// 100 MHz / (100 * 1024) = 977 Hz with the reset values, prescale 3 is
+// 24.4 kHz at 10 bits and 0 is 24.4 kHz at 12 bits.
 //////////////////////////////////////////////////////////////////////////////////
 
 
 module pmodhb3
 #(
-	parameter DIVIDE_COUNT = 49,	// Clock divider terminal count
-	parameter POLARITY = 1'b1,		// 1 to drive PWM output high when active.  0 to invert the PWM output
-	parameter MAX_COUNT = 1024		// maximum count for the PWM counters
+	parameter PWM_BITS = 10,		// duty cycle resolution, 8 to 16 bits
+	parameter POLARITY = 1'b1		// 1 to drive PWM output high when active.  0 to invert the PWM output
 )
 (
     input wire clk,
@@ -24,66 +32,73 @@ module pmodhb3
     input wire tachA,
     input wire tachB,
     input wire [31:0]	controlReg,		// control register - duty cycle and enable bit
+    input wire [15:0]	prescale,		// clocks per PWM count - 1
     output wire enable,
     output wire direction
     );
-    
-reg [9:0]	DC;			// red, green, and blue duty cycles from ControlReg
-reg [9:0]	DC_latch;	// latched duty cycle registers
-reg			enablePWM;		// enable RGB outputs - only 1 for all 3 outputs
-reg [31:0]	count;	    // period counter
-reg [31:0]  div_count;
-reg			div_out;	// ouput of clock divider
 
-// input clock divider
+localparam [PWM_BITS-1:0] MAX_COUNT = {PWM_BITS{1'b1}};	// last count of a PWM period
+
+reg [PWM_BITS-1:0]	DC;			// duty cycle from ControlReg
+reg [PWM_BITS-1:0]	DC_latch;	// latched duty cycle register
+reg			enablePWM;		// enable PWM output
+reg [PWM_BITS-1:0]	count;	    // period counter
+reg [15:0]  div_count;
+reg			div_stb;	// 1 clock per PWM count
+
+// input clock divider, a clock enable rather than a derived clock so a new
+// prescale takes effect at the end of the current count
 always @(posedge clk) begin
 	if (~reset) begin
-		div_count <= 32'd0;
-		div_out <= 1'b0;
+		div_count <= 16'd0;
+		div_stb <= 1'b0;
 	end else begin
-		div_count <= div_count + 1'b1;
-		if (div_count >= DIVIDE_COUNT) begin
-			div_out <= ~div_out;
-			div_count <= 32'd0;
+		if (div_count >= prescale) begin
+			div_count <= 16'd0;
+			div_stb <= 1'b1;
+		end
+		else begin
+			div_count <= div_count + 1'b1;
+			div_stb <= 1'b0;
 		end
 	end
 end // clock divider
 
 // generate/latch the duty cycle and enable from the control register
-always @(posedge div_out) begin
+always @(posedge clk) begin
 	if (~reset) begin
-		DC <= 10'd0;
+		DC <= {PWM_BITS{1'b0}};
 		enablePWM <= 1'b0;
 	end
-	else begin
-		DC <= controlReg[29:20];
+	else if (div_stb) begin
+		DC <= controlReg[29 -: PWM_BITS];
 		enablePWM <= controlReg[31];
 	end
 end //generate/latch duty cycle and enable
 
-// PWM period counter
-always @(posedge div_out) begin
+// PWM period counter, wraps after MAX_COUNT
+always @(posedge clk) begin
 	if (~reset) begin
-		count <= 32'd0;
+		count <= {PWM_BITS{1'b0}};
 	end
-	else begin
+	else if (div_stb) begin
 		if (enablePWM) begin
-			count = (count < MAX_COUNT) ? count + 1'b1 : 32'd0;
+			count <= count + 1'b1;
 		end
         else begin
-            count= 32'd0;
+            count <= {PWM_BITS{1'b0}};
         end
     end
 end // PWM period counter
 
 // latch the duty cycle register so they only change on PWM count boundaries
-always @(posedge div_out)begin
+always @(posedge clk)begin
     if (~reset) begin
-		DC_latch <= 10'd0;
+		DC_latch <= {PWM_BITS{1'b0}};
 	end
-	else begin
+	else if (div_stb) begin
 		if (enablePWM) begin
-			if (count >= MAX_COUNT) begin
+			if (count == MAX_COUNT) begin
 					DC_latch <= DC;
             end
         end
@@ -0,0 +1,74 @@
+`timescale 1ns / 1ps
+//////////////////////////////////////////////////////////////////////////////////
+// Company: PSU ECE 544 Winter 2023
+// Engineer: Stephen, Drew, Noah
+//
+// Create Date: 10/17/2026 09:00:00 AM
+// Module Name: quadrature
+
+// Revision 0.01 - File Created
+// Additional Comments: x4 quadrature decoder for the tachA/tachB motor
+// encoder. Counts every edge of both channels (4 counts per tach tick) into a
+// signed position and publishes a signed speed in counts/second from the
+// position change over each 0.25s window, same window as the ticks module.
+// Positive is tachA leading tachB. Inputs must already be synchronized.
+//////////////////////////////////////////////////////////////////////////////////
+
+
+module quadrature
+#(
+    parameter MAX_COUNT = 25000000      // 0.25s speed window
+)
+(
+    input wire clk,
+    input wire reset,
+    input wire tachA,
+    input wire tachB,
+    output reg signed [31:0] position_out,  // x4 edge count, signed
+    output reg signed [31:0] speed_out,     // counts/second over the last window
+    output reg direction_out                // 1 if the last edge moved backwards
+);
+    // internal variables
+    reg previous_tachA, previous_tachB;
+    reg [31:0] clk_count;
+    reg signed [31:0] window_start;         // position at the start of the window
+    // any change on either channel is one count. The direction comes from
+    // whether A now matches where B was - A leading B counts up
+    wire quad_edge = tachA ^ previous_tachA ^ tachB ^ previous_tachB;
+    wire quad_up = tachA ^ previous_tachB;
+
+    // count edges
+    always @(posedge clk) begin
+        if(~reset) begin
+            previous_tachA <= tachA;
+            previous_tachB <= tachB;
+            position_out <= 32'sd0;
+            direction_out <= 1'b0;
+        end
+        else begin
+            previous_tachA <= tachA;
+            previous_tachB <= tachB;
+            if(quad_edge) begin
+                position_out <= quad_up ? position_out + 1'b1 : position_out - 1'b1;
+                direction_out <= ~quad_up;
+            end
+        end
+    end
+
+    // speed over a fixed window
+    always @(posedge clk) begin
+        if(~reset) begin
+            clk_count <= 32'd0;
+            window_start <= 32'sd0;
+            speed_out <= 32'sd0;
+        end
+        else begin
+            clk_count <= clk_count + 1'b1;
+            if(clk_count == MAX_COUNT) begin
+                speed_out <= (position_out - window_start) <<< 2;
+                window_start <= position_out;
+                clk_count <= 32'd0;
+            end
+        end
+    end
+endmodule
@@ -0,0 +1,110 @@
+`timescale 1ns / 1ps
+//////////////////////////////////////////////////////////////////////////////////
+// Company: PSU ECE 544 Winter 2023
+// Engineer: Stephen, Drew, Noah
+//
+// Create Date: 10/17/2026
+// Module Name: rpm_calc
+
+// Revision 0.01 - File Created
+// Additional Comments: converts the ticks measurements to output shaft
+// RPM x 100 so the MicroBlaze never divides.
+//
+// rpm100_period = 60 * CLK_FREQ_HZ * 10000 / (TICKS_PER_REV_X100 * period_avg)
+//   The constant numerator is folded at elaboration and divided by
+//   period_avg with a 32 clock restoring divider started by period_stb.
+//   period_avg is over 90000 clocks at full speed so the divider is
+//   always done long before the next edge. A period of 0 (stalled) gives 0.
+//
+// rpm100_window = tick_out * 60 * 10000 / TICKS_PER_REV_X100
+//   One multiply by the same constant in Q16, rounded. Exact to within
+//   one LSB (0.01 rpm) below 131072 ticks/second.
+//
+// Both results are truncated toward zero like the C integer math. Each
+// strobe is high in the clock its new value comes out, so the sample
+// interrupt is taken from these rather than the ticks strobes.
+//////////////////////////////////////////////////////////////////////////////////
+
+
+module rpm_calc
+#(
+    parameter CLK_FREQ_HZ = 100000000,      // AXI clock, period_avg is in these clocks
+    parameter TICKS_PER_REV_X100 = 82313    // tachA edges per output rev x 100, 11 * 74.83
+)
+(
+    input wire clk,
+    input wire reset,
+    input wire [31:0] tick_out,             // ticks/second from ticks.v
+    input wire tick_stb,
+    input wire [31:0] period_avg,           // averaged tachA period from ticks.v
+    input wire period_stb,
+    output reg [31:0] rpm100_window,        // RPM x 100 from tick_out
+    output reg window_stb,                  // 1 clock when rpm100_window is updated
+    output reg [31:0] rpm100_period,        // RPM x 100 from period_avg
+    output reg period_rpm_stb               // 1 clock when rpm100_period is updated
+);
+    // PERIOD_NUM must fit in 32 bits, 728924957 for the defaults
+    localparam [63:0] PERIOD_NUM = (64'd60 * CLK_FREQ_HZ * 64'd10000) / TICKS_PER_REV_X100;
+    localparam [63:0] WINDOW_K = ((64'd600000 << 16) + TICKS_PER_REV_X100 / 2) / TICKS_PER_REV_X100;
+
+    // window conversion, one multiply
+    wire [63:0] window_product = tick_out * WINDOW_K;
+    always @(posedge clk) begin
+        if(~reset) begin
+            rpm100_window <= 32'd0;
+            window_stb <= 1'b0;
+        end
+        else begin
+            window_stb <= tick_stb;
+            if(tick_stb) begin
+                rpm100_window <= window_product[47:16];
+            end
+        end
+    end
+
+    // period conversion, restoring divide one quotient bit per clock
+    reg [31:0] rem;
+    reg [31:0] quo;                         // numerator shifts out as the quotient shifts in
+    reg [31:0] divisor;
+    reg [5:0] bits_left;
+    wire [32:0] rem_shift = {rem, quo[31]};
+    wire [32:0] rem_diff = rem_shift - {1'b0, divisor};
+    wire quo_bit = ~rem_diff[32];
+    always @(posedge clk) begin
+        if(~reset) begin
+            rem <= 32'd0;
+            quo <= 32'd0;
+            divisor <= 32'd0;
+            bits_left <= 6'd0;
+            rpm100_period <= 32'd0;
+            period_rpm_stb <= 1'b0;
+        end
+        else begin
+            period_rpm_stb <= 1'b0;
+            if(period_stb) begin
+                // a new period restarts the divide
+                if(period_avg == 32'd0) begin
+                    rpm100_period <= 32'd0;
+                    period_rpm_stb <= 1'b1;
+                    bits_left <= 6'd0;
+                end
+                else begin
+                    rem <= 32'd0;
+                    quo <= PERIOD_NUM[31:0];
+                    divisor <= period_avg;
+                    bits_left <= 6'd32;
+                end
+            end
+            else if(bits_left != 6'd0) begin
+                rem <= quo_bit ? rem_diff[31:0] : rem_shift[31:0];
+                quo <= {quo[30:0], quo_bit};
+                bits_left <= bits_left - 1'b1;
+                if(bits_left == 6'd1) begin
+                    rpm100_period <= {quo[30:0], quo_bit};
+                    period_rpm_stb <= 1'b1;
+                end
+            end
+        end
+    end
+
+endmodule
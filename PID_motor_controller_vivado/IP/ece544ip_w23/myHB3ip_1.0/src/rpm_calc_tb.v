@@ -0,0 +1,158 @@
+`timescale 1ns / 1ps
+//////////////////////////////////////////////////////////////////////////////////
+// Company: PSU ECE 544 Winter 2023
+// Engineer: Stephen, Drew, Noah
+//
+// Create Date: 10/17/2026
+// Module Name: rpm_calc_tb
+
+// Revision 0.01 - File Created
+// Additional Comments: simulation only, not in the IP file sets. Checks
+// rpm_calc against the floating point formula the driver used to run,
+// ticks * 60 / 823.13 and 60 * 100 MHz / (823.13 * period), scaled by 100.
+// Every result has to be within one LSB (0.01 rpm) of the truncated float.
+//
+// The period sweep steps through 0.5 to 300 rpm plus the stall (period 0)
+// and the 32 bit extremes. The window sweep covers every ticks/second
+// value the 0.25s window can give (multiples of 4) up to 300 rpm.
+// Run with: xvlog rpm_calc.v rpm_calc_tb.v; xelab rpm_calc_tb; xsim rpm_calc_tb -R
+// or iverilog -o tb rpm_calc.v rpm_calc_tb.v; vvp tb
+//////////////////////////////////////////////////////////////////////////////////
+
+
+module rpm_calc_tb;
+    localparam real CLK_HZ = 100000000.0;
+    localparam real TICKS_PER_REV = 823.13;
+    localparam MAX_RPM100 = 30000;
+
+    reg clk = 1'b0;
+    reg reset = 1'b0;
+    reg [31:0] tick_out = 32'd0;
+    reg tick_stb = 1'b0;
+    reg [31:0] period_avg = 32'd0;
+    reg period_stb = 1'b0;
+    wire [31:0] rpm100_window;
+    wire window_stb;
+    wire [31:0] rpm100_period;
+    wire period_rpm_stb;
+
+    integer errors = 0;
+    integer checks = 0;
+    integer worst = 0;
+    integer rpm100;
+    integer t;
+
+    rpm_calc dut(
+        .clk(clk),
+        .reset(reset),
+        .tick_out(tick_out),
+        .tick_stb(tick_stb),
+        .period_avg(period_avg),
+        .period_stb(period_stb),
+        .rpm100_window(rpm100_window),
+        .window_stb(window_stb),
+        .rpm100_period(rpm100_period),
+        .period_rpm_stb(period_rpm_stb)
+    );
+
+    always #5 clk = ~clk;
+
+    // compares a result against the truncated float, +/- 1 LSB
+    task check(input [31:0] got, input real expect_rpm100, input [31:0] stimulus, input is_period);
+        real floor_expect;
+        integer diff;
+        begin
+            floor_expect = $floor(expect_rpm100);
+            diff = $rtoi(floor_expect) - got;
+            if(diff < 0) diff = -diff;
+            if(diff > worst) worst = diff;
+            checks = checks + 1;
+            if(diff > 1) begin
+                errors = errors + 1;
+                $display("MISMATCH %s %0d: fabric %0d, float %0.2f",
+                         is_period ? "period" : "ticks", stimulus, got, expect_rpm100);
+            end
+        end
+    endtask
+
+    // one period_avg update, waits for the divider
+    task run_period(input [31:0] period);
+        integer timeout;
+        begin
+            @(negedge clk);
+            period_avg = period;
+            period_stb = 1'b1;
+            @(negedge clk);
+            period_stb = 1'b0;
+            timeout = 0;
+            while(!period_rpm_stb && timeout < 40) begin
+                @(negedge clk);
+                timeout = timeout + 1;
+            end
+            if(!period_rpm_stb) begin
+                errors = errors + 1;
+                $display("TIMEOUT period %0d", period);
+            end
+            else if(period == 0) begin
+                check(rpm100_period, 0.0, period, 1);
+            end
+            else begin
+                check(rpm100_period, 60.0 * CLK_HZ * 100.0 / (TICKS_PER_REV * period), period, 1);
+            end
+        end
+    endtask
+
+    // one tick window closing
+    task run_window(input [31:0] ticks);
+        begin
+            @(negedge clk);
+            tick_out = ticks;
+            tick_stb = 1'b1;
+            @(negedge clk);
+            tick_stb = 1'b0;
+            if(!window_stb) begin
+                errors = errors + 1;
+                $display("NO STROBE ticks %0d", ticks);
+            end
+            check(rpm100_window, ticks * 60.0 * 100.0 / TICKS_PER_REV, ticks, 0);
+        end
+    endtask
+
+    initial begin
+        repeat(4) @(negedge clk);
+        reset = 1'b1;
+
+        // period path, the period for each 0.01 rpm step then its neighbours
+        run_period(32'd0);
+        for(rpm100 = 50; rpm100 <= MAX_RPM100; rpm100 = rpm100 + 1) begin
+            t = $rtoi(60.0 * CLK_HZ * 100.0 / (TICKS_PER_REV * rpm100));
+            run_period(t);
+            run_period(t + 1);
+        end
+        run_period(32'd1);
+        run_period(32'd25000000);
+        run_period(32'hFFFFFFFF);
+
+        // a new period in the middle of a divide restarts it
+        @(negedge clk);
+        period_avg = 32'd50000;
+        period_stb = 1'b1;
+        @(negedge clk);
+        period_stb = 1'b0;
+        repeat(10) @(negedge clk);
+        run_period(32'd120000);
+
+        // window path, every reachable ticks/second
+        for(t = 0; t <= MAX_RPM100 * TICKS_PER_REV / 6000; t = t + 4) begin
+            run_window(t);
+        end
+        run_window(32'd131068);
+
+        if(errors == 0)
+            $display("PASS: %0d checks, worst difference %0d LSB", checks, worst);
+        else
+            $display("FAIL: %0d of %0d checks", errors, checks);
+        $finish;
+    end
+
+endmodule
@@ -2,38 +2,54 @@
 //////////////////////////////////////////////////////////////////////////////////
 // Company: PSU ECE 544 Winter 2023
 // Engineer: Stephen, Drew, Noah
-// 
+//
 // Create Date: 02/26/2023 08:50:50 PM
 // Module Name: ticks
 
 // Revision 0.01 - File Created
+// Revision 0.02 - Added period capture of every tachA rising edge
+// Revision 0.03 - Added new sample strobes for the sample interrupt
 // Additional Comments: counts ticks per 0.25s using 100 MHz AXI clock as input
 // samples every 0.25s, multiplies by 4 to give approximation for ticks/second
+// Also timestamps every tachA rising edge with the clock and publishes the
+// last edge-to-edge period and a running average over 2^AVG_EDGES_LOG2 edges,
+// so speed is available one tach edge after it changes instead of 0.25s later
 //////////////////////////////////////////////////////////////////////////////////
 
 
 module ticks
 #(
-    parameter MAX_COUNT = 25000000  // 0.25s
+    parameter MAX_COUNT = 25000000,     // 0.25s
+    parameter AVG_EDGES_LOG2 = 3,       // period average is over 8 edges
+    parameter STALL_COUNT = 25000000    // no edge in 0.25s reads as stopped (period 0)
 )
 (
     input wire clk,
     input wire reset,
     input wire tachA,
-    output reg [31:0] tick_out
+    output reg [31:0] tick_out,
+    output reg [31:0] period_out,       // clocks between the last two tachA rising edges
+    output reg [31:0] period_avg_out,   // running average of period_out
+    output reg [31:0] edge_count_out,   // free running count of tachA rising edges
+    output reg tick_stb,                // 1 clock when tick_out is updated
+    output reg period_stb               // 1 clock when period_avg_out is updated
 );
+    localparam AVG_EDGES = 1 << AVG_EDGES_LOG2;
+
     // internal variables
     reg [31:0] clk_count;
-    reg [31:0] tick_count;  
-    reg previous_tachA;  
+    reg [31:0] tick_count;
+    reg previous_tachA;
     // determine how many ticks per second
     always @(posedge clk) begin
         if(~reset) begin
             clk_count <= 32'd0;
             tick_count <= 32'd0;
+            tick_stb <= 1'b0;
         end
         else begin
             clk_count <= clk_count + 1'b1;
+            tick_stb <= (clk_count == MAX_COUNT);
             previous_tachA <= tachA;
             // if positive edge of tick, increment tick count
             if(previous_tachA == 0 && tachA == 1) begin
@@ -46,6 +62,68 @@ module ticks
             end
         end
     end
-endmodule
 
+    // period capture variables
+    reg [31:0] since_edge;                          // clocks since the last rising edge
+    reg [31:0] period_hist [0:AVG_EDGES-1];         // last AVG_EDGES periods
+    reg [AVG_EDGES_LOG2-1:0] hist_idx;              // oldest entry in period_hist
+    reg [31+AVG_EDGES_LOG2:0] period_sum;           // sum of period_hist
+    reg have_edge;                                  // an edge has been seen since reset/stall
+    reg have_period;                                // period_hist holds real periods
+    wire tach_edge = (previous_tachA == 0 && tachA == 1);
+    wire [31+AVG_EDGES_LOG2:0] next_sum = period_sum - period_hist[hist_idx] + since_edge;
+    integer i;
 
+    // time every rising edge
+    always @(posedge clk) begin
+        if(~reset) begin
+            since_edge <= 32'd0;
+            period_out <= 32'd0;
+            period_avg_out <= 32'd0;
+            edge_count_out <= 32'd0;
+            period_sum <= 0;
+            hist_idx <= 0;
+            have_edge <= 1'b0;
+            have_period <= 1'b0;
+            period_stb <= 1'b0;
+            for(i = 0; i < AVG_EDGES; i = i + 1)
+                period_hist[i] <= 32'd0;
+        end
+        else begin
+            // a new period, or the drop to 0 when the motor stalls
+            period_stb <= (tach_edge && have_edge) || (~tach_edge && since_edge >= STALL_COUNT && have_edge);
+            if(tach_edge) begin
+                edge_count_out <= edge_count_out + 1'b1;
+                since_edge <= 32'd1;
+                have_edge <= 1'b1;
+                if(have_edge && ~have_period) begin
+                    // first period after reset or a stall primes the whole
+                    // average so it does not ramp up from zero
+                    for(i = 0; i < AVG_EDGES; i = i + 1)
+                        period_hist[i] <= since_edge;
+                    period_sum <= since_edge << AVG_EDGES_LOG2;
+                    period_out <= since_edge;
+                    period_avg_out <= since_edge;
+                    have_period <= 1'b1;
+                end
+                else if(have_period) begin
+                    period_hist[hist_idx] <= since_edge;
+                    hist_idx <= hist_idx + 1'b1;
+                    period_sum <= next_sum;
+                    period_out <= since_edge;
+                    period_avg_out <= next_sum >> AVG_EDGES_LOG2;
+                end
+            end
+            else if(since_edge >= STALL_COUNT) begin
+                // motor stopped, next edge starts over
+                period_out <= 32'd0;
+                period_avg_out <= 32'd0;
+                have_edge <= 1'b0;
+                have_period <= 1'b0;
+            end
+            else begin
+                since_edge <= since_edge + 1'b1;
+            end
+        end
+    end
+endmodule
@@ -0,0 +1,323 @@
+`timescale 1ns / 1ps
+//////////////////////////////////////////////////////////////////////////////////
+// Company: PSU ECE 544 Winter 2023
+// Engineer: Stephen, Drew, Noah
+//
+// Create Date: 10/17/2026
+// Module Name: ticks_tb
+
+// Revision 0.01 - File Created
+// Additional Comments: simulation only, not in the IP file sets. Checks
+// ticks against a clock by clock reference model, with a short window and
+// stall count so it runs in a few thousand clocks:
+//  - the edge count after every tach edge, and its 32 bit wrap
+//  - the edge-to-edge period, the longest one that is not a stall, the
+//    drop to 0 and the one clock strobe when the tach stops, and the
+//    first edge after reset or a stall giving no period
+//  - the running average, primed by the first period, over uneven periods,
+//    a speed step, and periods near 2^32 so the sum needs its extra bits
+//  - the ticks/second of every 0.25s window, checked at each tick_stb,
+//    including windows full of edges two clocks apart
+// Every period_stb pulse has to be one the model expects.
+// Run with: xvlog ticks.v ticks_tb.v; xelab ticks_tb; xsim ticks_tb -R
+// or iverilog -o tb ticks.v ticks_tb.v; vvp tb
+//////////////////////////////////////////////////////////////////////////////////
+
+
+module ticks_tb;
+    localparam MAX_COUNT = 1000;            // window of MAX_COUNT + 1 clocks
+    localparam AVG_EDGES_LOG2 = 3;
+    localparam AVG_EDGES = 1 << AVG_EDGES_LOG2;
+    localparam STALL_COUNT = 3000;
+
+    reg clk = 1'b0;
+    reg reset = 1'b0;
+    reg tachA = 1'b0;
+    wire [31:0] tick_out;
+    wire [31:0] period_out;
+    wire [31:0] period_avg_out;
+    wire [31:0] edge_count_out;
+    wire tick_stb;
+    wire period_stb;
+
+    integer errors = 0;
+    integer checks = 0;
+    integer k;
+
+    // period model, updated by the stimulus tasks
+    reg m_have_edge;
+    reg m_have_period;
+    reg m_stb;                              // period_stb expected after the last edge
+    reg [31:0] m_hist [0:AVG_EDGES-1];
+    integer m_idx;
+    reg [63:0] m_sum;
+    reg [31:0] m_period;
+    reg [31:0] m_avg;
+    reg [31:0] m_edges;
+    integer m_period_stbs = 0;
+    integer period_stbs = 0;
+
+    // window model, runs alongside the DUT every clock
+    reg m_prev = 1'b0;
+    integer m_clk = 0;
+    integer m_ticks = 0;
+    reg [31:0] m_tick_out = 32'd0;
+    reg m_tick_stb = 1'b0;
+    integer windows = 0;
+
+    ticks #(
+        .MAX_COUNT(MAX_COUNT),
+        .AVG_EDGES_LOG2(AVG_EDGES_LOG2),
+        .STALL_COUNT(STALL_COUNT)
+    ) dut(
+        .clk(clk),
+        .reset(reset),
+        .tachA(tachA),
+        .tick_out(tick_out),
+        .period_out(period_out),
+        .period_avg_out(period_avg_out),
+        .edge_count_out(edge_count_out),
+        .tick_stb(tick_stb),
+        .period_stb(period_stb)
+    );
+
+    always #5 clk = ~clk;
+
+    always @(posedge clk) begin
+        if(~reset) begin
+            m_clk = 0;
+            m_ticks = 0;
+            m_tick_stb = 1'b0;
+        end
+        else begin
+            m_tick_stb = (m_clk == MAX_COUNT);
+            // ticks.v clears the count on the closing clock, so an edge
+            // on that clock is not counted in either window
+            if(!m_prev && tachA && !m_tick_stb)
+                m_ticks = m_ticks + 1;
+            if(m_tick_stb) begin
+                m_tick_out = m_ticks << 2;
+                m_ticks = 0;
+                m_clk = 0;
+            end
+            else begin
+                m_clk = m_clk + 1;
+            end
+            m_prev = tachA;
+        end
+    end
+
+    always @(negedge clk) begin
+        if(period_stb === 1'b1)
+            period_stbs = period_stbs + 1;
+        if(reset) begin
+            checks = checks + 1;
+            if(tick_stb !== m_tick_stb) begin
+                errors = errors + 1;
+                $display("MISMATCH tick_stb %b, expected %b at %0t", tick_stb, m_tick_stb, $time);
+            end
+            else if(tick_stb) begin
+                windows = windows + 1;
+                if(tick_out !== m_tick_out) begin
+                    errors = errors + 1;
+                    $display("MISMATCH ticks/second %0d, expected %0d at %0t", tick_out, m_tick_out, $time);
+                end
+            end
+        end
+    end
+
+    task check(input [31:0] got, input [31:0] want, input [8*24-1:0] what);
+        begin
+            checks = checks + 1;
+            if(got !== want) begin
+                errors = errors + 1;
+                $display("MISMATCH %0s at edge %0d: got %0d, expected %0d", what, m_edges, got, want);
+            end
+        end
+    endtask
+
+    task model_reset;
+        integer j;
+        begin
+            m_have_edge = 1'b0;
+            m_have_period = 1'b0;
+            m_stb = 1'b0;
+            m_idx = 0;
+            m_sum = 64'd0;
+            m_period = 32'd0;
+            m_avg = 32'd0;
+            m_edges = 32'd0;
+            for(j = 0; j < AVG_EDGES; j = j + 1)
+                m_hist[j] = 32'd0;
+        end
+    endtask
+
+    // a tach edge p clocks after the one before
+    task model_edge(input [31:0] p);
+        integer j;
+        begin
+            m_edges = m_edges + 1;
+            m_stb = m_have_edge;
+            if(m_have_edge)
+                m_period_stbs = m_period_stbs + 1;
+            if(m_have_edge && !m_have_period) begin
+                for(j = 0; j < AVG_EDGES; j = j + 1)
+                    m_hist[j] = p;
+                m_sum = {32'd0, p} << AVG_EDGES_LOG2;
+                m_period = p;
+                m_avg = p;
+                m_have_period = 1'b1;
+            end
+            else if(m_have_period) begin
+                m_sum = m_sum - m_hist[m_idx] + p;
+                m_hist[m_idx] = p;
+                m_idx = (m_idx + 1) % AVG_EDGES;
+                m_period = p;
+                m_avg = m_sum >> AVG_EDGES_LOG2;
+            end
+            m_have_edge = 1'b1;
+        end
+    endtask
+
+    task check_edge;
+        begin
+            check(edge_count_out, m_edges, "edge count");
+            check(period_out, m_period, "period");
+            check(period_avg_out, m_avg, "period average");
+            check(period_stb, m_stb, "period strobe");
+        end
+    endtask
+
+    // call at the negedge after the last edge (where the tasks return).
+    // tachA goes high n clocks after the last rise for one clock, the DUT
+    // sees the edge on the posedge after and the outputs are checked on
+    // the negedge after that
+    task tach_edge(input [31:0] n);
+        begin
+            repeat(n - 1) @(negedge clk);
+            tachA = 1'b1;
+            @(negedge clk);
+            tachA = 1'b0;
+            model_edge(n);
+            check_edge;
+        end
+    endtask
+
+    // same, with the clocks since the last edge set to p just before it,
+    // for periods far longer than the stall count that can be simulated
+    task tach_edge_long(input [31:0] p);
+        begin
+            repeat(9) @(negedge clk);
+            dut.since_edge = p;
+            tachA = 1'b1;
+            @(negedge clk);
+            tachA = 1'b0;
+            model_edge(p);
+            check_edge;
+        end
+    endtask
+
+    // call right after an edge, the outputs drop to 0 STALL_COUNT clocks later
+    task stall;
+        begin
+            repeat(STALL_COUNT - 1) @(negedge clk);
+            check(period_out, m_period, "period before the stall");
+            check(period_stb, 1'b0, "strobe before the stall");
+            @(negedge clk);
+            check(period_stb, m_have_edge, "stall strobe");
+            if(m_have_edge)
+                m_period_stbs = m_period_stbs + 1;
+            m_have_edge = 1'b0;
+            m_have_period = 1'b0;
+            m_period = 32'd0;
+            m_avg = 32'd0;
+            check(period_out, 32'd0, "stalled period");
+            check(period_avg_out, 32'd0, "stalled average");
+            @(negedge clk);
+            check(period_stb, 1'b0, "strobe after the stall");
+        end
+    endtask
+
+    initial begin
+        model_reset;
+        repeat(4) @(negedge clk);
+        reset = 1'b1;
+
+        // no edges yet, nothing to report while the stall count runs out
+        repeat(STALL_COUNT + 10) @(negedge clk);
+        check(period_out, 32'd0, "period before any edge");
+        check(period_avg_out, 32'd0, "average before any edge");
+        check(edge_count_out, 32'd0, "edges before any edge");
+
+        // first edge gives no period, the second primes the average
+        tach_edge(50);
+        tach_edge(400);
+        for(k = 0; k < 64; k = k + 1)
+            tach_edge(300 + (k * 37) % 200);
+        // speed step, the average is there AVG_EDGES edges later
+        for(k = 0; k < AVG_EDGES; k = k + 1)
+            tach_edge(150);
+        check(period_avg_out, 32'd150, "average after a step");
+
+        // the longest period that is not a stall, then a stall
+        tach_edge(STALL_COUNT);
+        stall;
+
+        // after a stall the first edge is only a start again
+        tach_edge(20);
+        tach_edge(200);
+        for(k = 0; k < 10; k = k + 1)
+            tach_edge(200 + k);
+        stall;
+
+        // edges 2 to 4 clocks apart, several windows full of them
+        tach_edge(100);
+        for(k = 0; k < 3000; k = k + 1)
+            tach_edge(2 + k % 3);
+
+        // periods near 2^32, the sum of AVG_EDGES of them needs 32 +
+        // AVG_EDGES_LOG2 bits, then back down to check nothing was lost
+        for(k = 0; k < AVG_EDGES + 1; k = k + 1)
+            tach_edge_long(32'hFFFFFFFF - k * 4096);
+        for(k = 0; k < AVG_EDGES; k = k + 1)
+            tach_edge(500);
+        check(period_avg_out, 32'd500, "average after long periods");
+
+        // the edge count is free running and wraps
+        dut.edge_count_out = 32'hFFFFFFFE;
+        m_edges = 32'hFFFFFFFE;
+        tach_edge(100);
+        tach_edge(100);
+        check(edge_count_out, 32'd0, "edge count wrap");
+
+        // reset in the middle of a run clears it all, then primes again
+        reset = 1'b0;
+        repeat(3) @(negedge clk);
+        check(period_out, 32'd0, "period in reset");
+        check(period_avg_out, 32'd0, "average in reset");
+        check(edge_count_out, 32'd0, "edge count in reset");
+        check(period_stb, 1'b0, "strobe in reset");
+        model_reset;
+        reset = 1'b1;
+        tach_edge(100);
+        tach_edge(250);
+        tach_edge(260);
+
+        @(negedge clk);
+        if(period_stbs != m_period_stbs) begin
+            errors = errors + 1;
+            $display("MISMATCH %0d period strobes, expected %0d", period_stbs, m_period_stbs);
+        end
+        if(windows == 0) begin
+            errors = errors + 1;
+            $display("MISMATCH no tick windows closed");
+        end
+
+        if(errors == 0)
+            $display("PASS: %0d checks, %0d periods, %0d windows", checks, m_period_stbs, windows);
+        else
+            $display("FAIL: %0d of %0d checks", errors, checks);
+        $finish;
+    end
+
+endmodule
@@ -11,21 +11,58 @@ proc init_gui { IPINST } {
 
 }
 
-proc update_PARAM_VALUE.DIVIDE_COUNT { PARAM_VALUE.DIVIDE_COUNT } {
-	# Procedure called to update DIVIDE_COUNT when any of the dependent parameters in the arguments change
+proc update_PARAM_VALUE.PWM_PRESCALE { PARAM_VALUE.PWM_PRESCALE } {
+	# Procedure called to update PWM_PRESCALE when any of the dependent parameters in the arguments change
 }
 
-proc validate_PARAM_VALUE.DIVIDE_COUNT { PARAM_VALUE.DIVIDE_COUNT } {
-	# Procedure called to validate DIVIDE_COUNT
+proc validate_PARAM_VALUE.PWM_PRESCALE { PARAM_VALUE.PWM_PRESCALE } {
+	# Procedure called to validate PWM_PRESCALE
 	return true
 }
 
-proc update_PARAM_VALUE.MAX_COUNT { PARAM_VALUE.MAX_COUNT } {
-	# Procedure called to update MAX_COUNT when any of the dependent parameters in the arguments change
+proc update_PARAM_VALUE.PWM_BITS { PARAM_VALUE.PWM_BITS } {
+	# Procedure called to update PWM_BITS when any of the dependent parameters in the arguments change
 }
 
-proc validate_PARAM_VALUE.MAX_COUNT { PARAM_VALUE.MAX_COUNT } {
-	# Procedure called to validate MAX_COUNT
+proc validate_PARAM_VALUE.PWM_BITS { PARAM_VALUE.PWM_BITS } {
+	# Procedure called to validate PWM_BITS
+	set value [get_property value ${PARAM_VALUE.PWM_BITS}]
+	if { $value < 8 || $value > 16 } {
+		set_property errmsg "PWM_BITS must be 8 to 16" ${PARAM_VALUE.PWM_BITS}
+		return false
+	}
+	return true
+}
+
+proc update_PARAM_VALUE.TICKS_PER_REV_X100 { PARAM_VALUE.TICKS_PER_REV_X100 } {
+	# Procedure called to update TICKS_PER_REV_X100 when any of the dependent parameters in the arguments change
+}
+
+proc validate_PARAM_VALUE.TICKS_PER_REV_X100 { PARAM_VALUE.TICKS_PER_REV_X100 } {
+	# Procedure called to validate TICKS_PER_REV_X100
+	return true
+}
+
+proc update_PARAM_VALUE.PID_ACCEL { PARAM_VALUE.PID_ACCEL } {
+	# Procedure called to update PID_ACCEL when any of the dependent parameters in the arguments change
+}
+
+proc validate_PARAM_VALUE.PID_ACCEL { PARAM_VALUE.PID_ACCEL } {
+	# Procedure called to validate PID_ACCEL
+	return true
+}
+
+proc update_PARAM_VALUE.NUM_CHANNELS { PARAM_VALUE.NUM_CHANNELS } {
+	# Procedure called to update NUM_CHANNELS when any of the dependent parameters in the arguments change
+}
+
+proc validate_PARAM_VALUE.NUM_CHANNELS { PARAM_VALUE.NUM_CHANNELS } {
+	# Procedure called to validate NUM_CHANNELS
+	set value [get_property value ${PARAM_VALUE.NUM_CHANNELS}]
+	if { $value < 1 || $value > 4 } {
+		set_property errmsg "NUM_CHANNELS must be 1 to 4" ${PARAM_VALUE.NUM_CHANNELS}
+		return false
+	}
 	return true
 }
 
@@ -85,9 +122,9 @@ proc update_MODELPARAM_VALUE.C_S00_AXI_ADDR_WIDTH { MODELPARAM_VALUE.C_S00_AXI_A
 	set_property value [get_property value ${PARAM_VALUE.C_S00_AXI_ADDR_WIDTH}] ${MODELPARAM_VALUE.C_S00_AXI_ADDR_WIDTH}
 }
 
-proc update_MODELPARAM_VALUE.DIVIDE_COUNT { MODELPARAM_VALUE.DIVIDE_COUNT PARAM_VALUE.DIVIDE_COUNT } {
+proc update_MODELPARAM_VALUE.PWM_PRESCALE { MODELPARAM_VALUE.PWM_PRESCALE PARAM_VALUE.PWM_PRESCALE } {
 	# Procedure called to set VHDL generic/Verilog parameter value(s) based on TCL parameter value
-	set_property value [get_property value ${PARAM_VALUE.DIVIDE_COUNT}] ${MODELPARAM_VALUE.DIVIDE_COUNT}
+	set_property value [get_property value ${PARAM_VALUE.PWM_PRESCALE}] ${MODELPARAM_VALUE.PWM_PRESCALE}
 }
 
 proc update_MODELPARAM_VALUE.POLARITY { MODELPARAM_VALUE.POLARITY PARAM_VALUE.POLARITY } {
@@ -95,8 +132,22 @@ proc update_MODELPARAM_VALUE.POLARITY { MODELPARAM_VALUE.POLARITY PARAM_VALUE.PO
 	set_property value [get_property value ${PARAM_VALUE.POLARITY}] ${MODELPARAM_VALUE.POLARITY}
 }
 
-proc update_MODELPARAM_VALUE.MAX_COUNT { MODELPARAM_VALUE.MAX_COUNT PARAM_VALUE.MAX_COUNT } {
+proc update_MODELPARAM_VALUE.PWM_BITS { MODELPARAM_VALUE.PWM_BITS PARAM_VALUE.PWM_BITS } {
+	# Procedure called to set VHDL generic/Verilog parameter value(s) based on TCL parameter value
+	set_property value [get_property value ${PARAM_VALUE.PWM_BITS}] ${MODELPARAM_VALUE.PWM_BITS}
+}
+
+proc update_MODELPARAM_VALUE.TICKS_PER_REV_X100 { MODELPARAM_VALUE.TICKS_PER_REV_X100 PARAM_VALUE.TICKS_PER_REV_X100 } {
 	# Procedure called to set VHDL generic/Verilog parameter value(s) based on TCL parameter value
-	set_property value [get_property value ${PARAM_VALUE.MAX_COUNT}] ${MODELPARAM_VALUE.MAX_COUNT}
+	set_property value [get_property value ${PARAM_VALUE.TICKS_PER_REV_X100}] ${MODELPARAM_VALUE.TICKS_PER_REV_X100}
 }
 
+proc update_MODELPARAM_VALUE.PID_ACCEL { MODELPARAM_VALUE.PID_ACCEL PARAM_VALUE.PID_ACCEL } {
+	# Procedure called to set VHDL generic/Verilog parameter value(s) based on TCL parameter value
+	set_property value [get_property value ${PARAM_VALUE.PID_ACCEL}] ${MODELPARAM_VALUE.PID_ACCEL}
+}
+
+proc update_MODELPARAM_VALUE.NUM_CHANNELS { MODELPARAM_VALUE.NUM_CHANNELS PARAM_VALUE.NUM_CHANNELS } {
+	# Procedure called to set VHDL generic/Verilog parameter value(s) based on TCL parameter value
+	set_property value [get_property value ${PARAM_VALUE.NUM_CHANNELS}] ${MODELPARAM_VALUE.NUM_CHANNELS}
+}
@@ -17,6 +17,7 @@
 * ----- ---- -------- -----------------------------------------------
 * 1.00a	rhk	12/20/14	First release of driver
 * 1.01a	rhk	01/10/18	updates for SDK 2017.3
+* 1.02a	DS	10/17/26	input change interrupt
 * </pre>
 *
 ******************************************************************************/
@@ -175,6 +176,47 @@ bool NX4IO_isPressed(enum _NX4IO_btns btnslct)
 }
 
 
+/****************************************************************************/
+/**
+* enables or disables the input change interrupt
+*
+* The peripheral raises input_irq whenever the debounced BTNSW_IN changes.
+* A change latched while the interrupt was off is dropped.
+*
+* @param	enable is true to enable the interrupt
+*
+* @return	None
+*
+*****************************************************************************/
+void NX4IO_enableInputInterrupt(bool enable)
+{
+	NEXYS4IO_mWriteReg(NX4IO_BaseAddress, NEXYS4IO_IRQ_STATUS_OFFSET, NEXYS4IO_IRQ_INPUT_MASK);
+	NEXYS4IO_mWriteReg(NX4IO_BaseAddress, NEXYS4IO_IRQ_ENABLE_OFFSET, enable ? NEXYS4IO_IRQ_INPUT_MASK : 0);
+}
+
+
+/****************************************************************************/
+/**
+* clears a pending input change interrupt
+*
+* Call from the interrupt handler before reading BTNSW_IN, so a change
+* after the read raises the interrupt again.
+*
+* @param	None
+*
+* @return	true if an input change was pending
+*
+*****************************************************************************/
+bool NX4IO_ackInputInterrupt(void)
+{
+	u32 status;
+
+	status = NEXYS4IO_mReadReg(NX4IO_BaseAddress, NEXYS4IO_IRQ_STATUS_OFFSET) & NEXYS4IO_IRQ_INPUT_MASK;
+	NEXYS4IO_mWriteReg(NX4IO_BaseAddress, NEXYS4IO_IRQ_STATUS_OFFSET, status);
+	return (status != 0) ? true : false;
+}
+
+
 /******************************** LEDS **************************************/
 
 /****************************************************************************/
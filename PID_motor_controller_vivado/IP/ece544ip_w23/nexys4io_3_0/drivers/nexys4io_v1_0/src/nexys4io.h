@@ -17,6 +17,7 @@
 * ----- ---- -------- -----------------------------------------------
 * 1.00a	rhk	12/20/14	First release of driver
 * 1.01a rhk	01/10/18	updated for SDK 2017.3
+* 1.02a	DS	10/17/26	input change interrupt
 * </pre>
 *
 ******************************************************************************/
@@ -50,6 +51,9 @@
 #define NEXYS4IO_ALLBTNS_MASK		0x001F0000
 #define NEXYS4IO_ALLSWITCHES_MASK	0x0000FFFF
 
+// Mask for the input change interrupt enable and status registers
+#define NEXYS4IO_IRQ_INPUT_MASK		0x00000001
+
 // Masks for LEDs
 #define NEXYS4IO_LEDS_MASK			0x0000FFFF
 #define NEXYS4IO_RGB_BLUEDC_MASK	0x000000FF
@@ -115,6 +119,8 @@ u32 NX4IO_getBTNSW_IN(void);
 u8 NX4IO_getBtns(void);
 u16 NX4IO_getSwitches(void);
 bool NX4IO_isPressed(enum _NX4IO_btns);
+void NX4IO_enableInputInterrupt(bool enable);
+bool NX4IO_ackInputInterrupt(void);
 
 // LED functions
 u32 NX4IO_getLEDS_DATA(void);
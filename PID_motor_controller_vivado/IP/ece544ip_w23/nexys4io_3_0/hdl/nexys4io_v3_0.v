@@ -33,6 +33,7 @@
         output wire [6:0] seg,
         output wire dp,
         output wire [7:0] an,
+        output wire input_irq,
 		// User ports ends
 		// Do not modify the ports beyond this line
 
@@ -82,6 +83,7 @@
         .seg(seg),
         .dp(dp),
         .an(an),
+        .input_irq(input_irq),
             
 		.S_AXI_ACLK(s00_axi_aclk),
 		.S_AXI_ARESETN(s00_axi_aresetn),
@@ -33,6 +33,9 @@
         output wire [6:0] seg,
         output wire dp,
         output wire [7:0] an,
+
+        // level high while an enabled button/switch change is pending
+        output wire input_irq,
 		// User ports ends
 		
 		// Do not modify the ports beyond this line
@@ -138,6 +141,8 @@
 	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg13;
 	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg14;
 	reg [C_S_AXI_DATA_WIDTH-1:0]	slv_reg15;
+	reg [31:0]	btnsw_prev;		// btnsw_in one clock ago
+	reg	input_status;			// debounced buttons or switches changed
 	wire	 slv_reg_rden;
 	wire	 slv_reg_wren;
 	reg [C_S_AXI_DATA_WIDTH-1:0]	 reg_data_out;
@@ -518,7 +523,7 @@
 	        4'h6   : reg_data_out <= slv_reg6;
 	        4'h7   : reg_data_out <= slv_reg7;
 	        4'h8   : reg_data_out <= slv_reg8;
-	        4'h9   : reg_data_out <= slv_reg9;
+	        4'h9   : reg_data_out <= {31'd0, input_status};
 	        4'hA   : reg_data_out <= slv_reg10;
 	        4'hB   : reg_data_out <= slv_reg11;
 	        4'hC   : reg_data_out <= slv_reg12;
@@ -588,6 +593,25 @@
      // Map the module inputs to the Microblaze register
      assign btnsw_in = {8'b00000000, 3'b000, db_btns[5:1], db_sw}; 
     
+     // input change interrupt. slv_reg8[0] enables it, writing a 1 to bit 0
+     // of the status register (0x24) clears it. A change in the same clock
+     // as the clear wins. The inputs are already debounced, so this fires
+     // once per press, release or switch flip
+     always @(posedge S_AXI_ACLK) begin
+         if (S_AXI_ARESETN == 1'b0) begin
+             btnsw_prev <= 32'd0;
+             input_status <= 1'b0;
+         end
+         else begin
+             btnsw_prev <= btnsw_in;
+             if (slv_reg_wren && axi_awaddr[ADDR_LSB+OPT_MEM_ADDR_BITS:ADDR_LSB] == 4'h9)
+                 input_status <= (input_status & ~S_AXI_WDATA[0]) | (btnsw_in != btnsw_prev);
+             else
+                 input_status <= input_status | (btnsw_in != btnsw_prev);
+         end
+     end
+     assign input_irq = input_status & slv_reg8[0];
+    
      // Map the slave registers to the module inputs and outputs
      // LED outputs
      assign led = slv_reg1[15:0];
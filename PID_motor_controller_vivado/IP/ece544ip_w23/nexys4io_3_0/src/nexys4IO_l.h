@@ -17,6 +17,7 @@
 * ----- ---- -------- -----------------------------------------------
 * 1.00a	rhk	12/20/14	First release of driver
 * 1.01a rhk 01/10/18	updates for SDK 2017.3
+* 1.02a	DS	10/17/26	input change interrupt registers
 * </pre>
 *
 ******************************************************************************/
@@ -44,8 +45,8 @@
 #define NEXYS4IO_RGB2_CNTRL_OFFSET 20
 #define NEXYS4IO_SSEGLO_DATA_OFFSET 24
 #define NEXYS4IO_SSEGHI_DATA_OFFSET 28
-#define NEXYS4IO_RSVD00_OFFSET 32
-#define NEXYS4IO_RSVD01_OFFSET 36
+#define NEXYS4IO_IRQ_ENABLE_OFFSET 32
+#define NEXYS4IO_IRQ_STATUS_OFFSET 36
 #define NEXYS4IO_RSVD02_OFFSET 40
 #define NEXYS4IO_RSVD03_OFFSET 44
 #define NEXYS4IO_RSVD04_OFFSET 48
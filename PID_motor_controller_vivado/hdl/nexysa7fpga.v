@@ -96,7 +96,7 @@ module nexysa7fpga
   assign JA_0[0] = DIR;
   assign JA_0[1] = EN;
   assign SA    = JA_1[0];
-  assign SB    = JA_1[1]; //not used, but connected to tachB on HB3 IP
+  assign SB    = JA_1[1]; // tachB on HB3 IP, quadrature decoded with SA
   // assign signals to the JC header for encoder
   assign EcA   = JC[4]; // E7 
   assign EcB   = JC[5]; // J3
@@ -0,0 +1,120 @@
+/**
+ * @file pidctl_bench.c
+ *
+ * @authors Stephen, Drew, Noah
+ * @copyright Portland State University, 2023
+ *
+ * @brief
+ * Host benchmark for the controller firmware built against the mock HAL.
+ * Brings the system up through system_init() like main.c, then
+ *  - times control_pid_step() back to back with a new tach sample each
+ *    step, through the myHB3ip driver and its sample interrupt handler
+ *  - runs the control tick off the model clock for a while and prints the
+ *    tick and telemetry stats the firmware keeps
+ *
+ * usage: pidctl_bench [steps] [model seconds]
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ * ---------------------
+ * Ver  Who Date    Changes
+ * -----------------------------------
+ * 1.00a DS 17-Oct-2026 First release
+ * </pre>
+************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "hal_mock.h"
+#include "sys_init.h"
+#include "cntrl_logic.h"
+#include "ctrl_tick.h"
+#include "logger.h"
+#include "microblaze_sleep.h"
+
+#define BENCH_STEPS             10000000
+#define BENCH_MODEL_SECONDS     5
+#define BENCH_ROTARY_COUNT      10          // a mid range setpoint
+#define BENCH_PID_SWITCHES      0x0007      // Kp, Ki and Kd on
+#define BENCH_BTNU              0x08
+#define BENCH_BTNL              0x02
+#define BENCH_BASE_PERIOD       121488      // ~60 rpm in AXI clocks per tach edge
+
+static user_io_t uIO;
+
+/**
+ * poll_ui() - one pass of the main loop's user IO handling
+*/
+static void poll_ui(void) {
+    update_pid(&uIO);
+}
+
+/**
+ * press() - presses and releases a Nexys A7 button
+*/
+static void press(u16 switches, u8 button) {
+    mock_set_inputs(switches, button);
+    poll_ui();
+    mock_set_inputs(switches, 0);
+    poll_ui();
+}
+
+static double wall_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char *argv[]) {
+    long steps = (argc > 1) ? atol(argv[1]) : BENCH_STEPS;
+    long model_seconds = (argc > 2) ? atol(argv[2]) : BENCH_MODEL_SECONDS;
+    double start, elapsed;
+    volatile u32 sink = 0;
+
+    mock_hal_reset();
+    mock_hal_set_console(false);
+    if (system_init() != XST_SUCCESS) {
+        fprintf(stderr, "system_init() failed\n");
+        return 1;
+    }
+    microblaze_enable_interrupts();
+    init_IO_struct(&uIO);
+
+    // PID on with Kp = 2, then spin the knob to a setpoint
+    mock_set_inputs(BENCH_PID_SWITCHES, 0);
+    poll_ui();
+    press(BENCH_PID_SWITCHES, BENCH_BTNU);
+    press(BENCH_PID_SWITCHES, BENCH_BTNU);
+    for (u32 count = 1; count <= BENCH_ROTARY_COUNT; count++) {
+        mock_set_encoder(count, 0);
+        poll_ui();
+    }
+
+    start = wall_seconds();
+    for (long n = 0; n < steps; n++) {
+        mock_hb3_publish_period(BENCH_BASE_PERIOD + (n & 0x3FF) * 16);
+        control_pid_step();
+        sink += mock_hb3_pwm();
+    }
+    elapsed = wall_seconds() - start;
+    printf("control_pid_step: %ld steps in %.3f s, %.2f M steps/s, %.1f ns/step\n",
+           steps, elapsed, steps / elapsed / 1e6, elapsed / steps * 1e9);
+
+    // telemetry on at the full control rate, then let the tick run
+    press(BENCH_PID_SWITCHES | (7 << 7), BENCH_BTNL);
+    start = wall_seconds();
+    for (long ms = 0; ms < model_seconds * 1000; ms++) {
+        mock_hb3_publish_period(BENCH_BASE_PERIOD);
+        mock_advance_clocks(XPAR_CPU_CORE_CLOCK_FREQ_HZ / 1000);
+        poll_ui();
+    }
+    elapsed = wall_seconds() - start;
+    printf("control tick: %ld model s in %.3f s, %.1f model s per wall s\n",
+           model_seconds, elapsed, model_seconds / elapsed);
+
+    mock_hal_set_console(true);
+    ctrl_tick_report();
+    printf("Telemetry: sent %u  dropped %u\n", logger_get_sent(), logger_get_dropped());
+    return sink == 0;
+}
@@ -0,0 +1,329 @@
+/**
+ * @file plant_sim.c
+ *
+ * @authors Stephen, Drew, Noah
+ * @copyright Portland State University, 2023
+ *
+ * @brief
+ * Closed-loop run of the controller firmware against the motor model in
+ * host/plant. Brings the system up through system_init() like main.c,
+ * turns PID on, then steps the setpoint with the rotary encoder and lets
+ * the control tick, tach sample interrupt and plant run off the model
+ * clock. Prints how each setpoint settled and how many model seconds run
+ * per wall second.
+ *
+ * With -autotune the relay auto-tuner (SW14) is run first, and the steps
+ * use the gains it loads instead of Kp = 2.
+ *
+ * With -fit the model is first refit to the given logs (see
+ * motor_fit_csv()) and the steady state speeds it predicts are printed
+ * against the characterization.
+ *
+ * With -wdt it instead runs at one setpoint, takes a watchdog reset and
+ * times how long the warm restart takes to get back into regulation. The
+ * run before the reset is in a child process, so the firmware boots again
+ * from clean statics with only the warm restart store (and the motor)
+ * carried across, like BRAM over a reset.
+ *
+ * Built with STAGE_PROFILE update_pid() is profiled like the main
+ * loop and the table is printed at the end.
+ *
+ * usage: plant_sim [model seconds] [-autotune] [-wdt] [-fit log.csv ...]
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ * ---------------------
+ * Ver  Who Date    Changes
+ * -----------------------------------
+ * 1.00a DS 17-Oct-2026 First release
+ * </pre>
+************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "hal_mock.h"
+#include "motor_plant.h"
+#include "sys_init.h"
+#include "cntrl_logic.h"
+#include "rpm_lut.h"
+#include "ctrl_tick.h"
+#include "microblaze_sleep.h"
+#include "profile.h"
+#include "warm_start.h"
+
+#define SIM_MODEL_SECONDS       20
+#define SIM_PID_SWITCHES        0x0007      // Kp, Ki and Kd on
+#define SIM_BTNU                0x08
+#define SIM_UI_CLOCKS           (XPAR_CPU_CORE_CLOCK_FREQ_HZ / 100)    // main loop pass
+#define SIM_SPEED_MIN           454         // SPEED_MIN and SPEED_STEP in cntrl_logic.c
+#define SIM_SPEED_STEP          6
+#define SIM_SETTLED_SECONDS     1           // error is measured over the end of each step
+#define SIM_AUTOTUNE_SW         0x4000      // AUTOTUNE_SW in cntrl_logic.c
+#define SIM_AUTOTUNE_COUNT      10          // rotary count the tune runs at
+#define SIM_AUTOTUNE_SECONDS    30          // longer than AUTOTUNE_TIMEOUT_US
+#define SIM_AUTOTUNE_DONE       "Auto-tune: Ku"
+#define SIM_WDT_COUNT           15          // rotary count the reset is taken at
+#define SIM_WDT_RUN_SECONDS     5           // settled before the reset
+#define SIM_WDT_BOOT_CLOCKS     (XPAR_CPU_CORE_CLOCK_FREQ_HZ / 100)    // reset to main(), motor unpowered
+#define SIM_WDT_MAX_SECONDS     10          // give up on regulation after
+
+static user_io_t uIO;
+
+/** rotary counts the setpoint is stepped through, one per segment */
+static const u32 sim_counts[] = { 10, 25, 3, 15 };
+#define SIM_NUM_COUNTS  (sizeof(sim_counts) / sizeof(sim_counts[0]))
+
+/**
+ * poll_ui() - one pass of the main loop's user IO handling
+*/
+static void poll_ui(void) {
+    PROFILE_STAGE(PROF_UPDATE_PID, update_pid(&uIO));
+}
+
+/**
+ * press() - presses and releases a Nexys A7 button
+*/
+static void press(u16 switches, u8 button) {
+    mock_set_inputs(switches, button);
+    poll_ui();
+    mock_set_inputs(switches, 0);
+    poll_ui();
+}
+
+/**
+ * turn_to() - spins the rotary encoder to a count between two main loop
+ * passes, one interrupt per detent
+*/
+static void turn_to(u32 *count, u32 target) {
+    while(*count != target) {
+        *count += (target > *count) ? 1 : -1;
+        mock_set_encoder(*count, 0);
+    }
+    poll_ui();
+}
+
+/**
+ * run_autotune() - flips SW14 and runs until the tuner has loaded gains
+ *
+ * @return      model seconds it took, or -1 if it never finished
+*/
+static double run_autotune(ptr_motor_sim_t sim, u32 *count) {
+    u64 start;
+    double took = -1.0;
+
+    turn_to(count, SIM_AUTOTUNE_COUNT);
+    // let it get up to speed on the feedforward first
+    for(u32 n = 0; n < 100; n++) {
+        motor_sim_run(sim, SIM_UI_CLOCKS);
+        poll_ui();
+    }
+    mock_set_inputs(SIM_PID_SWITCHES | SIM_AUTOTUNE_SW, 0);
+    poll_ui();
+    start = mock_clocks();
+    while(mock_clocks() - start < (u64)SIM_AUTOTUNE_SECONDS * XPAR_CPU_CORE_CLOCK_FREQ_HZ) {
+        motor_sim_run(sim, SIM_UI_CLOCKS);
+        poll_ui();
+        // printed from the main loop once the gains are loaded
+        if(!strncmp(mock_console_last(), SIM_AUTOTUNE_DONE, strlen(SIM_AUTOTUNE_DONE))) {
+            printf("%s", mock_console_last());
+            took = (double)(mock_clocks() - start) / XPAR_CPU_CORE_CLOCK_FREQ_HZ;
+            break;
+        }
+    }
+    mock_set_inputs(SIM_PID_SWITCHES, 0);
+    poll_ui();
+    return took;
+}
+
+/**
+ * boot() - resets the mock board and brings the firmware up like main.c
+*/
+static int boot(void) {
+    mock_hal_reset();
+    mock_hal_set_console(false);
+    // the switches are where they were left across a reset
+    mock_set_inputs(SIM_PID_SWITCHES, 0);
+    if(system_init() != XST_SUCCESS) {
+        fprintf(stderr, "system_init() failed\n");
+        return -1;
+    }
+    init_IO_struct(&uIO);
+    microblaze_enable_interrupts();
+    return 0;
+}
+
+/**
+ * run_wdt() - runs at one setpoint, resets and times the warm restart
+*/
+static int run_wdt(ptr_motor_sim_t sim) {
+    int fds[2];
+    pid_t child;
+    u32 count = 0;
+    u8 set_rpm = rpm_lut_from_count(SIM_SPEED_MIN + SIM_WDT_COUNT * SIM_SPEED_STEP);
+
+    if(pipe(fds) != 0 || (child = fork()) < 0) {
+        perror("plant_sim");
+        return 1;
+    }
+    if(child == 0) {
+        // before the reset: PID on with Kp = 2 and settle at the setpoint
+        close(fds[0]);
+        if(boot() != 0) {
+            _exit(1);
+        }
+        poll_ui();
+        press(SIM_PID_SWITCHES, SIM_BTNU);
+        press(SIM_PID_SWITCHES, SIM_BTNU);
+        turn_to(&count, SIM_WDT_COUNT);
+        for(u64 run = 0; run < (u64)SIM_WDT_RUN_SECONDS * XPAR_CPU_CORE_CLOCK_FREQ_HZ; run += SIM_UI_CLOCKS) {
+            motor_sim_run(sim, SIM_UI_CLOCKS);
+            poll_ui();
+        }
+        if(write(fds[1], sim, sizeof(*sim)) != sizeof(*sim) ||
+           write(fds[1], warm_store, sizeof(warm_store)) != sizeof(warm_store)) {
+            _exit(1);
+        }
+        _exit(0);
+    }
+    close(fds[1]);
+    if(read(fds[0], sim, sizeof(*sim)) != sizeof(*sim) ||
+       read(fds[0], warm_store, sizeof(warm_store)) != sizeof(warm_store)) {
+        fprintf(stderr, "plant_sim: the run before the reset failed\n");
+        return 1;
+    }
+    waitpid(child, NULL, 0);
+    printf("wdt: reset at %.1f rpm, set %u rpm\n", motor_plant_rpm(&sim->plant), set_rpm);
+
+    // the reset clears myHB3ip, so the motor coasts until the firmware is back
+    mock_hal_reset();
+    motor_tach_init(&sim->tach);
+    motor_sim_run(sim, SIM_WDT_BOOT_CLOCKS);
+    printf("wdt: %.1f rpm when main() starts\n", motor_plant_rpm(&sim->plant));
+    if(boot() != 0) {
+        return 1;
+    }
+    if(!warm_start_resumed()) {
+        printf("wdt: no warm restart state, cold start\n");
+        return 1;
+    }
+    while(warm_start_regulated_us() == 0 &&
+          mock_clocks() < (u64)SIM_WDT_MAX_SECONDS * XPAR_CPU_CORE_CLOCK_FREQ_HZ) {
+        motor_sim_run(sim, SIM_UI_CLOCKS);
+        poll_ui();
+    }
+    if(warm_start_regulated_us() == 0) {
+        printf("wdt: not regulating %d s after reset\n", SIM_WDT_MAX_SECONDS);
+        return 1;
+    }
+    printf("wdt: warm restart regulating %u us after reset, %.1f rpm\n",
+           warm_start_regulated_us(), motor_plant_rpm(&sim->plant));
+    return 0;
+}
+
+static double wall_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * print_fit() - the model's steady state speeds against the characterization
+*/
+static void print_fit(const motor_params_t *p) {
+    printf("  duty  model rpm\n");
+    for(u32 duty = 40; duty <= 100; duty += 5) {
+        printf("  %3u%%  %6.1f\n", duty, motor_plant_steady_rpm(p, duty / 100.0));
+    }
+}
+
+int main(int argc, char *argv[]) {
+    long model_seconds = SIM_MODEL_SECONDS;
+    long segment_clocks;
+    motor_params_t params;
+    motor_sim_t sim;
+    u32 count = 0;
+    double start, elapsed;
+    int argi = 1;
+    bool tune = false;
+    bool wdt = false;
+
+    if(argi < argc && argv[argi][0] != '-') {
+        model_seconds = atol(argv[argi++]);
+    }
+    if(argi < argc && !strcmp(argv[argi], "-autotune")) {
+        tune = true;
+        argi++;
+    }
+    if(argi < argc && !strcmp(argv[argi], "-wdt")) {
+        wdt = true;
+        argi++;
+    }
+    motor_params_default(&params);
+    if(argi < argc && !strcmp(argv[argi], "-fit")) {
+        argi++;
+        printf("Fitting the motor model\n");
+        if(!motor_fit_csv((const char *const *)&argv[argi], argc - argi, &params, true)) {
+            fprintf(stderr, "no usable samples, keeping the defaults\n");
+            motor_params_default(&params);
+        }
+        print_fit(&params);
+    }
+
+    motor_sim_init(&sim, &params);
+    if(wdt) {
+        return run_wdt(&sim);
+    }
+    if(boot() != 0) {
+        return 1;
+    }
+
+    // PID on with Kp = 2
+    poll_ui();
+    press(SIM_PID_SWITCHES, SIM_BTNU);
+    press(SIM_PID_SWITCHES, SIM_BTNU);
+    if(tune) {
+        double took = run_autotune(&sim, &count);
+        if(took < 0.0) {
+            printf("auto-tune did not finish in %d model s\n", SIM_AUTOTUNE_SECONDS);
+        }
+        else {
+            printf("auto-tune took %.2f model s\n", took);
+        }
+    }
+
+    segment_clocks = model_seconds * XPAR_CPU_CORE_CLOCK_FREQ_HZ / SIM_NUM_COUNTS;
+    printf("count  set rpm  rpm at end  mean |error| over last %ds\n", SIM_SETTLED_SECONDS);
+    start = wall_seconds();
+    for(u32 seg = 0; seg < SIM_NUM_COUNTS; seg++) {
+        u8 set_rpm = rpm_lut_from_count(SIM_SPEED_MIN + sim_counts[seg] * SIM_SPEED_STEP);
+        double err_sum = 0.0;
+        long err_n = 0;
+
+        turn_to(&count, sim_counts[seg]);
+        for(long run = 0; run < segment_clocks; run += SIM_UI_CLOCKS) {
+            motor_sim_run(&sim, SIM_UI_CLOCKS);
+            poll_ui();
+            if(segment_clocks - run <= (long)SIM_SETTLED_SECONDS * XPAR_CPU_CORE_CLOCK_FREQ_HZ) {
+                err_sum += fabs(motor_plant_rpm(&sim.plant) - set_rpm);
+                err_n++;
+            }
+        }
+        printf("%5u  %7u  %10.1f  %6.2f\n", sim_counts[seg], set_rpm,
+               motor_plant_rpm(&sim.plant), err_n ? err_sum / err_n : 0.0);
+    }
+    elapsed = wall_seconds() - start;
+    printf("plant: %ld model s in %.3f s, %.1f model s per wall s, %llu tach edges\n",
+           model_seconds, elapsed, model_seconds / elapsed, (unsigned long long)sim.edges);
+
+    mock_hal_set_console(true);
+    ctrl_tick_report();
+#ifdef STAGE_PROFILE
+    profile_report();
+#endif
+    return 0;
+}
@@ -0,0 +1,718 @@
+/**
+ * @file hal_mock.c
+ *
+ * @authors Stephen, Drew, Noah
+ * @copyright Portland State University, 2023
+ *
+ * @brief
+ * This is the source file for the host mock of the board. See hal_mock.h.
+ * The custom IP register files behave like their AXI slaves: read-only
+ * registers ignore writes, the myHB3ip, nexys4io and PmodENC interrupt
+ * status bits are write-1-to-clear and writing the PmodENC clear bit zeroes
+ * the rotary count. The myHB3ip fabric PID steps on each published sample
+ * with the pid_fixed.h arithmetic, like pid_accel.v.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ * ---------------------
+ * Ver  Who Date    Changes
+ * -----------------------------------
+ * 1.00a DS 17-Oct-2026 First release
+ * </pre>
+************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include "hal_mock.h"
+#include "xparameters.h"
+#include "xil_io.h"
+#include "xil_printf.h"
+#include "microblaze_sleep.h"
+#include "xintc.h"
+#include "xtmrctr.h"
+#include "xwdttb.h"
+#include "xuartlite.h"
+#include "platform.h"
+#include "nexys4io.h"
+#include "PmodENC544.h"
+#include "myHB3ip.h"
+#include "pid_fixed.h"
+
+/*********Model Constants****************************/
+#define MOCK_REGS               64          // 256 byte AXI register window, myHB3ip is the largest
+#define MOCK_FIT_HZ             4           // fit_timer_0 rate, see fit.h
+#define MOCK_INTR_INPUTS        32
+#define MOCK_TIMERS             2           // axi_timer_0 (control tick), axi_timer_1 (timebase)
+#define MOCK_TX_CAPTURE         65536       // sent uart bytes kept for mock_uart_read_tx()
+#define MOCK_ENC_IRQS           (PMODENC544_IRQ_ROTARY | PMODENC544_IRQ_BTNSW)
+// rpm_calc.v constants for the default TICKS_PER_REV_X100 of 82313
+#define MOCK_RPM100_PERIOD_NUM  728924957u  // 60 * 100 MHz * 10000 / 82313
+#define MOCK_RPM100_WINDOW_Q16  477708u     // 600000 * 2^16 / 82313, rounded
+#define MOCK_RECIP_100_Q24      167772      // pid_accel.v RPM x 100 to Q16.16 rpm
+#define MOCK_PWM_MAX_DUTY       1023
+#define MOCK_PWM_DUTY_SHIFT     20          // pid_accel.v duty goes in controlReg[29:20]
+#define MOCK_PWM_FIELD_MASK     0x3FFFC000u // controlReg[29:14], left aligned duty cycle
+#define MOCK_PWM_BITS           10          // pmodhb3.v defaults
+#define MOCK_PWM_PRESCALE       99
+#define MOCK_PWM_KEPT_MASK      (((1u << MOCK_PWM_BITS) - 1) << (30 - MOCK_PWM_BITS))
+// PWM config read only fields: PWM_BITS, one channel and PID_ACCEL, the
+// fabric PID is always modelled
+#define MOCK_PWM_CFG_FIXED      ((MOCK_PWM_BITS << HB3_PWM_BITS_SHIFT) | (1 << HB3_NUM_CH_SHIFT) | HB3_CFG_PID_ACCEL)
+
+/*********Model Types****************************/
+typedef struct mock_dev mock_dev_t;
+struct mock_dev {
+    UINTPTR base;
+    u64 ro_mask;                            // registers the bus cannot write
+    u32 regs[MOCK_REGS];
+    u32 (*read)(mock_dev_t *dev, u32 idx);
+    void (*write)(mock_dev_t *dev, u32 idx, u32 value);
+};
+
+/*********Model State****************************/
+static u64 now_clocks;
+static bool console_on = true;
+static char console_last[256];              // text of the last xil_printf()
+
+// interrupt controller and CPU
+static XInterruptHandler intr_handler[MOCK_INTR_INPUTS];
+static void *intr_ref[MOCK_INTR_INPUTS];
+static u32 intr_enabled, intr_pending;
+static bool intc_started, cpu_ie;
+
+// axi_timer_0/1 by device ID, fit_timer_0, axi_timebase_wdt_0
+static XTmrCtr *timers[MOCK_TIMERS];
+static u64 fit_clocks;
+static u32 wdt_restarts;
+static bool wdt_expired;
+
+// uartlite transmitter
+static u8 tx_fifo[XUL_FIFO_SIZE];
+static u32 tx_level, tx_clocks, uart_baud = XPAR_UARTLITE_0_BAUDRATE;
+static bool uart_intr_on;
+static u8 tx_capture[MOCK_TX_CAPTURE];
+static u32 tx_cap_head, tx_cap_tail;
+
+// myHB3ip fabric PID (pid_accel.v) state that is not in a register
+static q16_t pid_prev_error, pid_correction;
+static u32 hb3_fresh;                      // HB3_LATCH_OFFSET fresh bits since the last latch
+
+static void hb3_write(mock_dev_t *dev, u32 idx, u32 value);
+static void n4io_write(mock_dev_t *dev, u32 idx, u32 value);
+static void enc_write(mock_dev_t *dev, u32 idx, u32 value);
+static u32 uart_read(mock_dev_t *dev, u32 idx);
+static u32 tmr_read(mock_dev_t *dev, u32 idx);
+static void uart_write(mock_dev_t *dev, u32 idx, u32 value);
+
+// BTNSW_IN and the input irq status are driven by the IP
+static mock_dev_t nexys4io = { XPAR_NEXYS4IO_0_S00_AXI_BASEADDR, 0x0201, {0}, NULL, n4io_write };
+// rotary count and button/switch are inputs
+static mock_dev_t pmodenc = { XPAR_PMODENC544_0_S00_AXI_BASEADDR, 0x0003, {0}, NULL, enc_write };
+// ticks, period, average, edge count, quadrature, irq status, RPM x 100
+// and the PID error, integrator and output are driven by the IP
+static mock_dev_t hb3 = { XPAR_MYHB3IP_0_S00_AXI_BASEADDR, 0x00000FFF21C01FF2ull, {0}, NULL, hb3_write };
+static mock_dev_t uartlite = { XPAR_UARTLITE_0_BASEADDR, 0x0000, {0}, uart_read, uart_write };
+// only the counter registers are readable, the driver API does the rest
+static mock_dev_t axi_timer_0 = { XPAR_TMRCTR_0_BASEADDR, 0xFFFF, {0}, tmr_read, NULL };
+static mock_dev_t axi_timer_1 = { XPAR_TMRCTR_1_BASEADDR, 0xFFFF, {0}, tmr_read, NULL };
+static mock_dev_t *const devices[] = { &nexys4io, &pmodenc, &hb3, &uartlite, &axi_timer_0, &axi_timer_1 };
+
+/**
+ * find_dev() - decodes an address to a device and register index
+*/
+static mock_dev_t *find_dev(UINTPTR addr, u32 *idx) {
+    for (u32 n = 0; n < sizeof(devices) / sizeof(devices[0]); n++) {
+        if (addr >= devices[n]->base && addr < devices[n]->base + MOCK_REGS * 4) {
+            *idx = (addr - devices[n]->base) >> 2;
+            return devices[n];
+        }
+    }
+    fprintf(stderr, "hal_mock: no device at 0x%08lx\n", (unsigned long)addr);
+    abort();
+}
+
+/**
+ * deliver_interrupts() - runs pending handlers the way the MicroBlaze would,
+ * one at a time with interrupts off
+*/
+static void deliver_interrupts(void) {
+    u32 ready;
+
+    while (intc_started && cpu_ie && (ready = intr_pending & intr_enabled) != 0) {
+        u8 id = __builtin_ctz(ready);
+        intr_pending &= ~(1u << id);
+        if (intr_handler[id] == NULL) {
+            continue;
+        }
+        cpu_ie = false;
+        intr_handler[id](intr_ref[id]);
+        cpu_ie = true;
+    }
+}
+
+/********************Register Model********************/
+u32 Xil_In32(UINTPTR Addr) {
+    u32 idx;
+    mock_dev_t *dev = find_dev(Addr, &idx);
+    return dev->read ? dev->read(dev, idx) : dev->regs[idx];
+}
+
+void Xil_Out32(UINTPTR Addr, u32 Value) {
+    u32 idx;
+    mock_dev_t *dev = find_dev(Addr, &idx);
+
+    if (dev->write) {
+        dev->write(dev, idx, Value);
+    }
+    else if (!(dev->ro_mask & (1ull << idx))) {
+        dev->regs[idx] = Value;
+    }
+}
+
+u32 mock_reg_peek(UINTPTR addr) {
+    u32 idx;
+    return find_dev(addr, &idx)->regs[idx];
+}
+
+void mock_reg_poke(UINTPTR addr, u32 value) {
+    u32 idx;
+    find_dev(addr, &idx)->regs[idx] = value;
+}
+
+/**
+ * hb3_pid_duty() - the fabric PID PWM count, recomputed every clock in
+ * pid_accel.v so it follows the feedforward and slope registers at once
+*/
+static void hb3_pid_duty(void) {
+    u32 *regs = hb3.regs;
+    int64_t corr = ((int64_t)pid_correction * (q16_t)regs[HB3_PID_SLOPE_OFFSET / 4]) >> 32;
+    int64_t duty = (int64_t)(q16_t)regs[HB3_PID_FF_OFFSET / 4] + corr;
+
+    regs[HB3_PID_OUTPUT_OFFSET / 4] = (duty < 0) ? 0 : ((duty > MOCK_PWM_MAX_DUTY) ? MOCK_PWM_MAX_DUTY : (u32)duty);
+}
+
+/**
+ * hb3_pid_step() - one pid_accel.v step on a new RPM x 100, the same
+ * math as pid_fixed_step() with the error taken from RPM x 100
+*/
+static void hb3_pid_step(u32 rpm100) {
+    u32 *regs = hb3.regs;
+    int64_t diff = (int64_t)regs[HB3_PID_SETPOINT_OFFSET / 4] - rpm100;
+    int64_t scaled = (diff * MOCK_RECIP_100_Q24) >> 8;
+    q16_t error = (scaled > Q16_MAX) ? Q16_MAX : ((scaled < Q16_MIN) ? Q16_MIN : (q16_t)scaled);
+    q16_t i_limit = regs[HB3_PID_I_LIMIT_OFFSET / 4];
+    q16_t out_limit = regs[HB3_PID_OUT_LIMIT_OFFSET / 4];
+    q16_t integrator = regs[HB3_PID_INTEGRATOR_OFFSET / 4];
+    q16_t out = q16_sat_mul(regs[HB3_PID_KP_OFFSET / 4], error);
+
+    integrator = q16_clamp(q16_sat_add(integrator, q16_sat_mul(regs[HB3_PID_KI_OFFSET / 4], error)),
+                           -i_limit, i_limit);
+    out = q16_sat_add(out, integrator);
+    out = q16_sat_add(out, q16_sat_mul(regs[HB3_PID_KD_OFFSET / 4], q16_sat_sub(error, pid_prev_error)));
+    pid_prev_error = error;
+    pid_correction = q16_clamp(out, -out_limit, out_limit);
+    regs[HB3_PID_ERROR_OFFSET / 4] = error;
+    regs[HB3_PID_INTEGRATOR_OFFSET / 4] = integrator;
+    hb3_pid_duty();
+}
+
+static void hb3_write(mock_dev_t *dev, u32 idx, u32 value) {
+    if (idx == HB3_IRQ_STATUS_OFFSET / 4) {
+        dev->regs[idx] &= ~value;
+    }
+    else if (!(dev->ro_mask & (1ull << idx))) {
+        dev->regs[idx] = value;
+    }
+    if (idx == HB3_PWM_CFG_OFFSET / 4) {
+        // PWM_BITS, NUM_CHANNELS and PID_ACCEL are IP parameters
+        dev->regs[idx] = (value & HB3_PWM_PRESCALE_MASK) | MOCK_PWM_CFG_FIXED;
+    }
+    if (idx == HB3_LATCH_OFFSET / 4) {
+        // one channel, the others read 0 like an IP built with NUM_CHANNELS 1
+        dev->regs[HB3_SNAP_RPM100_PERIOD_OFFSET / 4] = dev->regs[HB3_RPM100_PERIOD_OFFSET / 4];
+        dev->regs[HB3_SNAP_RPM100_WINDOW_OFFSET / 4] = dev->regs[HB3_RPM100_WINDOW_OFFSET / 4];
+        dev->regs[HB3_SNAP_EDGE_COUNT_OFFSET / 4] = dev->regs[HB3_EDGE_COUNT_OFFSET / 4];
+        dev->regs[idx] = (((dev->regs[idx] >> HB3_LATCH_SEQ_SHIFT) + 1) << HB3_LATCH_SEQ_SHIFT) | hb3_fresh;
+        hb3_fresh = 0;
+    }
+    if (idx == HB3_PID_CTRL_OFFSET / 4 && !(value & HB3_PID_FABRIC)) {
+        // pid_accel.v holds its state at 0 while it is off
+        pid_prev_error = pid_correction = 0;
+        dev->regs[HB3_PID_ERROR_OFFSET / 4] = 0;
+        dev->regs[HB3_PID_INTEGRATOR_OFFSET / 4] = 0;
+    }
+    hb3_pid_duty();
+}
+
+static void n4io_write(mock_dev_t *dev, u32 idx, u32 value) {
+    if (idx == NEXYS4IO_IRQ_STATUS_OFFSET / 4) {
+        dev->regs[idx] &= ~value;
+    }
+    else if (!(dev->ro_mask & (1ull << idx))) {
+        dev->regs[idx] = value;
+    }
+}
+
+static void enc_write(mock_dev_t *dev, u32 idx, u32 value) {
+    if (idx == PMODENC544_CLR_ROTARY_COUNT_REG_OFFSET / 4 && (value & 1)) {
+        dev->regs[PMODENC544_ROTARY_COUNT_REG_OFFSET / 4] = 0;
+    }
+    if (idx == PMODENC544_BTNSWT_REG_OFFSET / 4) {
+        dev->regs[idx] &= ~(value & (MOCK_ENC_IRQS << PMODENC544_IRQ_SHIFT));
+    }
+    else if (!(dev->ro_mask & (1ull << idx))) {
+        dev->regs[idx] = value;
+    }
+}
+
+static u32 uart_read(mock_dev_t *dev, u32 idx) {
+    if (idx == XUL_STATUS_REG_OFFSET / 4) {
+        return (tx_level == 0 ? XUL_SR_TX_FIFO_EMPTY : 0) |
+               (tx_level >= XUL_FIFO_SIZE ? XUL_SR_TX_FIFO_FULL : 0) |
+               (uart_intr_on ? XUL_SR_INTR_ENABLED : 0);
+    }
+    return 0;       // nothing is ever received
+}
+
+static u32 tmr_read(mock_dev_t *dev, u32 idx) {
+    XTmrCtr *timer = timers[(dev == &axi_timer_1) ? XPAR_TMRCTR_1_DEVICE_ID : XPAR_TMRCTR_0_DEVICE_ID];
+    u32 n = idx / (XTC_TIMER_COUNTER_OFFSET / 4);
+
+    if (timer != NULL && n < XTC_DEVICE_TIMER_COUNT
+        && idx % (XTC_TIMER_COUNTER_OFFSET / 4) == XTC_TCR_OFFSET / 4) {
+        return timer->Value[n];
+    }
+    return 0;
+}
+
+static void uart_write(mock_dev_t *dev, u32 idx, u32 value) {
+    if (idx == XUL_TX_FIFO_OFFSET / 4) {
+        if (tx_level < XUL_FIFO_SIZE) {
+            tx_fifo[tx_level++] = value;
+        }
+    }
+    else if (idx == XUL_CONTROL_REG_OFFSET / 4) {
+        if (value & XUL_CR_FIFO_TX_RESET) {
+            tx_level = 0;
+            tx_clocks = 0;
+        }
+        uart_intr_on = (value & XUL_CR_ENABLE_INTR) != 0;
+    }
+}
+
+/********************Model Clock********************/
+/**
+ * timer_clocks_to_event() - clocks until timer n rolls over, 0 if stopped
+ * or if it is the upper half of a cascade, which counts carries instead
+*/
+static u64 timer_clocks_to_event(XTmrCtr *timer, u8 n) {
+    if (timer == NULL || !timer->Running[n] || (n == 1 && (timer->Options[0] & XTC_CASCADE_MODE_OPTION))) {
+        return 0;
+    }
+    if (timer->Options[n] & XTC_DOWN_COUNT_OPTION) {
+        return (u64)timer->Value[n] + 1;
+    }
+    return (u64)UINT32_MAX - timer->Value[n] + 1;
+}
+
+static u64 min_event(u64 step, u64 to_event) {
+    return (to_event != 0 && to_event < step) ? to_event : step;
+}
+
+void mock_advance_clocks(u64 clocks) {
+    const u64 fit_period = XPAR_CPU_CORE_CLOCK_FREQ_HZ / MOCK_FIT_HZ;
+    const u64 byte_clocks = (u64)XPAR_CPU_CORE_CLOCK_FREQ_HZ * 10 / uart_baud;
+
+    deliver_interrupts();
+    while (clocks > 0) {
+        // run up to the next thing that happens
+        u64 step = clocks;
+        for (u8 t = 0; t < MOCK_TIMERS; t++) {
+            for (u8 n = 0; n < XTC_DEVICE_TIMER_COUNT; n++) {
+                step = min_event(step, timer_clocks_to_event(timers[t], n));
+            }
+        }
+        step = min_event(step, fit_period - fit_clocks);
+        if (tx_level > 0) {
+            step = min_event(step, byte_clocks - tx_clocks);
+        }
+        now_clocks += step;
+        clocks -= step;
+
+        for (u8 t = 0; t < MOCK_TIMERS; t++) {
+            XTmrCtr *timer = timers[t];
+            for (u8 n = 0; n < XTC_DEVICE_TIMER_COUNT; n++) {
+                u64 to_event = timer_clocks_to_event(timer, n);
+                if (to_event == 0) {
+                    continue;
+                }
+                if (step < to_event) {
+                    timer->Value[n] += (timer->Options[n] & XTC_DOWN_COUNT_OPTION) ? -(u32)step : (u32)step;
+                    continue;
+                }
+                if (n == 0 && (timer->Options[0] & XTC_CASCADE_MODE_OPTION)) {
+                    // the carry into the upper half
+                    timer->Value[0] = 0;
+                    timer->Value[1]++;
+                    continue;
+                }
+                timer->Expired[n] = true;
+                if (timer->Options[n] & XTC_AUTO_RELOAD_OPTION) {
+                    timer->Value[n] = timer->ResetValue[n];
+                }
+                else {
+                    timer->Running[n] = false;
+                }
+                // only axi_timer_0 has its interrupt connected
+                if ((timer->Options[n] & XTC_INT_MODE_OPTION) && t == XPAR_TMRCTR_0_DEVICE_ID) {
+                    intr_pending |= 1u << XPAR_MICROBLAZE_0_AXI_INTC_AXI_TIMER_0_INTERRUPT_INTR;
+                }
+            }
+        }
+
+        fit_clocks += step;
+        if (fit_clocks >= fit_period) {
+            fit_clocks = 0;
+            intr_pending |= 1u << XPAR_MICROBLAZE_0_AXI_INTC_FIT_TIMER_0_INTERRUPT_INTR;
+        }
+
+        if (tx_level > 0) {
+            tx_clocks += step;
+            if (tx_clocks >= byte_clocks) {
+                tx_clocks = 0;
+                if (((tx_cap_head + 1) % MOCK_TX_CAPTURE) != tx_cap_tail) {
+                    tx_capture[tx_cap_head] = tx_fifo[0];
+                    tx_cap_head = (tx_cap_head + 1) % MOCK_TX_CAPTURE;
+                }
+                memmove(tx_fifo, tx_fifo + 1, --tx_level);
+                if (tx_level == 0 && uart_intr_on) {
+                    intr_pending |= 1u << XPAR_MICROBLAZE_0_AXI_INTC_AXI_UARTLITE_0_INTERRUPT_INTR;
+                }
+            }
+        }
+        deliver_interrupts();
+    }
+}
+
+u64 mock_clocks(void) {
+    return now_clocks;
+}
+
+/********************Hardware Side********************/
+void mock_hal_reset(void) {
+    for (u32 n = 0; n < sizeof(devices) / sizeof(devices[0]); n++) {
+        memset(devices[n]->regs, 0, sizeof(devices[n]->regs));
+    }
+    hb3.regs[HB3_PWM_CFG_OFFSET / 4] = MOCK_PWM_PRESCALE | MOCK_PWM_CFG_FIXED;
+    hb3_fresh = 0;
+    memset(intr_handler, 0, sizeof(intr_handler));
+    intr_enabled = intr_pending = 0;
+    intc_started = cpu_ie = false;
+    memset(timers, 0, sizeof(timers));
+    now_clocks = fit_clocks = 0;
+    wdt_restarts = 0;
+    wdt_expired = false;
+    tx_level = tx_clocks = tx_cap_head = tx_cap_tail = 0;
+    uart_intr_on = false;
+}
+
+void mock_hal_set_console(bool on) {
+    console_on = on;
+}
+
+void mock_raise_interrupt(u8 id) {
+    intr_pending |= 1u << id;
+    deliver_interrupts();
+}
+
+void mock_set_inputs(u16 switches, u8 buttons) {
+    u32 btnsw = ((u32)(buttons & 0x1F) << 16) | switches;
+
+    if (btnsw == nexys4io.regs[NEXYS4IO_BTNSW_IN_OFFSET / 4]) {
+        return;
+    }
+    nexys4io.regs[NEXYS4IO_BTNSW_IN_OFFSET / 4] = btnsw;
+    nexys4io.regs[NEXYS4IO_IRQ_STATUS_OFFSET / 4] |= NEXYS4IO_IRQ_INPUT_MASK;
+    if (nexys4io.regs[NEXYS4IO_IRQ_ENABLE_OFFSET / 4] & NEXYS4IO_IRQ_INPUT_MASK) {
+        mock_raise_interrupt(XPAR_MICROBLAZE_0_AXI_INTC_NEXYS4IO_0_INPUT_IRQ_INTR);
+    }
+}
+
+void mock_set_encoder(u32 rotary_count, u32 btn_sw) {
+    u32 *count = &pmodenc.regs[PMODENC544_ROTARY_COUNT_REG_OFFSET / 4];
+    u32 *reg = &pmodenc.regs[PMODENC544_BTNSWT_REG_OFFSET / 4];
+    u32 status = (*reg >> PMODENC544_IRQ_SHIFT) & MOCK_ENC_IRQS;
+
+    // one count is one detent, the IP latches the rotary source per detent
+    if (rotary_count != *count) {
+        status |= PMODENC544_IRQ_ROTARY;
+    }
+    if ((btn_sw & PMODENC544_BTNSW_MASK) != (*reg & PMODENC544_BTNSW_MASK)) {
+        status |= PMODENC544_IRQ_BTNSW;
+    }
+    *count = rotary_count;
+    *reg = (status << PMODENC544_IRQ_SHIFT) | (btn_sw & PMODENC544_BTNSW_MASK);
+    if (status & (pmodenc.regs[PMODENC544_CLR_ROTARY_COUNT_REG_OFFSET / 4] >> PMODENC544_IRQ_SHIFT)) {
+        mock_raise_interrupt(XPAR_MICROBLAZE_0_AXI_INTC_PMODENC544_0_ENC_IRQ_INTR);
+    }
+}
+
+/**
+ * hb3_sample() - latches a sample strobe and raises sample_irq if enabled
+*/
+static void hb3_sample(u32 mask) {
+    hb3.regs[HB3_IRQ_STATUS_OFFSET / 4] |= mask;
+    hb3_fresh |= ((mask & HB3_IRQ_PERIOD) ? 1 << HB3_LATCH_FRESH_PERIOD_SHIFT : 0) |
+                 ((mask & HB3_IRQ_WINDOW) ? 1 << HB3_LATCH_FRESH_WINDOW_SHIFT : 0);
+    if (hb3.regs[HB3_IRQ_STATUS_OFFSET / 4] & hb3.regs[HB3_IRQ_ENABLE_OFFSET / 4]) {
+        mock_raise_interrupt(XPAR_MICROBLAZE_0_AXI_INTC_MYHB3IP_0_SAMPLE_IRQ_INTR);
+    }
+}
+
+void mock_hb3_publish_period(u32 period_clocks) {
+    hb3.regs[HB3_PERIOD_OFFSET / 4] = period_clocks;
+    hb3.regs[HB3_PERIOD_AVG_OFFSET / 4] = period_clocks;
+    if (period_clocks != 0) {
+        hb3.regs[HB3_EDGE_COUNT_OFFSET / 4]++;
+    }
+    hb3.regs[HB3_RPM100_PERIOD_OFFSET / 4] = period_clocks ? MOCK_RPM100_PERIOD_NUM / period_clocks : 0;
+    if ((hb3.regs[HB3_PID_CTRL_OFFSET / 4] & (HB3_PID_FABRIC | HB3_PID_SRC_PERIOD)) ==
+        (HB3_PID_FABRIC | HB3_PID_SRC_PERIOD)) {
+        hb3_pid_step(hb3.regs[HB3_RPM100_PERIOD_OFFSET / 4]);
+    }
+    hb3_sample(HB3_IRQ_PERIOD);
+}
+
+void mock_hb3_publish_ticks(u32 ticks) {
+    hb3.regs[HB3_TICKS_OFFSET / 4] = ticks;
+    hb3.regs[HB3_RPM100_WINDOW_OFFSET / 4] = (u32)(((u64)ticks * MOCK_RPM100_WINDOW_Q16) >> 16);
+    if ((hb3.regs[HB3_PID_CTRL_OFFSET / 4] & (HB3_PID_FABRIC | HB3_PID_SRC_PERIOD)) == HB3_PID_FABRIC) {
+        hb3_pid_step(hb3.regs[HB3_RPM100_WINDOW_OFFSET / 4]);
+    }
+    hb3_sample(HB3_IRQ_WINDOW);
+}
+
+u32 mock_hb3_pwm(void) {
+    u32 reg = hb3.regs[HB3_PWM_OFFSET / 4];
+
+    if (hb3.regs[HB3_PID_CTRL_OFFSET / 4] & HB3_PID_FABRIC) {
+        reg = (reg & ~MOCK_PWM_FIELD_MASK) | (hb3.regs[HB3_PID_OUTPUT_OFFSET / 4] << MOCK_PWM_DUTY_SHIFT);
+    }
+    // pmodhb3.v only keeps the top PWM_BITS of the duty cycle
+    return reg & ~(MOCK_PWM_FIELD_MASK & ~MOCK_PWM_KEPT_MASK);
+}
+
+void mock_uart_set_baud(u32 baud) {
+    uart_baud = baud;
+}
+
+u32 mock_uart_read_tx(u8 *buf, u32 max) {
+    u32 n = 0;
+
+    while (n < max && tx_cap_tail != tx_cap_head) {
+        buf[n++] = tx_capture[tx_cap_tail];
+        tx_cap_tail = (tx_cap_tail + 1) % MOCK_TX_CAPTURE;
+    }
+    return n;
+}
+
+u32 mock_wdt_restarts(void) {
+    return wdt_restarts;
+}
+
+void mock_wdt_expire(void) {
+    wdt_expired = true;
+}
+
+/********************BSP Stand-ins********************/
+void xil_printf(const char *ctrl1, ...) {
+    va_list args;
+
+    va_start(args, ctrl1);
+    vsnprintf(console_last, sizeof(console_last), ctrl1, args);
+    va_end(args);
+    if (console_on) {
+        fputs(console_last, stdout);
+    }
+}
+
+const char *mock_console_last(void) {
+    return console_last;
+}
+
+void init_platform() {
+}
+
+void cleanup_platform() {
+}
+
+void microblaze_enable_interrupts(void) {
+    cpu_ie = true;
+    deliver_interrupts();
+}
+
+void microblaze_disable_interrupts(void) {
+    cpu_ie = false;
+}
+
+/********************XIntc********************/
+int XIntc_Initialize(XIntc *InstancePtr, u16 DeviceId) {
+    InstancePtr->IsReady = XIL_COMPONENT_IS_READY;
+    InstancePtr->IsStarted = 0;
+    return XST_SUCCESS;
+}
+
+int XIntc_Connect(XIntc *InstancePtr, u8 Id, XInterruptHandler Handler, void *CallBackRef) {
+    if (Id >= MOCK_INTR_INPUTS) {
+        return XST_FAILURE;
+    }
+    intr_handler[Id] = Handler;
+    intr_ref[Id] = CallBackRef;
+    return XST_SUCCESS;
+}
+
+int XIntc_Start(XIntc *InstancePtr, u8 Mode) {
+    InstancePtr->IsStarted = XIL_COMPONENT_IS_READY;
+    intc_started = true;
+    return XST_SUCCESS;
+}
+
+void XIntc_Enable(XIntc *InstancePtr, u8 Id) {
+    intr_enabled |= 1u << Id;
+    deliver_interrupts();
+}
+
+void XIntc_Disable(XIntc *InstancePtr, u8 Id) {
+    intr_enabled &= ~(1u << Id);
+}
+
+/********************XTmrCtr********************/
+int XTmrCtr_Initialize(XTmrCtr *InstancePtr, u16 DeviceId) {
+    memset(InstancePtr, 0, sizeof(*InstancePtr));
+    InstancePtr->IsReady = XIL_COMPONENT_IS_READY;
+    timers[DeviceId] = InstancePtr;
+    return XST_SUCCESS;
+}
+
+void XTmrCtr_InterruptHandler(void *InstancePtr) {
+    XTmrCtr *tmr = (XTmrCtr *)InstancePtr;
+
+    for (u8 n = 0; n < XTC_DEVICE_TIMER_COUNT; n++) {
+        if (tmr->Expired[n] && (tmr->Options[n] & XTC_INT_MODE_OPTION)) {
+            if (tmr->Handler) {
+                tmr->Handler(tmr->CallBackRef, n);
+            }
+            // acked after the callback like the real driver, so the
+            // handler still sees IsExpired()
+            tmr->Expired[n] = false;
+        }
+    }
+}
+
+void XTmrCtr_SetHandler(XTmrCtr *InstancePtr, XTmrCtr_Handler FuncPtr, void *CallBackRef) {
+    InstancePtr->Handler = FuncPtr;
+    InstancePtr->CallBackRef = CallBackRef;
+}
+
+void XTmrCtr_SetOptions(XTmrCtr *InstancePtr, u8 TmrCtrNumber, u32 Options) {
+    InstancePtr->Options[TmrCtrNumber] = Options;
+}
+
+u32 XTmrCtr_GetOptions(XTmrCtr *InstancePtr, u8 TmrCtrNumber) {
+    return InstancePtr->Options[TmrCtrNumber];
+}
+
+void XTmrCtr_SetResetValue(XTmrCtr *InstancePtr, u8 TmrCtrNumber, u32 ResetValue) {
+    InstancePtr->ResetValue[TmrCtrNumber] = ResetValue;
+}
+
+void XTmrCtr_Start(XTmrCtr *InstancePtr, u8 TmrCtrNumber) {
+    InstancePtr->Value[TmrCtrNumber] = InstancePtr->ResetValue[TmrCtrNumber];
+    InstancePtr->Running[TmrCtrNumber] = true;
+    if (TmrCtrNumber == 0 && (InstancePtr->Options[0] & XTC_CASCADE_MODE_OPTION)) {
+        // like the driver, starting timer 0 of a cascade loads and starts both
+        InstancePtr->Value[1] = InstancePtr->ResetValue[1];
+        InstancePtr->Running[1] = true;
+    }
+}
+
+void XTmrCtr_Stop(XTmrCtr *InstancePtr, u8 TmrCtrNumber) {
+    InstancePtr->Running[TmrCtrNumber] = false;
+}
+
+void XTmrCtr_Reset(XTmrCtr *InstancePtr, u8 TmrCtrNumber) {
+    InstancePtr->Value[TmrCtrNumber] = InstancePtr->ResetValue[TmrCtrNumber];
+}
+
+u32 XTmrCtr_GetValue(XTmrCtr *InstancePtr, u8 TmrCtrNumber) {
+    return InstancePtr->Value[TmrCtrNumber];
+}
+
+int XTmrCtr_IsExpired(XTmrCtr *InstancePtr, u8 TmrCtrNumber) {
+    return InstancePtr->Expired[TmrCtrNumber];
+}
+
+/********************XWdtTb********************/
+int XWdtTb_Initialize(XWdtTb *InstancePtr, u16 DeviceId) {
+    InstancePtr->IsReady = XIL_COMPONENT_IS_READY;
+    InstancePtr->IsStarted = false;
+    return XST_SUCCESS;
+}
+
+int XWdtTb_SelfTest(XWdtTb *InstancePtr) {
+    return XST_SUCCESS;
+}
+
+void XWdtTb_Start(XWdtTb *InstancePtr) {
+    InstancePtr->IsStarted = true;
+}
+
+int XWdtTb_Stop(XWdtTb *InstancePtr) {
+    InstancePtr->IsStarted = false;
+    return XST_SUCCESS;
+}
+
+void XWdtTb_RestartWdt(XWdtTb *InstancePtr) {
+    wdt_restarts++;
+    wdt_expired = false;
+}
+
+bool XWdtTb_IsWdtExpired(XWdtTb *InstancePtr) {
+    return wdt_expired;
+}
+
+u32 XWdtTb_GetTbValue(XWdtTb *InstancePtr) {
+    return (u32)now_clocks;
+}
+
+/********************XUartLite********************/
+int XUartLite_Initialize(XUartLite *InstancePtr, u16 DeviceId) {
+    InstancePtr->RegBaseAddress = XPAR_UARTLITE_0_BASEADDR;
+    InstancePtr->IsReady = XIL_COMPONENT_IS_READY;
+    return XST_SUCCESS;
+}
+
+int XUartLite_SelfTest(XUartLite *InstancePtr) {
+    XUartLite_ResetFifos(InstancePtr);
+    return XST_SUCCESS;
+}
+
+unsigned int XUartLite_Send(XUartLite *InstancePtr, u8 *DataBufferPtr, unsigned int NumBytes) {
+    unsigned int sent = 0;
+
+    while (sent < NumBytes && tx_level < XUL_FIFO_SIZE) {
+        tx_fifo[tx_level++] = DataBufferPtr[sent++];
+    }
+    return sent;
+}
+
+int XUartLite_IsSending(XUartLite *InstancePtr) {
+    return tx_level != 0;
+}
+
+void XUartLite_ResetFifos(XUartLite *InstancePtr) {
+    tx_level = 0;
+    tx_clocks = 0;
+}
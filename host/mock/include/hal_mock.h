@@ -0,0 +1,141 @@
+/**
+ * @file hal_mock.h
+ *
+ * @authors Stephen, Drew, Noah
+ * @copyright Portland State University, 2023
+ *
+ * @brief
+ * This is the header file for the host mock of the board. The nexys4io,
+ * PmodENC544 and myHB3ip drivers are built unchanged and talk to an
+ * in-memory copy of their AXI registers; the uartlite registers are
+ * modelled the same way. XIntc, XTmrCtr and XWdtTb are mocked at the
+ * driver API. Everything runs off one model clock that only moves when
+ * mock_advance_clocks() is called, so runs are repeatable.
+ *
+ * The mock_* calls below are the "hardware side": they set inputs,
+ * publish tach samples and read back what the firmware drove.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ * ---------------------
+ * Ver  Who Date    Changes
+ * -----------------------------------
+ * 1.00a DS 17-Oct-2026 First release
+ * </pre>
+************************************************************/
+
+#ifndef HAL_MOCK_H
+#define HAL_MOCK_H
+
+#include <stdbool.h>
+#include "xil_types.h"
+
+/**
+ * mock_hal_reset() - clears every register, timer, interrupt and the clock
+*/
+void mock_hal_reset(void);
+
+/**
+ * mock_hal_set_console() - turns xil_printf output on or off (default on)
+*/
+void mock_hal_set_console(bool on);
+
+/**
+ * mock_console_last() - text of the last xil_printf(), kept with the
+ * console off too, so a run can wait for something the firmware prints
+*/
+const char *mock_console_last(void);
+
+/**
+ * mock_reg_peek()/mock_reg_poke() - reads or writes a modelled register
+ * without any of the bus side effects (write-1-to-clear, read-only regs)
+ *
+ * @param       addr        base address + register offset
+*/
+u32 mock_reg_peek(UINTPTR addr);
+void mock_reg_poke(UINTPTR addr, u32 value);
+
+/**
+ * mock_advance_clocks() - moves the model clock forward
+ *
+ * @brief       Runs the AXI timer, FIT and uartlite transmitter and raises
+ *              their interrupts as they come due, in clock order.
+ *
+ * @param       clocks      AXI clocks (XPAR_CPU_CORE_CLOCK_FREQ_HZ) to run
+*/
+void mock_advance_clocks(u64 clocks);
+
+/**
+ * mock_clocks() - model time in AXI clocks since mock_hal_reset()
+*/
+u64 mock_clocks(void);
+
+/**
+ * mock_raise_interrupt() - signals an interrupt controller input
+ *
+ * @brief       The handler runs now if it is connected, enabled and the
+ *              CPU has interrupts on, otherwise it stays pending until it is.
+*/
+void mock_raise_interrupt(u8 id);
+
+/**
+ * mock_set_inputs() - sets the Nexys A7 switches and buttons
+ *
+ * @brief       A change raises the nexys4io input interrupt if enabled.
+ *
+ * @param       switches    SW[15:0]
+ * @param       buttons     BTNR, BTNL, BTND, BTNU, BTNC in bits 0-4
+*/
+void mock_set_inputs(u16 switches, u8 buttons);
+
+/**
+ * mock_set_encoder() - sets the PmodENC rotary count and button/switch bits
+ *
+ * @brief       A change raises the PmodENC interrupt if enabled. Step the
+ *              count one detent per call, like the knob does.
+*/
+void mock_set_encoder(u32 rotary_count, u32 btn_sw);
+
+/**
+ * mock_hb3_publish_period() - the tach saw an edge, period in AXI clocks
+ *
+ * @brief       Updates the period, average, edge count and RPM x 100
+ *              registers the way rpm_calc.v does and raises the period
+ *              sample interrupt if the firmware enabled it. A period of 0
+ *              is a stalled motor.
+*/
+void mock_hb3_publish_period(u32 period_clocks);
+
+/**
+ * mock_hb3_publish_ticks() - the 0.25s tick window closed with this count,
+ * also sets the window RPM x 100 register
+*/
+void mock_hb3_publish_ticks(u32 ticks);
+
+/**
+ * mock_hb3_pwm() - PWM control register pmodhb3 sees, the last one the
+ * firmware wrote with the fabric PID duty cycle in place when it is on,
+ * and the duty cycle cut to the PWM_BITS pmodhb3 keeps
+*/
+u32 mock_hb3_pwm(void);
+
+/**
+ * mock_uart_set_baud() - uartlite line rate used to drain the TX FIFO
+*/
+void mock_uart_set_baud(u32 baud);
+
+/**
+ * mock_uart_read_tx() - takes bytes the uartlite has finished sending
+ *
+ * @return      number of bytes copied into buf
+*/
+u32 mock_uart_read_tx(u8 *buf, u32 max);
+
+/**
+ * mock_wdt_restarts()/mock_wdt_expire() - watchdog restarts seen, and
+ * forces XWdtTb_IsWdtExpired() true until the next restart
+*/
+u32 mock_wdt_restarts(void);
+void mock_wdt_expire(void);
+
+#endif
@@ -0,0 +1,28 @@
+/**
+ * @file microblaze_sleep.h
+ *
+ * @authors Stephen, Drew, Noah
+ * @copyright Portland State University, 2023
+ *
+ * @brief
+ * Host build stand-in for microblaze_sleep.h and the MicroBlaze interrupt
+ * enable, which gates mock_raise_interrupt().
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ * ---------------------
+ * Ver  Who Date    Changes
+ * -----------------------------------
+ * 1.00a DS 17-Oct-2026 First release
+ * </pre>
+************************************************************/
+
+#ifndef MICROBLAZE_SLEEP_H
+#define MICROBLAZE_SLEEP_H
+
+#include "xil_types.h"
+
+void microblaze_enable_interrupts(void);
+void microblaze_disable_interrupts(void);
+
+#endif
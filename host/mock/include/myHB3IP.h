@@ -0,0 +1,20 @@
+/**
+ * @file myHB3IP.h
+ *
+ * @authors Stephen, Drew, Noah
+ * @copyright Portland State University, 2023
+ *
+ * @brief
+ * cntrl_logic.h includes the myHB3ip driver as myHB3IP.h, which only
+ * resolves on a case-insensitive file system. Forwards to the real header.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ * ---------------------
+ * Ver  Who Date    Changes
+ * -----------------------------------
+ * 1.00a DS 17-Oct-2026 First release
+ * </pre>
+************************************************************/
+
+#include "myHB3ip.h"
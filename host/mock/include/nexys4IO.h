@@ -0,0 +1,20 @@
+/**
+ * @file nexys4IO.h
+ *
+ * @authors Stephen, Drew, Noah
+ * @copyright Portland State University, 2023
+ *
+ * @brief
+ * The nexys4io driver includes itself as nexys4IO.h, which only resolves
+ * on a case-insensitive file system. Forwards to the real header.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ * ---------------------
+ * Ver  Who Date    Changes
+ * -----------------------------------
+ * 1.00a DS 17-Oct-2026 First release
+ * </pre>
+************************************************************/
+
+#include "nexys4io.h"
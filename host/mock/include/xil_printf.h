@@ -0,0 +1,25 @@
+/**
+ * @file xil_printf.h
+ *
+ * @authors Stephen, Drew, Noah
+ * @copyright Portland State University, 2023
+ *
+ * @brief
+ * Host build stand-in for the BSP xil_printf.h. Prints to stdout unless
+ * mock_hal_set_console() turned it off.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ * ---------------------
+ * Ver  Who Date    Changes
+ * -----------------------------------
+ * 1.00a DS 17-Oct-2026 First release
+ * </pre>
+************************************************************/
+
+#ifndef XIL_PRINTF_H
+#define XIL_PRINTF_H
+
+void xil_printf(const char *ctrl1, ...);
+
+#endif
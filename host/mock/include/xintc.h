@@ -0,0 +1,43 @@
+/**
+ * @file xintc.h
+ *
+ * @authors Stephen, Drew, Noah
+ * @copyright Portland State University, 2023
+ *
+ * @brief
+ * Host build stand-in for the XIntc driver. Handlers are called from
+ * mock_raise_interrupt() with the model's interrupt enable cleared, the
+ * way the MicroBlaze enters an interrupt.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ * ---------------------
+ * Ver  Who Date    Changes
+ * -----------------------------------
+ * 1.00a DS 17-Oct-2026 First release
+ * </pre>
+************************************************************/
+
+#ifndef XINTC_H
+#define XINTC_H
+
+#include "xparameters.h"
+#include "xstatus.h"
+
+#define XIN_SIMULATION_MODE 0
+#define XIN_REAL_MODE 1
+
+typedef void (*XInterruptHandler)(void *InstancePtr);
+
+typedef struct {
+    u32 IsReady;
+    u32 IsStarted;
+} XIntc;
+
+int XIntc_Initialize(XIntc *InstancePtr, u16 DeviceId);
+int XIntc_Connect(XIntc *InstancePtr, u8 Id, XInterruptHandler Handler, void *CallBackRef);
+int XIntc_Start(XIntc *InstancePtr, u8 Mode);
+void XIntc_Enable(XIntc *InstancePtr, u8 Id);
+void XIntc_Disable(XIntc *InstancePtr, u8 Id);
+
+#endif
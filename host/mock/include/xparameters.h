@@ -0,0 +1,59 @@
+/**
+ * @file xparameters.h
+ *
+ * @authors Stephen, Drew, Noah
+ * @copyright Portland State University, 2023
+ *
+ * @brief
+ * Host build stand-in for the BSP xparameters.h. Only the devices the
+ * firmware uses, at made up addresses the mock register model decodes.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ * ---------------------
+ * Ver  Who Date    Changes
+ * -----------------------------------
+ * 1.00a DS 17-Oct-2026 First release
+ * </pre>
+************************************************************/
+
+#ifndef XPARAMETERS_H
+#define XPARAMETERS_H
+
+#define XPAR_CPU_CORE_CLOCK_FREQ_HZ 100000000
+#define XPAR_MICROBLAZE_USE_ICACHE 0
+#define XPAR_MICROBLAZE_USE_DCACHE 0
+
+/* AXI slaves decoded by the register model in hal_mock.c */
+#define XPAR_NEXYS4IO_0_DEVICE_ID 0
+#define XPAR_NEXYS4IO_0_S00_AXI_BASEADDR 0x44A00000
+#define XPAR_PMODENC544_0_DEVICE_ID 0
+#define XPAR_PMODENC544_0_S00_AXI_BASEADDR 0x44A10000
+#define XPAR_MYHB3IP_0_DEVICE_ID 0
+#define XPAR_MYHB3IP_0_S00_AXI_BASEADDR 0x44A20000
+#define XPAR_UARTLITE_0_DEVICE_ID 0
+#define XPAR_UARTLITE_0_BASEADDR 0x40600000
+#define XPAR_UARTLITE_0_BAUDRATE 9600
+
+/* devices mocked at the driver API */
+#define XPAR_INTC_0_DEVICE_ID 0
+#define XPAR_INTC_0_BASEADDR 0x41200000
+#define XPAR_TMRCTR_0_DEVICE_ID 0
+#define XPAR_TMRCTR_0_BASEADDR 0x41C00000
+#define XPAR_TMRCTR_0_CLOCK_FREQ_HZ 100000000
+#define XPAR_TMRCTR_1_DEVICE_ID 1
+#define XPAR_TMRCTR_1_BASEADDR 0x41C10000
+#define XPAR_TMRCTR_1_CLOCK_FREQ_HZ 100000000
+#define XPAR_AXI_TIMEBASE_WDT_0_DEVICE_ID 0
+
+/* interrupt controller inputs */
+#define XPAR_MICROBLAZE_0_AXI_INTC_AXI_TIMEBASE_WDT_0_WDT_INTERRUPT_INTR 0
+#define XPAR_MICROBLAZE_0_AXI_INTC_FIT_TIMER_0_INTERRUPT_INTR 1
+#define XPAR_MICROBLAZE_0_AXI_INTC_AXI_TIMER_0_INTERRUPT_INTR 2
+#define XPAR_MICROBLAZE_0_AXI_INTC_AXI_UARTLITE_0_INTERRUPT_INTR 3
+#define XPAR_MICROBLAZE_0_AXI_INTC_MYHB3IP_0_SAMPLE_IRQ_INTR 4
+#define XPAR_MICROBLAZE_0_AXI_INTC_NEXYS4IO_0_INPUT_IRQ_INTR 5
+#define XPAR_MICROBLAZE_0_AXI_INTC_PMODENC544_0_ENC_IRQ_INTR 6
+#define XPAR_INTC_MAX_NUM_INTR_INPUTS 7
+
+#endif
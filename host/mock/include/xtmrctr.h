@@ -0,0 +1,72 @@
+/**
+ * @file xtmrctr.h
+ *
+ * @authors Stephen, Drew, Noah
+ * @copyright Portland State University, 2023
+ *
+ * @brief
+ * Host build stand-in for the XTmrCtr driver, modelling axi_timer_0 and
+ * axi_timer_1 by device ID. Like the real driver the interrupt is
+ * acknowledged after the callback, and in cascade mode timer 1 counts the
+ * carries out of timer 0. Only axi_timer_0 has its interrupt connected.
+ * The counter registers can also be read straight off the bus, the way
+ * the stage profiler reads its timestamp.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ * ---------------------
+ * Ver  Who Date    Changes
+ * -----------------------------------
+ * 1.00a DS 17-Oct-2026 First release
+ * </pre>
+************************************************************/
+
+#ifndef XTMRCTR_H
+#define XTMRCTR_H
+
+#include <stdbool.h>
+#include "xparameters.h"
+#include "xstatus.h"
+
+#define XTC_DEVICE_TIMER_COUNT 2
+
+/* register offsets, from xtmrctr_l.h */
+#define XTC_TIMER_COUNTER_OFFSET 16
+#define XTC_TCSR_OFFSET 0
+#define XTC_TLR_OFFSET 4
+#define XTC_TCR_OFFSET 8
+
+#define XTC_CASCADE_MODE_OPTION 0x00000080UL
+#define XTC_ENABLE_ALL_OPTION 0x00000040UL
+#define XTC_DOWN_COUNT_OPTION 0x00000020UL
+#define XTC_CAPTURE_MODE_OPTION 0x00000010UL
+#define XTC_INT_MODE_OPTION 0x00000008UL
+#define XTC_AUTO_RELOAD_OPTION 0x00000004UL
+#define XTC_EXT_COMPARE_OPTION 0x00000002UL
+
+typedef void (*XTmrCtr_Handler)(void *CallBackRef, u8 TmrCtrNumber);
+
+typedef struct {
+    u32 IsReady;
+    XTmrCtr_Handler Handler;
+    void *CallBackRef;
+    u32 Options[XTC_DEVICE_TIMER_COUNT];
+    u32 ResetValue[XTC_DEVICE_TIMER_COUNT];
+    u32 Value[XTC_DEVICE_TIMER_COUNT];
+    bool Running[XTC_DEVICE_TIMER_COUNT];
+    bool Expired[XTC_DEVICE_TIMER_COUNT];
+} XTmrCtr;
+
+int XTmrCtr_Initialize(XTmrCtr *InstancePtr, u16 DeviceId);
+void XTmrCtr_InterruptHandler(void *InstancePtr);
+void XTmrCtr_SetHandler(XTmrCtr *InstancePtr, XTmrCtr_Handler FuncPtr, void *CallBackRef);
+void XTmrCtr_SetOptions(XTmrCtr *InstancePtr, u8 TmrCtrNumber, u32 Options);
+u32 XTmrCtr_GetOptions(XTmrCtr *InstancePtr, u8 TmrCtrNumber);
+void XTmrCtr_SetResetValue(XTmrCtr *InstancePtr, u8 TmrCtrNumber, u32 ResetValue);
+void XTmrCtr_Start(XTmrCtr *InstancePtr, u8 TmrCtrNumber);
+void XTmrCtr_Stop(XTmrCtr *InstancePtr, u8 TmrCtrNumber);
+void XTmrCtr_Reset(XTmrCtr *InstancePtr, u8 TmrCtrNumber);
+u32 XTmrCtr_GetValue(XTmrCtr *InstancePtr, u8 TmrCtrNumber);
+int XTmrCtr_IsExpired(XTmrCtr *InstancePtr, u8 TmrCtrNumber);
+
+#endif
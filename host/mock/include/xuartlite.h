@@ -0,0 +1,38 @@
+/**
+ * @file xuartlite.h
+ *
+ * @authors Stephen, Drew, Noah
+ * @copyright Portland State University, 2023
+ *
+ * @brief
+ * Host build stand-in for the XUartLite driver. The UART registers are in
+ * the register model, see xuartlite_l.h.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ * ---------------------
+ * Ver  Who Date    Changes
+ * -----------------------------------
+ * 1.00a DS 17-Oct-2026 First release
+ * </pre>
+************************************************************/
+
+#ifndef XUARTLITE_H
+#define XUARTLITE_H
+
+#include "xparameters.h"
+#include "xstatus.h"
+#include "xuartlite_l.h"
+
+typedef struct {
+    UINTPTR RegBaseAddress;
+    u32 IsReady;
+} XUartLite;
+
+int XUartLite_Initialize(XUartLite *InstancePtr, u16 DeviceId);
+int XUartLite_SelfTest(XUartLite *InstancePtr);
+unsigned int XUartLite_Send(XUartLite *InstancePtr, u8 *DataBufferPtr, unsigned int NumBytes);
+int XUartLite_IsSending(XUartLite *InstancePtr);
+void XUartLite_ResetFifos(XUartLite *InstancePtr);
+
+#endif
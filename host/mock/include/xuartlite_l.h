@@ -0,0 +1,51 @@
+/**
+ * @file xuartlite_l.h
+ *
+ * @authors Stephen, Drew, Noah
+ * @copyright Portland State University, 2023
+ *
+ * @brief
+ * Host build stand-in for the BSP xuartlite_l.h, same register map.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ * ---------------------
+ * Ver  Who Date    Changes
+ * -----------------------------------
+ * 1.00a DS 17-Oct-2026 First release
+ * </pre>
+************************************************************/
+
+#ifndef XUARTLITE_L_H
+#define XUARTLITE_L_H
+
+#include "xil_types.h"
+#include "xil_io.h"
+
+#define XUL_RX_FIFO_OFFSET 0
+#define XUL_TX_FIFO_OFFSET 4
+#define XUL_STATUS_REG_OFFSET 8
+#define XUL_CONTROL_REG_OFFSET 12
+
+#define XUL_CR_ENABLE_INTR 0x10
+#define XUL_CR_FIFO_RX_RESET 0x02
+#define XUL_CR_FIFO_TX_RESET 0x01
+
+#define XUL_SR_PARITY_ERROR 0x80
+#define XUL_SR_FRAMING_ERROR 0x40
+#define XUL_SR_OVERRUN_ERROR 0x20
+#define XUL_SR_INTR_ENABLED 0x10
+#define XUL_SR_TX_FIFO_FULL 0x08
+#define XUL_SR_TX_FIFO_EMPTY 0x04
+#define XUL_SR_RX_FIFO_FULL 0x02
+#define XUL_SR_RX_FIFO_VALID_DATA 0x01
+
+#define XUL_FIFO_SIZE 16
+
+#define XUartLite_ReadReg(BaseAddress, RegOffset) Xil_In32((BaseAddress) + (RegOffset))
+#define XUartLite_WriteReg(BaseAddress, RegOffset, Data) Xil_Out32((BaseAddress) + (RegOffset), (u32)(Data))
+#define XUartLite_GetStatusReg(BaseAddress) XUartLite_ReadReg((BaseAddress), XUL_STATUS_REG_OFFSET)
+#define XUartLite_EnableIntr(BaseAddress) XUartLite_WriteReg((BaseAddress), XUL_CONTROL_REG_OFFSET, XUL_CR_ENABLE_INTR)
+#define XUartLite_DisableIntr(BaseAddress) XUartLite_WriteReg((BaseAddress), XUL_CONTROL_REG_OFFSET, 0)
+
+#endif
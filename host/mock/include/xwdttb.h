@@ -0,0 +1,40 @@
+/**
+ * @file xwdttb.h
+ *
+ * @authors Stephen, Drew, Noah
+ * @copyright Portland State University, 2023
+ *
+ * @brief
+ * Host build stand-in for the XWdtTb driver. The timebase is the model
+ * clock, the watchdog expires when mock_wdt_expire() says so.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ * ---------------------
+ * Ver  Who Date    Changes
+ * -----------------------------------
+ * 1.00a DS 17-Oct-2026 First release
+ * </pre>
+************************************************************/
+
+#ifndef XWDTTB_H
+#define XWDTTB_H
+
+#include <stdbool.h>
+#include "xparameters.h"
+#include "xstatus.h"
+
+typedef struct {
+    u32 IsReady;
+    bool IsStarted;
+} XWdtTb;
+
+int XWdtTb_Initialize(XWdtTb *InstancePtr, u16 DeviceId);
+int XWdtTb_SelfTest(XWdtTb *InstancePtr);
+void XWdtTb_Start(XWdtTb *InstancePtr);
+int XWdtTb_Stop(XWdtTb *InstancePtr);
+void XWdtTb_RestartWdt(XWdtTb *InstancePtr);
+bool XWdtTb_IsWdtExpired(XWdtTb *InstancePtr);
+u32 XWdtTb_GetTbValue(XWdtTb *InstancePtr);
+
+#endif
@@ -0,0 +1,553 @@
+/**
+ * @file motor_plant.c
+ *
+ * @authors Stephen, Drew, Noah
+ * @copyright Portland State University, 2023
+ *
+ * @brief
+ * This is the source file for the host model of the motor, gearbox and
+ * tach. The PWM is taken as its average voltage (the carrier is far faster
+ * than the armature L/R). The armature current is stepped implicitly so
+ * any step up to a few ms is stable, the rotor explicitly, which is fine
+ * while the step is well under the mechanical time constant.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ * ---------------------
+ * Ver  Who Date    Changes
+ * -----------------------------------
+ * 1.00a DS 17-Oct-2026 First release
+ * </pre>
+************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+#include "motor_plant.h"
+#include "xparameters.h"
+#include "hal_mock.h"
+
+/*********Local Constants****************************/
+#define RPM_PER_RAD_S       (60.0 / (2.0 * M_PI))
+#define PWM_COUNT_MAX       1024.0      // 10 bit counts in the logs
+#define PWM_DUTY_SCALE      65536.0     // 16 bit left aligned duty field of the PWM control reg
+#define PWM_DUTY_SHIFT      14
+#define PWM_DUTY_MASK       0xFFFF
+#define PWM_ENABLE_MASK     0x80000000
+#define FIT_MAX_COLS        16
+#define FIT_SAMPLE_SECONDS  1.0         // plot_display.py logs once a second
+#define FIT_MIN_STEP_RPM    5.0         // smaller steps are lost in the 1 rpm rounding
+#define FIT_EXP_MIN         1.0         // drag exponents tried
+#define FIT_EXP_MAX         6.0
+#define FIT_EXP_STEP        0.125
+
+/**
+ * motor_params_default() - parameters fitted to duty_cycle_characterization.csv
+ *
+ * @brief       From motor_fit_csv() on logger/csv/duty_cycle_characterization.csv.
+ *              The supply, resistance and inductance are the motor's
+ *              nominal values; every other term is relative to them. The
+ *              1 Hz logs settle inside one sample, so the inertia is the
+ *              largest one they allow rather than a measurement.
+*/
+void motor_params_default(ptr_motor_params_t p) {
+    p->supply_v = 12.0;
+    p->r_ohm = 2.5;
+    p->l_h = 1.0e-3;
+    p->ke = 2.85318e-4;
+    p->j = 4.11691e-7;
+    p->drag = 9.84152e-12;
+    p->drag_exp = 2.875;
+    p->coulomb = 4.5634e-4;
+    p->breakaway = 5.61506e-4;
+    p->gear_ratio = PLANT_GEAR_RATIO;
+    p->ticks_per_rev = PLANT_TICKS_PER_REV;
+}
+
+/**
+ * motor_plant_init() - a stopped motor with the given parameters
+*/
+void motor_plant_init(ptr_motor_plant_t m, const motor_params_t *p) {
+    m->p = *p;
+    m->current = 0.0;
+    m->omega = 0.0;
+    m->revs = 0.0;
+    m->stuck = true;
+}
+
+/**
+ * motor_plant_step() - integrates the motor over one step
+ *
+ * @brief       The motor only turns forward: the firmware never reverses
+ *              the H-bridge, and friction is not allowed to push it back
+ *              past stopped.
+*/
+uint32_t motor_plant_step(ptr_motor_plant_t m, double duty, double dt, double *edge_frac) {
+    const motor_params_t *p = &m->p;
+    double volts, torque, load, omega, revs, tick;
+    uint32_t edges = 0;
+
+    if(duty < 0.0) {
+        duty = 0.0;
+    }
+    if(duty > 1.0) {
+        duty = 1.0;
+    }
+
+    // L di/dt = V - R i - Ke w, backward Euler in i
+    volts = p->supply_v * duty - p->ke * m->omega;
+    m->current = (m->current + dt / p->l_h * volts) / (1.0 + dt * p->r_ohm / p->l_h);
+    torque = p->ke * m->current;
+
+    if(m->stuck) {
+        if(torque <= p->breakaway) {
+            return 0;
+        }
+        m->stuck = false;
+    }
+
+    load = p->coulomb + p->drag * pow(m->omega, p->drag_exp);
+    omega = m->omega + dt * (torque - load) / p->j;
+    if(omega <= 0.0) {
+        // stopped inside the step, static friction holds it until the
+        // torque beats it again
+        omega = 0.0;
+        m->stuck = true;
+    }
+
+    // output shaft turns, trapezoid over the step, then every tach edge
+    // crossed on the way with where in the step it fell
+    revs = m->revs + 0.5 * (m->omega + omega) * dt / (2.0 * M_PI * p->gear_ratio);
+    tick = floor(m->revs * p->ticks_per_rev) + 1.0;
+    while(tick <= revs * p->ticks_per_rev && edges < PLANT_MAX_EDGES) {
+        edge_frac[edges++] = (tick / p->ticks_per_rev - m->revs) / (revs - m->revs);
+        tick += 1.0;
+    }
+    m->revs = revs;
+    m->omega = omega;
+    return edges;
+}
+
+/**
+ * motor_plant_rpm() - output shaft speed
+*/
+double motor_plant_rpm(const motor_plant_t *m) {
+    return m->omega * RPM_PER_RAD_S / m->p.gear_ratio;
+}
+
+/**
+ * motor_plant_steady_rpm() - output rpm the model settles at for a duty
+ *
+ * @brief       Bisects Ke (V u - Ke w) / R = coulomb + drag w^n for w, or
+ *              0 if the duty is not enough to break the motor free
+*/
+double motor_plant_steady_rpm(const motor_params_t *p, double duty) {
+    double lo = 0.0, hi = p->supply_v * duty / p->ke;
+
+    if(p->ke * p->supply_v * duty / p->r_ohm <= p->breakaway) {
+        return 0.0;
+    }
+    for(int i = 0; i < 60; i++) {
+        double w = 0.5 * (lo + hi);
+        double net = p->ke * (p->supply_v * duty - p->ke * w) / p->r_ohm
+                   - p->coulomb - p->drag * pow(w, p->drag_exp);
+        if(net > 0.0) {
+            lo = w;
+        }
+        else {
+            hi = w;
+        }
+    }
+    return lo * RPM_PER_RAD_S / p->gear_ratio;
+}
+
+/**
+ * motor_tach_init() - clears the tach state, the window starts now
+*/
+void motor_tach_init(ptr_motor_tach_t t) {
+    memset(t, 0, sizeof(*t));
+    t->window_start = mock_clocks();
+}
+
+/**
+ * motor_tach_advance() - closes any tick windows that ended and publishes
+ * a period of 0 if the motor has stalled
+*/
+void motor_tach_advance(ptr_motor_tach_t t, uint64_t clock) {
+    while(clock >= t->window_start + PLANT_TACH_WINDOW_CLOCKS) {
+        mock_hb3_publish_ticks(t->window_ticks << 2);
+        t->window_start += PLANT_TACH_WINDOW_CLOCKS;
+        t->window_ticks = 0;
+    }
+    if(t->have_edge && clock - t->last_edge >= PLANT_TACH_STALL_CLOCKS) {
+        mock_hb3_publish_period(0);
+        t->have_edge = false;
+        t->have_period = false;
+    }
+}
+
+/**
+ * motor_tach_edge() - a rising edge on tachA at this clock
+*/
+void motor_tach_edge(ptr_motor_tach_t t, uint64_t clock) {
+    uint32_t period;
+
+    motor_tach_advance(t, clock);
+    t->window_ticks++;
+    if(t->have_edge) {
+        period = (uint32_t)(clock - t->last_edge);
+        if(!t->have_period) {
+            // first period after reset or a stall primes the whole average
+            for(uint32_t i = 0; i < PLANT_TACH_AVG_EDGES; i++) {
+                t->hist[i] = period;
+            }
+            t->sum = (uint64_t)period * PLANT_TACH_AVG_EDGES;
+            t->have_period = true;
+        }
+        else {
+            t->sum = t->sum - t->hist[t->hist_idx] + period;
+            t->hist[t->hist_idx] = period;
+            t->hist_idx = (t->hist_idx + 1) % PLANT_TACH_AVG_EDGES;
+        }
+        mock_hb3_publish_period(period);
+    }
+    t->last_edge = clock;
+    t->have_edge = true;
+}
+
+/**
+ * motor_sim_init() - plant and tach together, tach state at the model clock
+*/
+void motor_sim_init(ptr_motor_sim_t sim, const motor_params_t *p) {
+    motor_plant_init(&sim->plant, p);
+    motor_tach_init(&sim->tach);
+    sim->edges = 0;
+}
+
+/**
+ * motor_sim_duty() - duty the firmware last drove onto the H-bridge
+*/
+static double motor_sim_duty(void) {
+    uint32_t reg = mock_hb3_pwm();
+
+    if(!(reg & PWM_ENABLE_MASK)) {
+        return 0.0;
+    }
+    return ((reg >> PWM_DUTY_SHIFT) & PWM_DUTY_MASK) / PWM_DUTY_SCALE;
+}
+
+/**
+ * motor_sim_run() - runs the plant against the firmware
+*/
+void motor_sim_run(ptr_motor_sim_t sim, uint64_t clocks) {
+    double frac[PLANT_MAX_EDGES];
+    double dt = (double)PLANT_STEP_CLOCKS / XPAR_CPU_CORE_CLOCK_FREQ_HZ;
+    uint64_t end = mock_clocks() + clocks;
+
+    while(mock_clocks() < end) {
+        uint64_t start = mock_clocks();
+        uint64_t step = (end - start < PLANT_STEP_CLOCKS) ? end - start : PLANT_STEP_CLOCKS;
+        uint32_t edges = motor_plant_step(&sim->plant, motor_sim_duty(),
+                                          dt * step / PLANT_STEP_CLOCKS, frac);
+
+        for(uint32_t i = 0; i < edges; i++) {
+            uint64_t at = start + (uint64_t)(frac[i] * step);
+            if(at > mock_clocks()) {
+                mock_advance_clocks(at - mock_clocks());
+            }
+            motor_tach_edge(&sim->tach, mock_clocks());
+        }
+        sim->edges += edges;
+        mock_advance_clocks(start + step - mock_clocks());
+        motor_tach_advance(&sim->tach, mock_clocks());
+    }
+}
+
+/*********Calibration****************************/
+
+typedef struct fit_sample {
+    double duty;                // 0.0 - 1.0
+    double rpm;                 // output shaft
+} fit_sample_t;
+
+typedef struct fit_data {
+    fit_sample_t *settled;      // same duty as the sample before
+    uint32_t n_settled, cap_settled;
+    double breakaway_duty;      // lowest duty the motor started from 0 at
+    double stuck_duty;          // highest duty it sat at 0 rpm
+    double tau_sum;             // duty step time constants
+    uint32_t tau_n;
+    double tau_bound;           // steps that finished inside one sample
+} fit_data_t;
+
+/**
+ * fit_trim() - strips whitespace (and the CR on Windows logs) in place
+*/
+static char *fit_trim(char *s) {
+    char *end;
+
+    while(isspace((unsigned char)*s)) {
+        s++;
+    }
+    end = s + strlen(s);
+    while(end > s && isspace((unsigned char)end[-1])) {
+        *--end = '\0';
+    }
+    return s;
+}
+
+/**
+ * fit_split() - splits a csv line into trimmed fields
+*/
+static int fit_split(char *line, char **fields) {
+    int n = 0;
+    char *s = line;
+
+    while(n < FIT_MAX_COLS) {
+        char *comma = strchr(s, ',');
+        if(comma) {
+            *comma = '\0';
+        }
+        fields[n++] = fit_trim(s);
+        if(!comma) {
+            break;
+        }
+        s = comma + 1;
+    }
+    return n;
+}
+
+static void fit_add(fit_data_t *d, double duty, double rpm) {
+    if(d->n_settled == d->cap_settled) {
+        d->cap_settled = d->cap_settled ? d->cap_settled * 2 : 256;
+        d->settled = realloc(d->settled, d->cap_settled * sizeof(*d->settled));
+    }
+    d->settled[d->n_settled].duty = duty;
+    d->settled[d->n_settled].rpm = rpm;
+    d->n_settled++;
+}
+
+/**
+ * fit_read() - pulls the settled samples and duty steps out of one log
+ *
+ * @return      rows used, -1 if the file could not be read
+*/
+static int fit_read(const char *path, fit_data_t *d) {
+    char line[512];
+    char *f[FIT_MAX_COLS];
+    int n, duty_col = -1, pwm_col = -1, rpm_col = -1, rows = 0;
+    double prev_duty = -1.0, prev_rpm = 0.0, step_from = 0.0;
+    bool stepped = false;
+    FILE *fp = fopen(path, "r");
+
+    if(!fp) {
+        return -1;
+    }
+    if(!fgets(line, sizeof(line), fp)) {
+        fclose(fp);
+        return 0;
+    }
+    n = fit_split(line, f);
+    for(int i = 0; i < n; i++) {
+        if(!strcmp(f[i], "duty cycle")) {
+            duty_col = i;
+        }
+        else if(!strcmp(f[i], "pwm")) {
+            pwm_col = i;
+        }
+        else if(!strcmp(f[i], "read rpm")) {
+            rpm_col = i;
+        }
+    }
+    if(rpm_col < 0 || (duty_col < 0 && pwm_col < 0)) {
+        fclose(fp);
+        return 0;
+    }
+
+    while(fgets(line, sizeof(line), fp)) {
+        double duty, rpm;
+
+        n = fit_split(line, f);
+        if(n <= rpm_col || (duty_col >= 0 && n <= duty_col) || (pwm_col >= 0 && n <= pwm_col)) {
+            continue;
+        }
+        duty = (duty_col >= 0) ? atof(f[duty_col]) / 100.0 : atof(f[pwm_col]) / PWM_COUNT_MAX;
+        rpm = atof(f[rpm_col]);
+        rows++;
+
+        if(duty == prev_duty) {
+            fit_add(d, duty, rpm);
+            if(rpm == 0.0 && duty > d->stuck_duty) {
+                d->stuck_duty = duty;
+            }
+            if(stepped) {
+                // one sample after a step got (prev - from) of the way to
+                // where it settled. Only a bound if it got all the way
+                double f_done = (prev_rpm - step_from) / (rpm - step_from);
+                if(fabs(rpm - step_from) >= FIT_MIN_STEP_RPM) {
+                    if(f_done > 0.05 && f_done < 0.95) {
+                        d->tau_sum += -FIT_SAMPLE_SECONDS / log(1.0 - f_done);
+                        d->tau_n++;
+                    }
+                    else if(f_done >= 0.95) {
+                        d->tau_bound = fmin(d->tau_bound, -FIT_SAMPLE_SECONDS / log(0.05));
+                    }
+                }
+            }
+        }
+        if(prev_rpm == 0.0 && rpm > 0.0 && duty == prev_duty && duty < d->breakaway_duty) {
+            d->breakaway_duty = duty;
+        }
+        stepped = (prev_duty >= 0.0 && duty != prev_duty);
+        step_from = prev_rpm;
+        prev_duty = duty;
+        prev_rpm = rpm;
+    }
+    fclose(fp);
+    return rows;
+}
+
+/**
+ * fit_solve3() - solves a 3x3 system by Cramer's rule
+ *
+ * @return      false if it is singular
+*/
+static bool fit_solve3(double a[3][3], const double b[3], double x[3]) {
+    double det = a[0][0] * (a[1][1] * a[2][2] - a[1][2] * a[2][1])
+               - a[0][1] * (a[1][0] * a[2][2] - a[1][2] * a[2][0])
+               + a[0][2] * (a[1][0] * a[2][1] - a[1][1] * a[2][0]);
+
+    if(fabs(det) < 1e-30) {
+        return false;
+    }
+    for(int k = 0; k < 3; k++) {
+        double m[3][3];
+        memcpy(m, a, sizeof(m));
+        for(int r = 0; r < 3; r++) {
+            m[r][k] = b[r];
+        }
+        x[k] = (m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1])
+              - m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0])
+              + m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0])) / det;
+    }
+    return true;
+}
+
+/**
+ * fit_power() - least squares fit of duty = c0 + c1 x + c2 x^n
+ *
+ * @param       x           speeds scaled to 0.0 - 1.0
+ *
+ * @return      rms error in duty, INFINITY if a coefficient came out
+ *              unphysical (c0 or c2 negative, c1 not positive)
+*/
+static double fit_power(const fit_sample_t *s, const double *x, uint32_t n_s, double n, double c[3]) {
+    double ata[3][3] = { { 0 } }, atb[3] = { 0 }, err = 0.0;
+
+    for(uint32_t i = 0; i < n_s; i++) {
+        double row[3] = { 1.0, x[i], pow(x[i], n) };
+        for(int r = 0; r < 3; r++) {
+            for(int k = 0; k < 3; k++) {
+                ata[r][k] += row[r] * row[k];
+            }
+            atb[r] += row[r] * s[i].duty;
+        }
+    }
+    if(!fit_solve3(ata, atb, c) || c[0] < 0.0 || c[1] <= 0.0 || c[2] < 0.0) {
+        return INFINITY;
+    }
+    for(uint32_t i = 0; i < n_s; i++) {
+        double r = c[0] + c[1] * x[i] + c[2] * pow(x[i], n) - s[i].duty;
+        err += r * r;
+    }
+    return sqrt(err / n_s);
+}
+
+/**
+ * motor_fit_csv() - refits the parameters to logged runs
+ *
+ * @brief       At steady state Ke (V u - Ke w) / R = coulomb + drag w^n,
+ *              so with w the motor speed over its top speed wm
+ *                  u = (R coulomb / Ke V) + (Ke wm / V) w + (R drag wm^n / Ke V) w^n
+ *              and the three fitted coefficients give coulomb, Ke and drag
+ *              for the nominal V and R. The logs only pin down the shape of
+ *              the curve, not how it splits between back EMF and load, so
+ *              the drag exponent is the one with the best fit that keeps
+ *              every term physical.
+*/
+uint32_t motor_fit_csv(const char *const *paths, uint32_t count, ptr_motor_params_t p, bool verbose) {
+    fit_data_t d = { 0 };
+    fit_sample_t *moving;
+    double *x;
+    double c[3], best_c[3] = { 0 }, best_err = INFINITY, best_n = 0.0;
+    double omega_max = 0.0, tau, omega_op;
+    uint32_t used = 0;
+
+    d.breakaway_duty = 2.0;
+    d.tau_bound = INFINITY;
+    for(uint32_t i = 0; i < count; i++) {
+        int rows = fit_read(paths[i], &d);
+        if(rows < 0) {
+            fprintf(stderr, "motor_fit_csv: cannot read %s\n", paths[i]);
+        }
+        else if(verbose) {
+            printf("  %s: %d rows\n", paths[i], rows);
+        }
+    }
+
+    moving = malloc((d.n_settled + 1) * sizeof(*moving));
+    x = malloc((d.n_settled + 1) * sizeof(*x));
+    for(uint32_t i = 0; i < d.n_settled; i++) {
+        if(d.settled[i].rpm > 0.0) {
+            moving[used++] = d.settled[i];
+            omega_max = fmax(omega_max, d.settled[i].rpm * p->gear_ratio / RPM_PER_RAD_S);
+        }
+    }
+    for(uint32_t i = 0; i < used; i++) {
+        x[i] = moving[i].rpm * p->gear_ratio / RPM_PER_RAD_S / omega_max;
+    }
+    for(double n = FIT_EXP_MIN; used >= 3 && n <= FIT_EXP_MAX; n += FIT_EXP_STEP) {
+        double err = fit_power(moving, x, used, n, c);
+        if(err < best_err) {
+            best_err = err;
+            best_n = n;
+            memcpy(best_c, c, sizeof(c));
+        }
+    }
+    free(moving);
+    free(x);
+    free(d.settled);
+    if(!isfinite(best_err)) {
+        return 0;
+    }
+
+    p->ke = best_c[1] * p->supply_v / omega_max;
+    p->coulomb = best_c[0] * p->ke * p->supply_v / p->r_ohm;
+    p->drag = best_c[2] * p->ke * p->supply_v / (p->r_ohm * pow(omega_max, best_n));
+    p->drag_exp = best_n;
+    if(d.breakaway_duty > 1.0) {
+        // never seen starting, so just above the highest duty it sat still at
+        d.breakaway_duty = d.stuck_duty + 0.01;
+    }
+    p->breakaway = fmax(d.breakaway_duty * p->ke * p->supply_v / p->r_ohm, p->coulomb);
+
+    // J = tau d(load - torque)/dw around the middle of the range
+    tau = d.tau_n ? d.tau_sum / d.tau_n : d.tau_bound;
+    if(!isfinite(tau)) {
+        tau = -FIT_SAMPLE_SECONDS / log(0.05);
+    }
+    omega_op = 0.5 * omega_max;
+    p->j = tau * (p->ke * p->ke / p->r_ohm + best_n * p->drag * pow(omega_op, best_n - 1.0));
+
+    if(verbose) {
+        printf("  %u settled samples, duty = %.4g + %.4g w + %.4g w^%.3f (w / %.1f rad/s), rms %.2f%%\n",
+               used, best_c[0], best_c[1], best_c[2], best_n, omega_max, best_err * 100.0);
+        printf("  break-away at %.0f%% duty, tau %s %.3f s from %u duty steps\n",
+               d.breakaway_duty * 100.0, d.tau_n ? "~" : "<=", tau, d.tau_n);
+        printf("  ke %.6g  j %.6g  drag %.6g  drag_exp %.3f  coulomb %.6g  breakaway %.6g\n",
+               p->ke, p->j, p->drag, p->drag_exp, p->coulomb, p->breakaway);
+    }
+    return used;
+}
@@ -0,0 +1,163 @@
+/**
+ * @file motor_plant.h
+ *
+ * @authors Stephen, Drew, Noah
+ * @copyright Portland State University, 2023
+ *
+ * @brief
+ * This is the header file for the host model of the motor, gearbox and
+ * tach. The armature is an R-L circuit with back EMF driving the rotor
+ * inertia against a load that rises as a power of speed, Coulomb friction
+ * and a static friction break-away, which gives the dead-band below ~41%
+ * duty and the bend in the characterization curve. The tach puts out one edge every
+ * 1/ticks_per_rev of an output shaft turn.
+ *
+ * motor_tach_t then does what ticks.v does with those edges - per edge
+ * period and 8 edge average, stall detection and the 0.25s tick window -
+ * and publishes the results through the mock myHB3ip registers.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ * ---------------------
+ * Ver  Who Date    Changes
+ * -----------------------------------
+ * 1.00a DS 17-Oct-2026 First release
+ * </pre>
+************************************************************/
+
+#ifndef MOTOR_PLANT_H
+#define MOTOR_PLANT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*********Plant Constants****************************/
+#define PLANT_TICKS_PER_REV         823.13      // tach edges per output rev, 11 CPR x 74.83:1
+#define PLANT_GEAR_RATIO            74.83
+#define PLANT_MAX_EDGES             64          // most tach edges one step may return
+#define PLANT_TACH_AVG_EDGES        8           // AVG_EDGES in ticks.v
+#define PLANT_TACH_WINDOW_CLOCKS    25000000    // MAX_COUNT in ticks.v, 0.25s
+#define PLANT_TACH_STALL_CLOCKS     25000000    // STALL_COUNT in ticks.v
+#define PLANT_STEP_CLOCKS           10000       // motor_sim_run() step, 100us
+
+/*********Plant Structs****************************/
+typedef struct motor_params {
+    double supply_v;            // H-bridge supply
+    double r_ohm;               // armature resistance
+    double l_h;                 // armature inductance
+    double ke;                  // back EMF, V s/rad at the motor (= kt, N m/A)
+    double j;                   // rotor + reflected load inertia, kg m^2
+    double drag;                // load torque drag * w^drag_exp, N m
+    double drag_exp;
+    double coulomb;             // running friction, N m
+    double breakaway;           // static friction to start turning, N m
+    double gear_ratio;          // motor turns per output turn
+    double ticks_per_rev;       // tach edges per output turn
+} motor_params_t, *ptr_motor_params_t;
+
+typedef struct motor_plant {
+    motor_params_t p;
+    double current;             // A
+    double omega;               // motor rad/s
+    double revs;                // output shaft turns
+    bool stuck;                 // held by static friction
+} motor_plant_t, *ptr_motor_plant_t;
+
+typedef struct motor_tach {
+    uint64_t last_edge;         // clock of the last tach edge
+    bool have_edge;             // an edge since reset or the last stall
+    bool have_period;           // the average is primed
+    uint32_t hist[PLANT_TACH_AVG_EDGES];
+    uint32_t hist_idx;
+    uint64_t sum;
+    uint64_t window_start;
+    uint32_t window_ticks;
+} motor_tach_t, *ptr_motor_tach_t;
+
+typedef struct motor_sim {
+    motor_plant_t plant;
+    motor_tach_t tach;
+    uint64_t edges;             // tach edges so far
+} motor_sim_t, *ptr_motor_sim_t;
+
+/**
+ * motor_params_default() - parameters fitted to duty_cycle_characterization.csv
+*/
+void motor_params_default(ptr_motor_params_t p);
+
+/**
+ * motor_plant_init() - a stopped motor with the given parameters
+*/
+void motor_plant_init(ptr_motor_plant_t m, const motor_params_t *p);
+
+/**
+ * motor_plant_step() - integrates the motor over one step
+ *
+ * @param       duty        PWM duty 0.0 - 1.0 held over the step
+ * @param       dt          step in seconds
+ * @param       edge_frac   filled with when each tach edge fell in the
+ *                          step, as a fraction 0.0 - 1.0 of dt
+ *
+ * @return      number of tach edges in the step (at most PLANT_MAX_EDGES)
+*/
+uint32_t motor_plant_step(ptr_motor_plant_t m, double duty, double dt, double *edge_frac);
+
+/**
+ * motor_plant_rpm() - output shaft speed
+*/
+double motor_plant_rpm(const motor_plant_t *m);
+
+/**
+ * motor_plant_steady_rpm() - output rpm the model settles at for a duty
+*/
+double motor_plant_steady_rpm(const motor_params_t *p, double duty);
+
+/**
+ * motor_tach_init()/motor_tach_edge()/motor_tach_advance() - ticks.v on
+ * the host. Edges must be given in clock order, and advance() called at
+ * least once per window so windows and stalls are published on time.
+*/
+void motor_tach_init(ptr_motor_tach_t t);
+void motor_tach_edge(ptr_motor_tach_t t, uint64_t clock);
+void motor_tach_advance(ptr_motor_tach_t t, uint64_t clock);
+
+/**
+ * motor_sim_init() - plant and tach together, tach state at the model clock
+*/
+void motor_sim_init(ptr_motor_sim_t sim, const motor_params_t *p);
+
+/**
+ * motor_sim_run() - runs the plant against the firmware
+ *
+ * @brief       Steps the plant every PLANT_STEP_CLOCKS on the duty in the
+ *              myHB3ip PWM register and moves the model clock up to each
+ *              tach edge in turn, so the firmware timers, interrupts and
+ *              control tick all see the edges when they happened. Windows
+ *              and stalls are published at the end of the step they fall in.
+ *
+ * @param       clocks      AXI clocks to run
+*/
+void motor_sim_run(ptr_motor_sim_t sim, uint64_t clocks);
+
+/**
+ * motor_fit_csv() - refits the parameters to logged runs
+ *
+ * @brief       Takes the settled samples from files that log the duty
+ *              directly (the characterization "duty cycle" column, or the
+ *              "pwm" column plot_display.py writes now), least squares fits
+ *              duty = c0 + c1 w + c2 w^n to them for the running friction,
+ *              back EMF and drag, takes the break-away from the lowest duty
+ *              the motor started at, and sizes the inertia from how far the
+ *              speed got one sample after each duty step. The older logs
+ *              only have set rpm and do not say whether PID was switched on,
+ *              so they are skipped.
+ *
+ * @param       paths, count    csv files to use
+ * @param       p               starts as the defaults, updated in place
+ * @param       verbose         print the fit
+ *
+ * @return      number of settled samples used, 0 if the fit failed
+*/
+uint32_t motor_fit_csv(const char *const *paths, uint32_t count, ptr_motor_params_t p, bool verbose);
+
+#endif
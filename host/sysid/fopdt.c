@@ -0,0 +1,366 @@
+/**
+ * @file fopdt.c
+ *
+ * @authors Stephen, Drew, Noah
+ * @copyright Portland State University, 2023
+ *
+ * @brief
+ * This is the source file for the first order plus dead time fit. A run is
+ * read once into (time, u, y) arrays, then each dead time is a pass over
+ * them summing the 3x3 normal equations and one 3x3 solve.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ * ---------------------
+ * Ver  Who Date    Changes
+ * -----------------------------------
+ * 1.00a DS 17-Oct-2026 First release
+ * </pre>
+************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "fopdt.h"
+
+#define CSV_LINE_MAX        256
+#define CSV_COLS_MAX        16
+#define PWM_RESOLUTION      1023.0      // 10 bit count at 100% duty
+
+/** one run, u is NAN on rows where the duty is not known */
+typedef struct run {
+    double *t, *u, *y;
+    uint32_t n, cap;
+} run_t;
+
+/**
+ * csv_split() - splits a line in place, trimming spaces and the CR the
+ * logger writes
+ *
+ * @return      number of fields
+*/
+static int csv_split(char *line, char *cols[CSV_COLS_MAX]) {
+    int n = 0;
+    char *p = line;
+
+    while(n < CSV_COLS_MAX) {
+        char *end;
+        while(*p == ' ' || *p == '\t') {
+            p++;
+        }
+        cols[n++] = p;
+        end = p + strcspn(p, ",\r\n");
+        p = (*end == ',') ? end + 1 : NULL;
+        while(end > cols[n - 1] && (end[-1] == ' ' || end[-1] == '\t')) {
+            end--;
+        }
+        *end = '\0';
+        if(p == NULL) {
+            break;
+        }
+    }
+    return n;
+}
+
+static int csv_col(char *cols[], int n, const char *name) {
+    for(int i = 0; i < n; i++) {
+        if(!strcmp(cols[i], name)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void run_push(run_t *r, double t, double u, double y) {
+    if(r->n == r->cap) {
+        r->cap = r->cap ? r->cap * 2 : 256;
+        r->t = realloc(r->t, r->cap * sizeof(double));
+        r->u = realloc(r->u, r->cap * sizeof(double));
+        r->y = realloc(r->y, r->cap * sizeof(double));
+    }
+    r->t[r->n] = t;
+    r->u[r->n] = u;
+    r->y[r->n] = y;
+    r->n++;
+}
+
+static void run_free(run_t *r) {
+    free(r->t);
+    free(r->u);
+    free(r->y);
+}
+
+/**
+ * run_read() - reads time, duty and read rpm out of a log
+ *
+ * @return      0, or -1 / -2 as for fopdt_fit_csv()
+*/
+static int run_read(const char *path, run_t *r, fopdt_input_t *input) {
+    char line[CSV_LINE_MAX];
+    char *cols[CSV_COLS_MAX];
+    int n, c_t, c_y, c_duty, c_pwm, c_set, c_kp, c_ki, c_kd;
+    FILE *fp = fopen(path, "r");
+
+    if(fp == NULL) {
+        return -1;
+    }
+    if(fgets(line, sizeof(line), fp) == NULL) {
+        fclose(fp);
+        return -1;
+    }
+    n = csv_split(line, cols);
+    c_t = csv_col(cols, n, "time");
+    c_y = csv_col(cols, n, "read rpm");
+    c_duty = csv_col(cols, n, "duty cycle");
+    c_pwm = csv_col(cols, n, "pwm");
+    c_set = csv_col(cols, n, "set rpm");
+    c_kp = csv_col(cols, n, "Kp");
+    c_ki = csv_col(cols, n, "Ki");
+    c_kd = csv_col(cols, n, "Kd");
+    if(c_t < 0 || c_y < 0) {
+        fclose(fp);
+        return -1;
+    }
+    if(c_pwm >= 0) {
+        *input = FOPDT_INPUT_PWM;
+    }
+    else if(c_duty >= 0) {
+        *input = FOPDT_INPUT_DUTY;
+    }
+    else if(c_set >= 0 && c_kp >= 0 && c_ki >= 0 && c_kd >= 0) {
+        *input = FOPDT_INPUT_OPEN_LOOP;
+    }
+    else {
+        fclose(fp);
+        return -2;
+    }
+
+    while(fgets(line, sizeof(line), fp) != NULL) {
+        double u = NAN;
+
+        n = csv_split(line, cols);
+        if(n <= c_t || n <= c_y) {
+            continue;
+        }
+        switch(*input) {
+            case FOPDT_INPUT_PWM:
+                if(n > c_pwm) {
+                    u = atof(cols[c_pwm]) * 100.0 / PWM_RESOLUTION;
+                }
+                break;
+            case FOPDT_INPUT_DUTY:
+                if(n > c_duty) {
+                    u = atof(cols[c_duty]);
+                }
+                break;
+            default:
+                if(n > c_set && n > c_kp && n > c_ki && n > c_kd
+                   && atoi(cols[c_kp]) == 0 && atoi(cols[c_ki]) == 0 && atoi(cols[c_kd]) == 0) {
+                    u = atof(cols[c_set]) + FOPDT_LEGACY_DUTY_OFFSET;
+                }
+                break;
+        }
+        run_push(r, atof(cols[c_t]), u, atof(cols[c_y]));
+    }
+    fclose(fp);
+    return 0;
+}
+
+/**
+ * run_sample_time() - the interval most rows were logged at
+ *
+ * @brief       The logger is meant to write once a second, but it misses
+ *              reads, so the gaps are 1, 2, 3 ... s. The smallest gap that
+ *              shows up is taken as T.
+*/
+static double run_sample_time(const run_t *r) {
+    double best = INFINITY;
+
+    for(uint32_t k = 1; k < r->n; k++) {
+        double dt = r->t[k] - r->t[k - 1];
+        if(dt > 0.0 && dt < best) {
+            best = dt;
+        }
+    }
+    return best;
+}
+
+/**
+ * solve3() - solves a 3x3 symmetric system by Cramer's rule
+ *
+ * @return      false if it is singular
+*/
+static bool solve3(double a[3][3], const double b[3], double x[3]) {
+    double det = a[0][0] * (a[1][1] * a[2][2] - a[1][2] * a[2][1])
+               - a[0][1] * (a[1][0] * a[2][2] - a[1][2] * a[2][0])
+               + a[0][2] * (a[1][0] * a[2][1] - a[1][1] * a[2][0]);
+
+    if(fabs(det) < 1e-9 * fabs(a[0][0] * a[1][1] * a[2][2])) {
+        return false;
+    }
+    for(int k = 0; k < 3; k++) {
+        double m[3][3];
+        memcpy(m, a, sizeof(m));
+        for(int r = 0; r < 3; r++) {
+            m[r][k] = b[r];
+        }
+        x[k] = (m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1])
+              - m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0])
+              + m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0])) / det;
+    }
+    return true;
+}
+
+/**
+ * row_usable() - whether y[k+1] = a y[k] + b u[k-d] + c can be written for
+ * k and every dead time tried
+ *
+ * @brief       Every dead time is fitted over the same rows so their
+ *              residuals compare. Every step from k-FOPDT_MAX_DEAD_SAMPLES
+ *              to k+1 must be exactly one sample with the duty known, a
+ *              missed read in between breaks it. Rows with the motor
+ *              stopped are in the dead-band, which a linear model cannot
+ *              follow, so they are left out too.
+*/
+static bool row_usable(const run_t *r, uint32_t k, double ts) {
+    const uint32_t d = FOPDT_MAX_DEAD_SAMPLES;
+
+    if(k < d || k + 1 >= r->n || r->y[k + 1] <= 0.0) {
+        return false;
+    }
+    for(uint32_t j = k - d; j <= k; j++) {
+        if(isnan(r->u[j])) {
+            return false;
+        }
+        if(fabs(r->t[j + 1] - r->t[j] - ts) > 0.5 * ts) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * fit_dead() - least squares a, b, c for one dead time
+ *
+ * @return      sum of squared residuals, INFINITY if singular
+*/
+static double fit_dead(const run_t *r, uint32_t d, double ts, double x[3], uint32_t *used, double *y_mean) {
+    double ata[3][3] = { { 0 } }, atb[3] = { 0 }, sse = 0.0, y_sum = 0.0;
+    uint32_t n = 0;
+
+    for(uint32_t k = 0; k + 1 < r->n; k++) {
+        if(!row_usable(r, k, ts)) {
+            continue;
+        }
+        double row[3] = { r->y[k], r->u[k - d], 1.0 };
+        for(int i = 0; i < 3; i++) {
+            for(int j = 0; j < 3; j++) {
+                ata[i][j] += row[i] * row[j];
+            }
+            atb[i] += row[i] * r->y[k + 1];
+        }
+        y_sum += r->y[k];
+        n++;
+    }
+    *used = n;
+    if(n < FOPDT_MIN_ROWS || !solve3(ata, atb, x)) {
+        return INFINITY;
+    }
+    for(uint32_t k = 0; k + 1 < r->n; k++) {
+        if(row_usable(r, k, ts)) {
+            double e = r->y[k + 1] - (x[0] * r->y[k] + x[1] * r->u[k - d] + x[2]);
+            sse += e * e;
+        }
+    }
+    *y_mean = y_sum / n;
+    return sse;
+}
+
+/**
+ * fopdt_fit_csv() - fits one logged run
+ *
+ * @brief       The dead time is the one with the lowest mean squared
+ *              residual. K = b / (1 - a) and y0 = c / (1 - a); a at or
+ *              past 1 is an integrator or unstable fit and is rejected.
+ *              The logs are only 1 Hz, so a motor that settles inside a
+ *              sample gives a near 0 and only bounds tau.
+*/
+int fopdt_fit_csv(const char *path, ptr_fopdt_fit_t fit) {
+    run_t r = { 0 };
+    double best_mse = INFINITY, best_x[3] = { 0 }, best_mean = 0.0;
+    uint32_t best_d = 0, best_used = 0, max_used = 0;
+    int rc;
+
+    memset(fit, 0, sizeof(*fit));
+    rc = run_read(path, &r, &fit->input);
+    fit->rows = r.n;
+    if(rc != 0) {
+        run_free(&r);
+        return rc;
+    }
+    fit->sample_s = run_sample_time(&r);
+
+    for(uint32_t d = 0; d <= FOPDT_MAX_DEAD_SAMPLES && isfinite(fit->sample_s); d++) {
+        double x[3], mean = 0.0;
+        uint32_t used;
+        double sse = fit_dead(&r, d, fit->sample_s, x, &used, &mean);
+
+        if(used > max_used) {
+            max_used = used;
+        }
+        if(isfinite(sse) && sse / used < best_mse) {
+            best_mse = sse / used;
+            best_d = d;
+            best_used = used;
+            best_mean = mean;
+            memcpy(best_x, x, sizeof(x));
+        }
+    }
+    run_free(&r);
+
+    if(max_used < FOPDT_MIN_ROWS) {
+        return -3;
+    }
+    if(!isfinite(best_mse)) {
+        return -4;
+    }
+    if(best_x[0] >= 1.0 || best_x[1] <= 0.0) {
+        return -5;
+    }
+    fit->used = best_used;
+    fit->gain = best_x[1] / (1.0 - best_x[0]);
+    fit->offset = best_x[2] / (1.0 - best_x[0]);
+    fit->tau_bound = best_x[0] < FOPDT_TAU_FLOOR;
+    fit->tau_s = -fit->sample_s / log(fit->tau_bound ? FOPDT_TAU_FLOOR : best_x[0]);
+    fit->dead_s = best_d * fit->sample_s;
+    fit->op_rpm = best_mean;
+    fit->rms_rpm = sqrt(best_mse);
+    return 0;
+}
+
+/**
+ * fopdt_error_str() - what a negative fopdt_fit_csv() code means
+*/
+const char *fopdt_error_str(int code) {
+    switch(code) {
+        case -1: return "cannot read";
+        case -2: return "no duty cycle, pwm or gains columns";
+        case -3: return "too few usable rows";
+        case -4: return "duty never stepped";
+        case -5: return "not a stable first order response";
+        default: return "unknown error";
+    }
+}
+
+/**
+ * fopdt_input_str() - short name of the input source for the report
+*/
+const char *fopdt_input_str(fopdt_input_t input) {
+    switch(input) {
+        case FOPDT_INPUT_DUTY: return "duty";
+        case FOPDT_INPUT_PWM: return "pwm";
+        case FOPDT_INPUT_OPEN_LOOP: return "open";
+        default: return "-";
+    }
+}
@@ -0,0 +1,91 @@
+/**
+ * @file fopdt.h
+ *
+ * @authors Stephen, Drew, Noah
+ * @copyright Portland State University, 2023
+ *
+ * @brief
+ * This is the header file for fitting a first order plus dead time model
+ * to one logged run,
+ *
+ *      tau dy/dt = -y + K u(t - theta) + y0
+ *
+ * with u the duty cycle in % and y the read rpm. Sampled at the log
+ * interval T it is the ARX model
+ *
+ *      y[k+1] = a y[k] + b u[k-d] + c,     a = exp(-T/tau), K = b/(1-a)
+ *
+ * which is linear in a, b and c, so every dead time d is one least squares
+ * solve over all the usable rows at once and the best d wins.
+ *
+ * Only rows where the duty is known are usable: a "duty cycle" or "pwm"
+ * column, or rows logged with every gain at 0, where the firmware of the
+ * time drove duty = set rpm + 4 with no correction.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ * ---------------------
+ * Ver  Who Date    Changes
+ * -----------------------------------
+ * 1.00a DS 17-Oct-2026 First release
+ * </pre>
+************************************************************/
+
+#ifndef FOPDT_H
+#define FOPDT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*********Fit Constants****************************/
+#define FOPDT_MAX_DEAD_SAMPLES      1           // dead times tried, in log samples
+#define FOPDT_MIN_ROWS              8           // fewer usable rows than this is no fit
+#define FOPDT_LEGACY_DUTY_OFFSET    4           // duty = set rpm + 4 before rpm_lut.h
+#define FOPDT_TAU_FLOOR             0.05        // a below this is "settled within a sample"
+
+/*********Fit Types****************************/
+typedef enum fopdt_input {
+    FOPDT_INPUT_NONE = 0,
+    FOPDT_INPUT_DUTY,           // "duty cycle" column, %
+    FOPDT_INPUT_PWM,            // "pwm" column, 10 bit count
+    FOPDT_INPUT_OPEN_LOOP       // set rpm + 4 on rows with all gains 0
+} fopdt_input_t;
+
+typedef struct fopdt_fit {
+    fopdt_input_t input;        // where u came from
+    uint32_t rows;              // data rows in the file
+    uint32_t used;              // rows in the regression
+    double sample_s;            // log interval T
+    double gain;                // K, rpm per % duty
+    double offset;              // y0, rpm (negative: the dead-band)
+    double tau_s;               // time constant
+    bool tau_bound;             // settled inside one sample, tau_s is an upper bound
+    double dead_s;              // dead time, whole samples
+    double op_rpm;              // mean read rpm over the used rows
+    double rms_rpm;             // one step ahead prediction error
+} fopdt_fit_t, *ptr_fopdt_fit_t;
+
+/**
+ * fopdt_fit_csv() - fits one logged run
+ *
+ * @param       path        csv written by plot_display.py
+ * @param       fit         filled in
+ *
+ * @return      0 on success, or a negative code: -1 unreadable, -2 no
+ *              duty, -3 too few usable rows, -4 the duty never moved enough
+ *              to separate K from y0, -5 the fit is not a stable first
+ *              order response
+*/
+int fopdt_fit_csv(const char *path, ptr_fopdt_fit_t fit);
+
+/**
+ * fopdt_error_str() - what a negative fopdt_fit_csv() code means
+*/
+const char *fopdt_error_str(int code);
+
+/**
+ * fopdt_input_str() - short name of the input source for the report
+*/
+const char *fopdt_input_str(fopdt_input_t input);
+
+#endif
@@ -0,0 +1,299 @@
+/**
+ * @file sysid_batch.c
+ *
+ * @authors Stephen, Drew, Noah
+ * @copyright Portland State University, 2023
+ *
+ * @brief
+ * Batch system identification over a directory of logs written by
+ * logger/plot_display.py. Every *.csv is fitted to a first order plus dead
+ * time model (see fopdt.h) on a pool of worker threads, one file at a
+ * time each, and a line per run is printed with K, tau, theta and the
+ * PID gains they give.
+ *
+ * The gains are Ziegler-Nichols reaction curve, the same family as the
+ * relay auto-tuner, turned into the button units update_pid() takes:
+ *      Kp = 1.2 tau / (K theta),  Ti = 2 theta,  Td = theta / 2
+ *      Kp, Ki in tenths = 10 Kp Ts / Ti, Kd = Kp Td / Ts
+ * K is first moved into the PID's units, rpm out per rpm of correction,
+ * through the slope of rpm_lut_to_count() at the run's operating speed.
+ * theta has half a log sample added for the sample and hold, so a run
+ * with no measurable dead time still gives finite gains. Ts is the time
+ * between tach samples at the operating speed, the rate the PID steps at,
+ * unless -step gives one.
+ *
+ * The logs are 1 Hz and the motor settles faster than that, so tau and
+ * theta are mostly upper bounds (marked <=) and the gains conservative.
+ *
+ * usage: sysid_batch [dir] [-j threads] [-step us] [-o report.csv]
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ * ---------------------
+ * Ver  Who Date    Changes
+ * -----------------------------------
+ * 1.00a DS 17-Oct-2026 First release
+ * </pre>
+************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <dirent.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "fopdt.h"
+#include "rpm_lut.h"
+
+#define SYSID_DEFAULT_DIR       "logger/csv"
+#define SYSID_MAX_THREADS       64
+#define SYSID_TICKS_PER_REV     823.13      // tach edges per output rev, 11 CPR x 74.83:1
+#define SYSID_SLOPE_RPM         2           // rpm either side of the operating point for the slope
+#define SYSID_GAIN_MAX          99          // GAIN_MAX in cntrl_logic.c
+
+/** one file and what came out of it */
+typedef struct job {
+    char *path;
+    int rc;
+    fopdt_fit_t fit;
+    double k_pid;               // K in rpm per rpm of PID correction
+    double step_us;             // PID step the gains are for
+    uint32_t kp, ki, kd;        // button units, ki in tenths
+    bool clamped;               // a gain hit SYSID_GAIN_MAX
+} job_t;
+
+typedef struct pool {
+    job_t *jobs;
+    size_t n;
+    size_t next;                // next job to hand out
+    pthread_mutex_t lock;
+} pool_t;
+
+static double step_us_arg = 0.0;
+
+/**
+ * duty_per_rpm() - % duty per rpm of feedforward at an operating speed
+*/
+static double duty_per_rpm(double rpm) {
+    int lo = (int)lround(rpm) - SYSID_SLOPE_RPM;
+    int hi = (int)lround(rpm) + SYSID_SLOPE_RPM;
+
+    if(lo < 0) {
+        lo = 0;
+    }
+    if(hi > RPM_LUT_MAX_RPM) {
+        hi = RPM_LUT_MAX_RPM;
+    }
+    if(hi <= lo) {
+        return 0.0;
+    }
+    return (rpm_lut_to_count(hi) - rpm_lut_to_count(lo)) * 100.0 / RPM_LUT_MAX_COUNT / (hi - lo);
+}
+
+static uint32_t clamp_gain(double g, bool *clamped) {
+    if(g > SYSID_GAIN_MAX) {
+        *clamped = true;
+        return SYSID_GAIN_MAX;
+    }
+    return (uint32_t)lround(g);
+}
+
+/**
+ * tune() - reaction curve gains for a fitted run
+*/
+static void tune(job_t *j) {
+    const fopdt_fit_t *f = &j->fit;
+    double theta = f->dead_s + 0.5 * f->sample_s;
+    double kp, ti, td, ts;
+
+    j->k_pid = f->gain * duty_per_rpm(f->op_rpm);
+    j->step_us = step_us_arg;
+    if(j->step_us <= 0.0) {
+        j->step_us = 60e6 / (SYSID_TICKS_PER_REV * fmax(f->op_rpm, 1.0));
+    }
+    if(j->k_pid <= 0.0) {
+        j->rc = -5;
+        return;
+    }
+    ts = j->step_us * 1e-6;
+    kp = 1.2 * f->tau_s / (j->k_pid * theta);
+    ti = 2.0 * theta;
+    td = 0.5 * theta;
+    j->kp = clamp_gain(kp, &j->clamped);
+    j->ki = clamp_gain(10.0 * kp * ts / ti, &j->clamped);
+    j->kd = clamp_gain(kp * td / ts, &j->clamped);
+}
+
+/**
+ * worker() - takes files off the pool until there are none left
+*/
+static void *worker(void *arg) {
+    pool_t *pool = arg;
+
+    for(;;) {
+        job_t *j;
+
+        pthread_mutex_lock(&pool->lock);
+        j = (pool->next < pool->n) ? &pool->jobs[pool->next++] : NULL;
+        pthread_mutex_unlock(&pool->lock);
+        if(j == NULL) {
+            return NULL;
+        }
+        j->rc = fopdt_fit_csv(j->path, &j->fit);
+        if(j->rc == 0) {
+            tune(j);
+        }
+    }
+}
+
+static int cmp_path(const void *a, const void *b) {
+    return strcmp(((const job_t *)a)->path, ((const job_t *)b)->path);
+}
+
+/**
+ * list_csv() - every *.csv in a directory, sorted
+*/
+static job_t *list_csv(const char *dir, size_t *n) {
+    DIR *dp = opendir(dir);
+    struct dirent *de;
+    job_t *jobs = NULL;
+    size_t cap = 0;
+
+    *n = 0;
+    if(dp == NULL) {
+        return NULL;
+    }
+    while((de = readdir(dp)) != NULL) {
+        size_t len = strlen(de->d_name);
+        if(len < 5 || strcmp(de->d_name + len - 4, ".csv")) {
+            continue;
+        }
+        if(*n == cap) {
+            cap = cap ? cap * 2 : 16;
+            jobs = realloc(jobs, cap * sizeof(*jobs));
+        }
+        memset(&jobs[*n], 0, sizeof(*jobs));
+        jobs[*n].path = malloc(strlen(dir) + len + 2);
+        sprintf(jobs[*n].path, "%s/%s", dir, de->d_name);
+        (*n)++;
+    }
+    closedir(dp);
+    qsort(jobs, *n, sizeof(*jobs), cmp_path);
+    return jobs;
+}
+
+static const char *base_name(const char *path) {
+    const char *s = strrchr(path, '/');
+    return s ? s + 1 : path;
+}
+
+static void print_report(const job_t *jobs, size_t n) {
+    printf("%-34s %5s %4s/%-4s %7s %7s %8s %6s %5s %6s %7s  %s\n",
+           "run", "input", "used", "rows", "K rpm/%", "y0 rpm", "tau s", "theta", "rms",
+           "op rpm", "Ts us", "Kp Ki/10 Kd");
+    for(size_t i = 0; i < n; i++) {
+        const job_t *j = &jobs[i];
+        const fopdt_fit_t *f = &j->fit;
+
+        if(j->rc != 0) {
+            printf("%-34s %5s %4s/%-4u  %s\n", base_name(j->path), fopdt_input_str(f->input),
+                   "-", f->rows, fopdt_error_str(j->rc));
+            continue;
+        }
+        printf("%-34s %5s %4u/%-4u %7.3f %7.1f %2s%6.3f %6.1f %5.2f %6.1f %7.0f  %2u %2u %2u%s\n",
+               base_name(j->path), fopdt_input_str(f->input), f->used, f->rows,
+               f->gain, f->offset, f->tau_bound ? "<=" : "", f->tau_s, f->dead_s,
+               f->rms_rpm, f->op_rpm, j->step_us, j->kp, j->ki, j->kd,
+               j->clamped ? " (clamped)" : "");
+    }
+}
+
+static int write_report(const char *path, const job_t *jobs, size_t n) {
+    FILE *fp = fopen(path, "w");
+
+    if(fp == NULL) {
+        return -1;
+    }
+    fprintf(fp, "run,input,rows,used,status,K,y0,tau,tau bound,theta,rms,op rpm,K pid,Ts us,Kp,Ki,Kd\n");
+    for(size_t i = 0; i < n; i++) {
+        const job_t *j = &jobs[i];
+        const fopdt_fit_t *f = &j->fit;
+
+        fprintf(fp, "%s,%s,%u,%u,%s", base_name(j->path), fopdt_input_str(f->input),
+                f->rows, f->used, j->rc ? fopdt_error_str(j->rc) : "ok");
+        if(j->rc == 0) {
+            fprintf(fp, ",%.5g,%.4g,%.4g,%d,%.4g,%.4g,%.4g,%.4g,%.0f,%u,%u,%u",
+                    f->gain, f->offset, f->tau_s, f->tau_bound, f->dead_s, f->rms_rpm,
+                    f->op_rpm, j->k_pid, j->step_us, j->kp, j->ki, j->kd);
+        }
+        fprintf(fp, "\n");
+    }
+    fclose(fp);
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    const char *dir = SYSID_DEFAULT_DIR;
+    const char *out = NULL;
+    long threads = sysconf(_SC_NPROCESSORS_ONLN);
+    pthread_t tids[SYSID_MAX_THREADS];
+    pool_t pool = { 0 };
+    size_t fitted = 0;
+
+    for(int i = 1; i < argc; i++) {
+        if(!strcmp(argv[i], "-j") && i + 1 < argc) {
+            threads = atol(argv[++i]);
+        }
+        else if(!strcmp(argv[i], "-step") && i + 1 < argc) {
+            step_us_arg = atof(argv[++i]);
+        }
+        else if(!strcmp(argv[i], "-o") && i + 1 < argc) {
+            out = argv[++i];
+        }
+        else if(argv[i][0] != '-') {
+            dir = argv[i];
+        }
+        else {
+            fprintf(stderr, "usage: %s [dir] [-j threads] [-step us] [-o report.csv]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    pool.jobs = list_csv(dir, &pool.n);
+    if(pool.n == 0) {
+        fprintf(stderr, "no .csv files in %s\n", dir);
+        return 1;
+    }
+    if(threads < 1) {
+        threads = 1;
+    }
+    if(threads > SYSID_MAX_THREADS) {
+        threads = SYSID_MAX_THREADS;
+    }
+    if((size_t)threads > pool.n) {
+        threads = (long)pool.n;
+    }
+    pthread_mutex_init(&pool.lock, NULL);
+    for(long t = 0; t < threads; t++) {
+        pthread_create(&tids[t], NULL, worker, &pool);
+    }
+    for(long t = 0; t < threads; t++) {
+        pthread_join(tids[t], NULL);
+    }
+    pthread_mutex_destroy(&pool.lock);
+
+    print_report(pool.jobs, pool.n);
+    for(size_t i = 0; i < pool.n; i++) {
+        fitted += (pool.jobs[i].rc == 0);
+    }
+    printf("%zu of %zu runs fitted on %ld threads\n", fitted, pool.n, threads);
+    if(out != NULL && write_report(out, pool.jobs, pool.n) != 0) {
+        fprintf(stderr, "cannot write %s\n", out);
+    }
+    for(size_t i = 0; i < pool.n; i++) {
+        free(pool.jobs[i].path);
+    }
+    free(pool.jobs);
+    return 0;
+}
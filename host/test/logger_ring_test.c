@@ -0,0 +1,210 @@
+/**
+ * @file logger_ring_test.c
+ *
+ * @authors Stephen, Drew, Noah
+ * @copyright Portland State University, 2023
+ *
+ * @brief
+ * Host test for the logger.c TX ring against the mock uartlite. Every
+ * byte logger_enqueue() takes has to come out of the uartlite once, in
+ * order, and every one it refuses must not come out at all:
+ *  - frames of 1 to 37 bytes, drained a few at a time, so the ring wraps
+ *    many times with frames across the end and the idle UART is kicked
+ *    by every kind of short enqueue
+ *  - filling the ring without letting the UART run, the drop path, the
+ *    sent/dropped counters and the all or nothing length limit
+ *  - the worst case logger_enqueue() time, which must not wait on the
+ *    UART (the model clock does not move) and is printed in host ns
+ *
+ * usage: logger_ring_test, exits non-zero on a failure
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ * ---------------------
+ * Ver  Who Date    Changes
+ * -----------------------------------
+ * 1.00a DS 17-Oct-2026 First release
+ * </pre>
+************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "hal_mock.h"
+#include "logger.h"
+#include "microblaze_sleep.h"
+
+#define TEST_BAUD               921600      // only shortens the model time, the byte order is the same
+#define TEST_FRAMES             2000
+#define TEST_FRAME_MAX          37
+#define TEST_DRAIN_EVERY        5           // frames queued between drains
+#define TEST_TIMING_CALLS       100000
+#define TEST_BYTE_CLOCKS        ((u64)XPAR_CPU_CORE_CLOCK_FREQ_HZ * 10 / TEST_BAUD)
+
+static XIntc intc;
+static u8 expect[LOGGER_TX_RING_SIZE * 2];  // queued and not yet read back
+static u32 expect_len;
+static u8 pattern;                          // next byte to queue
+static u64 worst_ns;
+static int failures;
+
+#define CHECK(cond, ...) do { \
+        if (!(cond)) { \
+            printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+            printf(__VA_ARGS__); \
+            printf("\n"); \
+            failures++; \
+        } \
+    } while (0)
+
+static u64 now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+/**
+ * enqueue() - queues len bytes of the running pattern
+ *
+ * @brief       Keeps what was taken for drain() to compare, and checks
+ *              the call did not wait on the UART.
+ *
+ * @return      true if the ring took them
+*/
+static bool enqueue(u32 len) {
+    u8 buf[LOGGER_TX_RING_SIZE];
+    u64 clocks = mock_clocks();
+
+    for (u32 n = 0; n < len; n++) {
+        buf[n] = pattern + n;
+    }
+    u64 start = now_ns();
+    int status = logger_enqueue(buf, len);
+    u64 ns = now_ns() - start;
+
+    if (ns > worst_ns) {
+        worst_ns = ns;
+    }
+    CHECK(mock_clocks() == clocks, "logger_enqueue() waited on the UART");
+    if (status != XST_SUCCESS) {
+        return false;
+    }
+    memcpy(expect + expect_len, buf, len);
+    expect_len += len;
+    pattern += len;
+    return true;
+}
+
+/**
+ * drain() - runs the UART until everything queued has been sent, and
+ * checks it came out in order
+*/
+static void drain(void) {
+    u8 got[sizeof(expect)];
+    u32 got_len = 0;
+
+    // a few bytes of slack, a kicked UART must not send more than was queued
+    mock_advance_clocks((expect_len + 4) * TEST_BYTE_CLOCKS);
+    got_len = mock_uart_read_tx(got, sizeof(got));
+    CHECK(got_len == expect_len, "sent %u bytes, queued %u", got_len, expect_len);
+    CHECK(memcmp(got, expect, got_len < expect_len ? got_len : expect_len) == 0,
+          "sent bytes differ from the queued ones");
+    expect_len = 0;
+}
+
+/**
+ * test_wrap() - frames of every length through many trips round the ring
+*/
+static void test_wrap(void) {
+    u32 sent = logger_get_sent();
+    u32 dropped = logger_get_dropped();
+
+    for (u32 n = 0; n < TEST_FRAMES; n++) {
+        CHECK(enqueue(n % TEST_FRAME_MAX + 1), "frame %u dropped on a draining ring", n);
+        if (n % TEST_DRAIN_EVERY == TEST_DRAIN_EVERY - 1) {
+            drain();
+        }
+    }
+    drain();
+    CHECK(logger_get_sent() - sent == TEST_FRAMES, "sent counted %u", logger_get_sent() - sent);
+    CHECK(logger_get_dropped() == dropped, "dropped counted %u", logger_get_dropped() - dropped);
+}
+
+/**
+ * test_full() - fills the ring with the UART stopped
+ *
+ * @brief       One slot stays empty and the kick takes one byte out into
+ *              the FIFO, so LOGGER_TX_RING_SIZE single bytes fit. A frame
+ *              longer than the room left is dropped whole.
+*/
+static void test_full(void) {
+    u32 sent = logger_get_sent();
+    u32 dropped = logger_get_dropped();
+    u32 taken = 0;
+
+    while (taken <= LOGGER_TX_RING_SIZE && enqueue(1)) {
+        taken++;
+    }
+    CHECK(taken == LOGGER_TX_RING_SIZE, "took %u single bytes", taken);
+    CHECK(logger_get_dropped() - dropped == 1, "dropped counted %u", logger_get_dropped() - dropped);
+    CHECK(!enqueue(TEST_FRAME_MAX), "frame queued on a full ring");
+    CHECK(logger_get_dropped() - dropped == 2, "dropped counted %u", logger_get_dropped() - dropped);
+    CHECK(logger_get_sent() - sent == taken, "sent counted %u", logger_get_sent() - sent);
+    drain();
+
+    // the most that fits at once, all or nothing
+    dropped = logger_get_dropped();
+    CHECK(!enqueue(LOGGER_TX_RING_SIZE), "a frame the size of the ring was queued");
+    CHECK(logger_get_dropped() - dropped == 1, "dropped counted %u", logger_get_dropped() - dropped);
+    CHECK(enqueue(LOGGER_TX_RING_SIZE - 1), "a ring minus one slot was dropped");
+    drain();
+
+    // a few bytes short of full, the kick has taken one out to the FIFO
+    CHECK(enqueue(LOGGER_TX_RING_SIZE - 4), "queue to 4 short of full");
+    CHECK(!enqueue(5), "5 bytes queued with 4 free");
+    CHECK(enqueue(4), "4 bytes dropped with 4 free");
+    drain();
+}
+
+/**
+ * test_timing() - worst case enqueue of a full size frame, with the ring
+ * draining and with it full so every call takes the drop path
+*/
+static void test_timing(void) {
+    u64 total_ns = 0;
+    u64 start;
+
+    worst_ns = 0;
+    start = now_ns();
+    for (u32 n = 0; n < TEST_TIMING_CALLS; n++) {
+        if (!enqueue(TEST_FRAME_MAX)) {
+            drain();
+        }
+    }
+    total_ns = now_ns() - start;
+    drain();
+    printf("logger_enqueue: %d calls, worst %llu ns, mean %.1f ns with the drains\n",
+           TEST_TIMING_CALLS, (unsigned long long)worst_ns, (double)total_ns / TEST_TIMING_CALLS);
+}
+
+int main(void) {
+    mock_hal_reset();
+    mock_hal_set_console(false);
+    mock_uart_set_baud(TEST_BAUD);
+    if (uartlite_init() != XST_SUCCESS ||
+        XIntc_Initialize(&intc, 0) != XST_SUCCESS ||
+        uartlite_intr_init(&intc) != XST_SUCCESS) {
+        printf("FAIL: uartlite setup\n");
+        return 1;
+    }
+    XIntc_Start(&intc, XIN_REAL_MODE);
+    XIntc_Enable(&intc, UARTLITE_INTR_NUM);
+    microblaze_enable_interrupts();
+
+    test_wrap();
+    test_full();
+    test_timing();
+
+    printf("%s\n", failures ? "logger ring: FAILED" : "logger ring: passed");
+    return failures ? 1 : 0;
+}
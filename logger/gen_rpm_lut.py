@@ -0,0 +1,266 @@
+'''
+    @file gen_rpm_lut.py - generates the duty cycle <-> RPM feedforward tables
+    from the motor characterization
+
+    @authors Stephen, Drew, Noah
+    @copyright Portland State University, 2023
+
+    @brief reads a characterization CSV (time, duty cycle, read rpm, ...)
+           logged with the motor open loop, keeps the samples taken after the
+           duty had been held for at least one sample, and writes a C header
+           with two tables:
+             - 10 bit PWM count -> RPM, one point every 2^COUNT_STEP_LOG2
+               counts, RPM in Q8 so the interpolation keeps a fraction
+             - RPM -> 10 bit PWM count, one point every 2^RPM_STEP_LOG2 rpm
+           plus inline lookups that interpolate between points with a
+           multiply and a shift. The motor does not turn below the
+           break-away duty, so the forward table reads 0 there; the reverse
+           table ramps from 0 up to the slowest steady speed so the PID can
+           still pull the duty down when the motor is running fast.
+    @arguments -csv <characterization CSV> if none given default to
+                    csv/duty_cycle_characterization.csv
+               -outfile <header to write> if none given default to ../src/rpm_lut.h
+'''
+
+import csv
+import os
+import sys
+
+here = os.path.dirname(os.path.abspath(__file__))
+csvfile = os.path.join(here, 'csv', 'duty_cycle_characterization.csv')
+outfile = os.path.join(here, '..', 'src', 'rpm_lut.h')
+
+PWM_RESOLUTION = 1023       # 10 bit PWM count at 100% duty cycle
+COUNT_STEP_LOG2 = 4         # forward table point every 16 counts
+RPM_STEP_LOG2 = 2           # reverse table point every 4 rpm
+RPM_FRAC_BITS = 8           # forward table values are Q8 rpm
+
+
+'''
+    reads the settled (duty %, rpm) samples, the ones where the duty is the
+    same as the sample before
+'''
+def readSettled(filename):
+    samples = {}
+    with open(filename, newline='') as f:
+        reader = csv.reader(f)
+        header = [h.strip() for h in next(reader)]
+        duty_col = header.index('duty cycle')
+        rpm_col = header.index('read rpm')
+        prev_duty = None
+        for row in reader:
+            if len(row) <= max(duty_col, rpm_col):
+                continue
+            duty = float(row[duty_col])
+            rpm = float(row[rpm_col])
+            if duty == prev_duty:
+                samples.setdefault(duty, []).append(rpm)
+            prev_duty = duty
+    return samples
+
+
+'''
+    one point per duty, the median of its samples, forced non-decreasing so
+    the curve can be inverted. Returns (count, rpm) points from the
+    break-away duty up to full scale
+'''
+def buildCurve(samples):
+    points = []
+    top = 0.0
+    breakaway = None
+    for duty in sorted(samples):
+        rpms = sorted(samples[duty])
+        rpm = rpms[len(rpms) // 2]
+        if rpm <= 0.0:
+            continue
+        if breakaway is None:
+            # highest duty it sat still at, at least 1% below the first that moved
+            stuck = [d for d in samples if d < duty and max(samples[d]) <= 0.0]
+            breakaway = max(stuck + [duty - 1])
+            points.append((breakaway * PWM_RESOLUTION / 100.0, 0.0))
+        top = max(top, rpm)
+        points.append((duty * PWM_RESOLUTION / 100.0, top))
+    if len(points) < 3:
+        raise ValueError('not enough settled samples with the motor turning')
+    # carry the slope over the last 10% out to full scale
+    c1, r1 = points[-1]
+    if c1 < PWM_RESOLUTION:
+        c0 = max(points[1][0], c1 - PWM_RESOLUTION / 10.0)
+        slope = (r1 - interp(points, c0)) / (c1 - c0) if c1 > c0 else 0.0
+        points.append((PWM_RESOLUTION, r1 + slope * (PWM_RESOLUTION - c1)))
+    return points
+
+
+def interp(points, x):
+    if x <= points[0][0]:
+        return points[0][1]
+    for (x0, y0), (x1, y1) in zip(points, points[1:]):
+        if x <= x1:
+            return y0 + (y1 - y0) * (x - x0) / (x1 - x0) if x1 > x0 else y1
+    return points[-1][1]
+
+
+'''
+    count -> rpm: 0 below break-away, the curve above it
+'''
+def forwardTable(points):
+    step = 1 << COUNT_STEP_LOG2
+    table = []
+    for count in range(0, PWM_RESOLUTION + step + 1, step):
+        if count <= points[0][0]:
+            rpm = 0.0
+        else:
+            rpm = interp(points, min(count, PWM_RESOLUTION))
+        table.append(int(round(rpm * (1 << RPM_FRAC_BITS))))
+    return table
+
+
+'''
+    rpm -> count: the lowest count that reaches the rpm, a straight line
+    from 0 up to the slowest steady speed, and full scale past the top
+'''
+def reverseTable(points):
+    step = 1 << RPM_STEP_LOG2
+    moving = points[1:]
+    slowest_count, slowest_rpm = moving[0]
+    top_rpm = moving[-1][1]
+    table = []
+    rpm = 0
+    while True:
+        if rpm <= slowest_rpm:
+            count = slowest_count * rpm / slowest_rpm
+        elif rpm >= top_rpm:
+            count = PWM_RESOLUTION
+        else:
+            count = PWM_RESOLUTION
+            for (c0, r0), (c1, r1) in zip(moving, moving[1:]):
+                if r0 <= rpm <= r1 and r1 > r0:
+                    count = c0 + (c1 - c0) * (rpm - r0) / (r1 - r0)
+                    break
+        table.append(int(round(count)))
+        if count >= PWM_RESOLUTION:
+            break
+        rpm += step
+    return table
+
+
+def formatTable(values, per_line=12):
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append('    ' + ', '.join('%5d' % v for v in values[i:i + per_line]) + ',')
+    return '\n'.join(lines)
+
+
+def writeHeader(filename, source, points, fwd, rev):
+    name = os.path.basename(filename)
+    src = os.path.relpath(source, os.path.join(here, '..'))
+    with open(filename, 'w', newline='\n') as f:
+        f.write('''/**
+ * @file %(name)s
+ *
+ * @authors Stephen, Drew, Noah
+ * @copyright Portland State University, 2023
+ *
+ * @brief
+ * Duty cycle <-> RPM feedforward tables. GENERATED by logger/gen_rpm_lut.py
+ * from %(src)s, do not edit by hand - rerun the script after
+ * recharacterizing the motor.
+ *
+ * rpm_lut_from_count() and rpm_lut_to_count() interpolate linearly between
+ * the table points with one multiply and a shift.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ * ---------------------
+ * Ver  Who Date    Changes
+ * -----------------------------------
+ * 1.00a DS 17-Oct-2026 First release
+ * </pre>
+************************************************************/
+
+#ifndef RPM_LUT_H
+#define RPM_LUT_H
+
+#include <stdint.h>
+
+/*********Table Constants****************************/
+#define RPM_LUT_COUNT_STEP_LOG2         %(cstep)d           // forward table point every %(cstepv)d PWM counts
+#define RPM_LUT_RPM_STEP_LOG2           %(rstep)d           // reverse table point every %(rstepv)d rpm
+#define RPM_LUT_FRAC_BITS               %(frac)d           // forward table values are Q%(frac)d rpm
+#define RPM_LUT_MAX_COUNT               %(maxc)d        // 100%% duty cycle
+#define RPM_LUT_MAX_RPM                 %(maxr)d          // rpm at RPM_LUT_MAX_COUNT
+#define RPM_LUT_FWD_SIZE                %(nf)d
+#define RPM_LUT_REV_SIZE                %(nr)d
+
+/*********Tables****************************/
+/** Q%(frac)d rpm at PWM count i << RPM_LUT_COUNT_STEP_LOG2 */
+static const uint16_t rpm_lut_fwd[RPM_LUT_FWD_SIZE] = {
+%(fwd)s
+};
+
+/** PWM count for rpm i << RPM_LUT_RPM_STEP_LOG2 */
+static const uint16_t rpm_lut_rev[RPM_LUT_REV_SIZE] = {
+%(rev)s
+};
+
+/*********Lookups****************************/
+/**
+ * rpm_lut_from_count() - steady state rpm for a 10 bit PWM count, rounded
+*/
+static inline uint8_t rpm_lut_from_count(uint16_t count) {
+    uint32_t idx, frac, rpm_q;
+
+    if(count >= RPM_LUT_MAX_COUNT) {
+        return RPM_LUT_MAX_RPM;
+    }
+    idx = count >> RPM_LUT_COUNT_STEP_LOG2;
+    frac = count & ((1 << RPM_LUT_COUNT_STEP_LOG2) - 1);
+    rpm_q = (rpm_lut_fwd[idx] << RPM_LUT_COUNT_STEP_LOG2)
+          + (rpm_lut_fwd[idx + 1] - rpm_lut_fwd[idx]) * frac;
+    return (uint8_t)((rpm_q + (1 << (RPM_LUT_COUNT_STEP_LOG2 + RPM_LUT_FRAC_BITS - 1)))
+                     >> (RPM_LUT_COUNT_STEP_LOG2 + RPM_LUT_FRAC_BITS));
+}
+
+/**
+ * rpm_lut_to_count() - 10 bit PWM count that runs the motor at an rpm,
+ * full scale for anything past RPM_LUT_MAX_RPM
+*/
+static inline uint16_t rpm_lut_to_count(uint8_t rpm) {
+    uint32_t idx = rpm >> RPM_LUT_RPM_STEP_LOG2;
+    uint32_t frac = rpm & ((1 << RPM_LUT_RPM_STEP_LOG2) - 1);
+
+    if(idx >= RPM_LUT_REV_SIZE - 1) {
+        return RPM_LUT_MAX_COUNT;
+    }
+    return (uint16_t)(rpm_lut_rev[idx]
+                      + (((rpm_lut_rev[idx + 1] - rpm_lut_rev[idx]) * frac) >> RPM_LUT_RPM_STEP_LOG2));
+}
+
+#endif
+''' % {
+            'name': name, 'src': src,
+            'cstep': COUNT_STEP_LOG2, 'cstepv': 1 << COUNT_STEP_LOG2,
+            'rstep': RPM_STEP_LOG2, 'rstepv': 1 << RPM_STEP_LOG2,
+            'frac': RPM_FRAC_BITS, 'maxc': PWM_RESOLUTION,
+            'maxr': int(round(interp(points, PWM_RESOLUTION))),
+            'nf': len(fwd), 'nr': len(rev),
+            'fwd': formatTable(fwd), 'rev': formatTable(rev)})
+
+
+def parseArgs(argv, csvfile, outfile):
+    for i in range(1, len(argv)):
+        if (argv[i] == '-csv'):
+            csvfile = argv[i+1]
+        if (argv[i] == '-outfile'):
+            outfile = argv[i+1]
+    return [csvfile, outfile]
+
+
+if __name__ == '__main__':
+    [csvfile, outfile] = parseArgs(sys.argv, csvfile, outfile)
+    points = buildCurve(readSettled(csvfile))
+    fwd = forwardTable(points)
+    rev = reverseTable(points)
+    writeHeader(outfile, csvfile, points, fwd, rev)
+    print('break-away at count %d, %d forward and %d reverse points written to %s'
+          % (points[0][0], len(fwd), len(rev), outfile))
@@ -7,8 +7,12 @@
 
     @brief this python script plots data printed to console via uartlite
            as well as writes to a CSV file 
+           samples arrive as binary telemetry frames (see src/telemetry.h):
+           payload + CRC-16, COBS encoded and ended by a 0x00 sync byte.
+           anything else on the port is console text and is printed
     @arguments -port <specify port for logging> REQUIRED
                -outfile <specific CSV output file> if none given default to PID_data.csv
+               -baud <uartlite baud rate> if none given default to 9600
 
     Reference to: http://www.mikeburdis.com/wp/notes/plotting-serial-port-data-using-python-and-matplotlib/               
 '''
@@ -21,6 +25,7 @@ import numpy as np
 import serial 
 import sys
 import csv 
+import struct
 
 #serial port
 uartlite = serial.Serial()
@@ -31,6 +36,31 @@ uartlite.timeout  = 10
 #csv file 
 filename = 'PID_data.csv'
 
+#telemetry frame, version 1 payload layout (little endian)
+#version, seq, timestamp us, set rpm, read rpm, Kp, Ki, Kd, pid select,
+#pwm count, error Q16.16, integrator Q16.16
+TELEMETRY_VERSION = 1
+#auto-tune result frame, same size, first byte TELEMETRY_AUTOTUNE
+#type, seq, timestamp us, set rpm, status, relay rpm, Kp, Ki, Kd, reserved,
+#us per PID step, Ku Q16.16, Tu us
+TELEMETRY_AUTOTUNE = 0x41
+AUTOTUNE_FORMAT = '<BBIHBBBBBBHiI'
+TELEMETRY_SYNC = b'\x00'
+PAYLOAD_FORMAT = '<BBIHHBBBBHii'
+PAYLOAD_SIZE = struct.calcsize(PAYLOAD_FORMAT)
+CRC_SIZE = 2
+#COBS adds one code byte for a frame this short
+ENCODED_SIZE = PAYLOAD_SIZE + CRC_SIZE + 1
+Q16_ONE = 65536.0
+US_WRAP = 1 << 32
+
+#device time tracking, the us timestamp wraps every ~71 minutes
+last_us = None
+wrap_us = 0
+start_us = None
+last_seq = None
+lost = 0
+
 #global lists 
 time = []
 Kp = []
@@ -44,45 +74,159 @@ Error = []
 data_display = plt.figure(figsize=(10,5))
 ax = data_display.add_subplot(1,1,1)
 
+#crc16 computes CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF)
+#same as telemetry_crc16() in the firmware
+def crc16(data):
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if (crc & 0x8000) else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+#cobsDecode undoes the COBS encoding, the sync byte must already be removed
+#returns None if the data is not valid COBS
+def cobsDecode(data):
+    out = bytearray()
+    idx = 0
+    while idx < len(data):
+        code = data[idx]
+        if (code == 0 or idx + code > len(data)):
+            return None
+        out += data[idx+1:idx+code]
+        idx += code
+        if (code != 0xFF and idx < len(data)):
+            out.append(0)
+    return bytes(out)
+
+#decodeFrame checks and unpacks one frame
+#returns a dict of the sample, or None if the CRC or version is wrong
+def decodeFrame(encoded):
+    payload = cobsDecode(encoded)
+    if (payload is None or len(payload) != PAYLOAD_SIZE + CRC_SIZE):
+        return None
+    [crc] = struct.unpack('<H', payload[PAYLOAD_SIZE:])
+    if (crc != crc16(payload[:PAYLOAD_SIZE])):
+        return None
+    if (payload[0] == TELEMETRY_AUTOTUNE):
+        fields = struct.unpack(AUTOTUNE_FORMAT, payload[:PAYLOAD_SIZE])
+        return {'autotune': True, 'seq': fields[1], 'timestamp_us': fields[2],
+                'set': fields[3], 'ok': fields[4] == 0, 'relay': fields[5],
+                'Kp': fields[6], 'Ki': fields[7], 'Kd': fields[8],
+                'step_us': fields[10], 'Ku': fields[11] / Q16_ONE, 'Tu_us': fields[12]}
+    fields = struct.unpack(PAYLOAD_FORMAT, payload[:PAYLOAD_SIZE])
+    if (fields[0] != TELEMETRY_VERSION):
+        return None
+    return {'seq': fields[1], 'timestamp_us': fields[2],
+            'set': fields[3], 'read': fields[4],
+            'Kp': fields[5], 'Ki': fields[6], 'Kd': fields[7],
+            'pid_sel': fields[8], 'pwm': fields[9],
+            'error': fields[10] / Q16_ONE, 'integrator': fields[11] / Q16_ONE}
+
+#readFrame reads up to the next sync byte. console text sent before the
+#frame ends up in front of it and is printed
+#returns the decoded sample, or None if there was no valid frame
+def readFrame():
+    chunk = uartlite.read_until(TELEMETRY_SYNC)
+    if (not chunk.endswith(TELEMETRY_SYNC)):
+        return None
+    chunk = chunk[:-1]
+    sample = None
+    if (len(chunk) >= ENCODED_SIZE):
+        sample = decodeFrame(chunk[-ENCODED_SIZE:])
+    text = chunk[:-ENCODED_SIZE] if sample is not None else chunk
+    if (len(text) > 0):
+        print(text.decode(errors='replace'), end="")
+    return sample
+
+#readFrames blocks for one frame then takes everything else already
+#buffered, so a streaming rate above the 10 Hz animation is not left behind
+#returns a list of decoded samples
+def readFrames():
+    samples = []
+    sample = readFrame()
+    if (sample is not None):
+        samples.append(sample)
+    while (uartlite.in_waiting > 0):
+        sample = readFrame()
+        if (sample is not None):
+            samples.append(sample)
+    return samples
+
+#deviceSeconds turns the wrapping us timestamp into seconds since the
+#first sample, and counts frames missing from the sequence numbers
+def deviceSeconds(sample):
+    global last_us, wrap_us, start_us, last_seq, lost
+    if (last_us is not None and sample['timestamp_us'] < last_us):
+        wrap_us += US_WRAP
+    last_us = sample['timestamp_us']
+    if (start_us is None):
+        start_us = last_us
+    if (last_seq is not None):
+        lost += (sample['seq'] - last_seq - 1) & 0xFF
+    last_seq = sample['seq']
+    return (last_us + wrap_us - start_us) / 1e6
+
+#autotuneReport prints an auto-tune result frame. it is not plotted but
+#shares the sequence numbers with the samples
+def autotuneReport(result):
+    global last_seq, lost
+    if (last_seq is not None):
+        lost += (result['seq'] - last_seq - 1) & 0xFF
+    last_seq = result['seq']
+    if (result['ok']):
+        print(f"auto-tune at {result['set']} rpm: Ku = {result['Ku']:.3f}, "
+              f"Tu = {result['Tu_us'] / 1e3:.1f} ms, PID step {result['step_us']} us "
+              f"-> Kp {result['Kp']}, Ki {result['Ki'] / 10}, Kd {result['Kd']}")
+    else:
+        print(f"auto-tune at {result['set']} rpm failed, gains unchanged")
+
 #update data called by the animator 
 #frame interval = 100ms 
 #i is frame number argument passed in by default 
-#because data is read every second 
-#by uartlite specification, add i will 
-#represent seconds  
+#time comes from the device timestamp in each frame
 def updateData(i):
-    data = uartlite.readline()
-    parsed_data = data.split(b' ')
-    #check for control signal
-    if (parsed_data[0] != b'DB'):
-        #if not the control signal, print the uartlite 
-        #message
-        print(data.decode(), end="")
+    samples = readFrames()
+    #no valid frames, any console text has been printed
+    if (len(samples) == 0):
         return 
     #if i is 1000, end the program. 
     if (i == 1000):
         file.close()
         exit() 
 
-    #data format: DB <set rpm> <read rpm> <Kp> <Ki> <Kd>
-    #error calculated 
+    for sample in samples:
+        if ('autotune' in sample):
+            autotuneReport(sample)
+        else:
+            addSample(sample)
+    if (len(time) > 0):
+        plotData()
+
+#addSample writes one sample to the csv and the plot lists
+def addSample(sample):
+    curr_time = deviceSeconds(sample)
+
     #find current metrics for everything 
-    curr_set = int(parsed_data[1]); 
-    curr_read = int(parsed_data[2]); 
-    curr_error = int(parsed_data[1]) - int(parsed_data[2])
-    curr_Kp = int(parsed_data[3]); 
-    curr_Ki = int(parsed_data[4]); 
-    curr_Kd = int(parsed_data[5]); 
+    curr_set = sample['set']
+    curr_read = sample['read']
+    curr_error = curr_set - curr_read
+    curr_Kp = sample['Kp']
+    curr_Ki = sample['Ki']
+    curr_Kd = sample['Kd']
     
     #create new CSV row with current data, and write to csv
-    if (i > 0): 
-        row = [i, curr_set,curr_read, 
-               curr_error, curr_Kp, 
-                curr_Ki, curr_Kd]
-        writer.writerow(row)
+    #the original columns come first so older csv readers still work
+    row = [round(curr_time, 6), curr_set,curr_read, 
+           curr_error, curr_Kp, 
+            curr_Ki, curr_Kd,
+           sample['seq'], sample['timestamp_us'], sample['pwm'],
+           round(sample['error'], 4), round(sample['integrator'], 4)]
+    writer.writerow(row)
   
     #append global lists with the new current value
-    time.append(i)
+    time.append(curr_time)
     Set.append(curr_set)
     Read.append(curr_read)
     Error.append(curr_error)
@@ -90,6 +234,15 @@ def updateData(i):
     Ki.append(curr_Ki)
     Kd.append(curr_Kd)
 
+#plotData redraws the plot from the global lists
+def plotData():
+    curr_set = Set[-1]
+    curr_read = Read[-1]
+    curr_error = Error[-1]
+    curr_Kp = Kp[-1]
+    curr_Ki = Ki[-1]
+    curr_Kd = Kd[-1]
+
     #plot new lists with appending (helped by animator)
     ax.clear()
     ax.plot(time, Set, label=f'set rpm = {curr_set}')
@@ -100,9 +253,9 @@ def updateData(i):
     ax.plot(time, Kd, label=f'Kd = {curr_Kd}')
     
     #allow movable x scale 
-    plt.xlim([0, max(100,i)])
-    plt.ylim([-20,100])
-    plt.title("Paramaters over Time")
+    plt.xlim([0, max(10,time[-1])])
+    plt.ylim([-20,max(100, max(Set), max(Read))])
+    plt.title(f"Paramaters over Time ({lost} frames lost)")
     plt.xlabel("Time in Seconds")
     plt.ylabel("Paramaters")
     plt.locator_params(axis='x', nbins=20)
@@ -120,6 +273,8 @@ def parseArgs(argv, filename):
             status = True
         if (sys.argv[i] == '-outfile'): 
             filename = sys.argv[i+1]
+        if (sys.argv[i] == '-baud'): 
+            uartlite.baudrate = int(sys.argv[i+1])
     return status, filename
 
 #main program. 
@@ -136,11 +291,12 @@ if __name__ == "__main__":
     uartlite.open() #open the uartlite
     file = open(filename, 'w') #open the specified program 
     writer = csv.writer(file) #specifiy the csv ßwrite
-    header = ['time', 'set rpm', 'read rpm', 'error', 'Kp', 'Ki', 'Kd']
+    header = ['time', 'set rpm', 'read rpm', 'error', 'Kp', 'Ki', 'Kd',
+              'seq', 'timestamp us', 'pwm', 'pid error', 'integrator']
     writer.writerow(header) #write the header row for the csv file
 
     #setup the animator function. data_display is the figure, updateData is the function called, 
-    #frame interval is 100ms (must be faster than the sample rate, in this case 1second), 
+    #frame interval is 100ms, every frame that arrived since the last one is drawn, 
     #save count is the number of frames to cache
     graph = animation.FuncAnimation(data_display, updateData, interval=100, save_count=1000)
     plt.show()
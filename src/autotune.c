@@ -0,0 +1,119 @@
+/**
+ * @file autotune.c
+ *
+ * @authors Stephen, Drew, Noah
+ * @copyright Portland State University, 2023
+ *
+ * @brief
+ * This is the source file for the relay auto-tuner. autotune_step() runs
+ * in the control step, so it only compares and adds; the divides happen
+ * once, in autotune_finish(), when the experiment is over.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ * ---------------------
+ * Ver  Who Date    Changes
+ * -----------------------------------
+ * 1.00a DS 17-Oct-2026 First release
+ * </pre>
+************************************************************/
+
+#include "autotune.h"
+
+/**
+ * autotune_finish() - works out Ku, Tu and the gains from the measured cycles
+ *
+ * @brief       Classic Ziegler-Nichols, Kp = 0.6 Ku, Ti = Tu / 2,
+ *              Td = Tu / 8, turned into per step gains for pid_fixed_step():
+ *                  ki = Kp Ts / Ti = 1.2 Ku Ts / Tu
+ *                  kd = Kp Td / Ts = 0.075 Ku Tu / Ts
+ *              The amplitude is half the mean peak-to-peak. Hysteresis is
+ *              left out of Ku, at 1 rpm against a limit cycle of several
+ *              rpm it is inside the tach resolution.
+*/
+static void autotune_finish(ptr_autotune_t at, uint32_t now_us) {
+    uint32_t span_us = now_us - at->measure_us;
+    uint64_t ku;
+
+    if(at->pp_sum == 0 || at->samples == 0) {
+        at->state = AUTOTUNE_FAILED;
+        return;
+    }
+    at->tu_us = span_us / AUTOTUNE_MEASURE_CYCLES;
+    at->ts_us = span_us / at->samples;
+    if(at->ts_us == 0) {
+        at->ts_us = 1;
+    }
+    // a = pp_sum / (2 * cycles), Ku = 4 d / (pi a)
+    ku = (uint64_t)AUTOTUNE_4_OVER_PI_Q16 * AUTOTUNE_RELAY_RPM * 2 * AUTOTUNE_MEASURE_CYCLES
+         / at->pp_sum;
+    if(ku > Q16_MAX) {
+        ku = Q16_MAX;
+    }
+    at->ku = (q16_t)ku;
+    at->kp = (q16_t)(ku * 3 / 5);
+    at->ki = (q16_t)(ku * 6 * at->ts_us / (5 * (uint64_t)at->tu_us));
+    at->kd = (q16_t)(ku * 3 * at->tu_us / (40 * (uint64_t)at->ts_us));
+    at->state = AUTOTUNE_DONE;
+}
+
+/**
+ * autotune_start() - arms the relay experiment around a set speed
+*/
+void autotune_start(ptr_autotune_t at, int32_t set_rpm, uint32_t now_us) {
+    at->set_rpm = set_rpm;
+    at->high = true;
+    at->start_us = now_us;
+    at->measure_us = now_us;
+    at->peak_hi = INT32_MIN;
+    at->peak_lo = INT32_MAX;
+    at->cycles = 0;
+    at->pp_sum = 0;
+    at->samples = 0;
+    at->ku = at->kp = at->ki = at->kd = 0;
+    at->tu_us = at->ts_us = 0;
+    // last, the control step may already be looking at it
+    at->state = AUTOTUNE_RUNNING;
+}
+
+/**
+ * autotune_step() - feeds one speed sample to the relay
+*/
+int32_t autotune_step(ptr_autotune_t at, int32_t read_rpm, uint32_t now_us) {
+    if(at->state != AUTOTUNE_RUNNING) {
+        return 0;
+    }
+    if(now_us - at->start_us > AUTOTUNE_TIMEOUT_US) {
+        at->state = AUTOTUNE_FAILED;
+        return 0;
+    }
+
+    at->samples++;
+    if(read_rpm > at->peak_hi) {
+        at->peak_hi = read_rpm;
+    }
+    if(read_rpm < at->peak_lo) {
+        at->peak_lo = read_rpm;
+    }
+
+    if(at->high && read_rpm > at->set_rpm + AUTOTUNE_HYST_RPM) {
+        at->high = false;
+    }
+    else if(!at->high && read_rpm < at->set_rpm - AUTOTUNE_HYST_RPM) {
+        // back to high closes a cycle
+        at->high = true;
+        at->cycles++;
+        if(at->cycles == AUTOTUNE_SKIP_CYCLES) {
+            at->measure_us = now_us;
+            at->samples = 0;
+        }
+        else if(at->cycles > AUTOTUNE_SKIP_CYCLES) {
+            at->pp_sum += at->peak_hi - at->peak_lo;
+            if(at->cycles == AUTOTUNE_SKIP_CYCLES + AUTOTUNE_MEASURE_CYCLES) {
+                autotune_finish(at, now_us);
+            }
+        }
+        at->peak_hi = at->peak_lo = read_rpm;
+    }
+    return autotune_relay(at);
+}
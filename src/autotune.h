@@ -0,0 +1,100 @@
+/**
+ * @file autotune.h
+ *
+ * @authors Stephen, Drew, Noah
+ * @copyright Portland State University, 2023
+ *
+ * @brief
+ * This is the header file for the relay auto-tuner. While it runs, the
+ * control step drives the motor with a relay around the set speed
+ * (Astrom-Hagglund): set rpm + d while the motor is slow, set rpm - d
+ * once it is fast. The motor settles into a limit cycle whose amplitude a
+ * and period Tu give the ultimate gain Ku = 4d / (pi a), and Ziegler-Nichols
+ * turns Ku and Tu into PID gains for the step rate the tach samples arrive
+ * at.
+ *
+ * The tuner only sees rpm in and rpm out, the same units as the PID, so it
+ * runs on whatever the tach sample source is.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ * ---------------------
+ * Ver  Who Date    Changes
+ * -----------------------------------
+ * 1.00a DS 17-Oct-2026 First release
+ * </pre>
+************************************************************/
+
+#ifndef AUTOTUNE_H
+#define AUTOTUNE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pid_fixed.h"
+
+/*********Auto-Tune Constants****************************/
+#define AUTOTUNE_RELAY_RPM          8           // relay amplitude d, rpm either side of the feedforward
+#define AUTOTUNE_HYST_RPM           1           // speed must pass the set rpm by this much to switch
+#define AUTOTUNE_SKIP_CYCLES        2           // cycles to let the oscillation settle
+#define AUTOTUNE_MEASURE_CYCLES     4           // cycles averaged for a and Tu
+#define AUTOTUNE_TIMEOUT_US         20000000    // give up if it has not finished in 20s
+#define AUTOTUNE_4_OVER_PI_Q16      83443       // round(4 / pi * 2^16)
+
+/*********Auto-Tune Types****************************/
+typedef enum autotune_state {
+    AUTOTUNE_IDLE = 0,
+    AUTOTUNE_RUNNING,
+    AUTOTUNE_DONE,
+    AUTOTUNE_FAILED
+} autotune_state_t;
+
+typedef struct autotune {
+    volatile autotune_state_t state;
+    int32_t set_rpm;            // speed the relay switches around
+    bool high;                  // relay is at set + d
+    uint32_t start_us;          // when the experiment started
+    uint32_t measure_us;        // start of the first measured cycle
+    int32_t peak_hi, peak_lo;   // extremes of the cycle in progress
+    uint32_t cycles;            // relay low -> high switches so far
+    uint32_t pp_sum;            // peak-to-peak rpm summed over the measured cycles
+    uint32_t samples;           // speed samples over the measured cycles
+    // results, valid once state is AUTOTUNE_DONE
+    q16_t ku;                   // ultimate gain, rpm out per rpm error
+    uint32_t tu_us;             // ultimate period
+    uint32_t ts_us;             // mean time between speed samples (PID steps)
+    q16_t kp, ki, kd;           // per PID step gains
+} autotune_t, *ptr_autotune_t;
+
+/**
+ * autotune_start() - arms the relay experiment around a set speed
+ *
+ * @param       at          tuner state
+ * @param       set_rpm     speed to tune at, the motor should be running near it
+ * @param       now_us      device time
+*/
+void autotune_start(ptr_autotune_t at, int32_t set_rpm, uint32_t now_us);
+
+/**
+ * autotune_step() - feeds one speed sample to the relay
+ *
+ * @brief       Call on every new tach sample while the state is
+ *              AUTOTUNE_RUNNING. Moves the state to AUTOTUNE_DONE with the
+ *              results filled in after the last measured cycle, or to
+ *              AUTOTUNE_FAILED on timeout.
+ *
+ * @param       read_rpm    measured speed
+ * @param       now_us      device time of the sample
+ *
+ * @return      rpm to add to the feedforward, +/- AUTOTUNE_RELAY_RPM
+*/
+int32_t autotune_step(ptr_autotune_t at, int32_t read_rpm, uint32_t now_us);
+
+/**
+ * autotune_relay() - relay output without a new sample, for the control
+ * steps in between
+*/
+static inline int32_t autotune_relay(const autotune_t *at) {
+    return at->high ? AUTOTUNE_RELAY_RPM : -AUTOTUNE_RELAY_RPM;
+}
+
+#endif
@@ -14,83 +14,292 @@
  * Ver  Who Date    Changes
  * -----------------------------------
  * 1.00a SW 23-Feb-2023 First release
+ * 1.01a DS 17-Oct-2026 Duty cycle <-> RPM conversions use the generated
+ *                      characterization tables in rpm_lut.h
+ * 1.02a DS 17-Oct-2026 SW14 runs the relay auto-tuner and loads its gains
+ * 1.03a DS 17-Oct-2026 btnR with SW15 on prints the stage profile
+ * 1.04a DS 17-Oct-2026 display() composes both banks and writes them
+ *                      through the sseg.h framebuffer
+ * 1.05a DS 17-Oct-2026 update_pid() consumes the interrupt fed input
+ *                      queue, knob turns are applied as detent counts
+ * 1.06a DS 17-Oct-2026 With HB3_FABRIC_PID the control step configures
+ *                      the myHB3ip fabric PID instead of stepping one
+ * 1.07a DS 17-Oct-2026 Controller state is saved to the warm restart
+ *                      store and resumed after a watchdog reset
+ * 1.08a DS 17-Oct-2026 Step times and the main loop send come from the
+ *                      timebase.h 64 bit clock, not the FIT counter
+ * 1.09a DS 17-Oct-2026 The scheduler sets the main loop send rate, SW15
+ *                      prints the task counters
+ * 1.10a DS 17-Oct-2026 The control step heartbeats the watchdog supervisor
+ * 1.11a DS 17-Oct-2026 The loop itself is a motor_ctrl_t per myHB3ip, the
+ *                      UI works on motor CTRL_UI_MOTOR
+ * 1.12a DS 17-Oct-2026 A motor is a channel of a myHB3ip, multi-channel
+ *                      ones are latched once per step
+ * 1.13a DS 17-Oct-2026 Every motor keeps its own gains and knob count,
+ *                      Switches[13:10] pick the one the UI works on
  * </pre>
 ************************************************************/
 
+#include <string.h>
 #include "cntrl_logic.h"
 #include "logger.h"
 #include "microblaze_sleep.h"
-#include "fit.h" // need access to the counter for sends
+#include "timebase.h"
+#include "pid_fixed.h"
+#include "ctrl_tick.h"
+#include "rpm_lut.h"
+#include "autotune.h"
+#include "profile.h"
+#include "sseg.h"
+#include "input_events.h"
+#include "warm_start.h"
+#include "task_sched.h"
+#include "wdt.h"
+#include "motor_ctrl.h"
 
 /********************Control Constants********************/
 #define CONSTANT_STEP_MASK              0x00003
 #define CONSTANT_SELECT_MASK            0x00007
 #define NBTNS                           5
-#define SPEED_OFF 	                    1			// Duty Cycle of 1% to stop motor
+#define SPEED_OFF 	                    MOTOR_SPEED_OFF	// Duty Cycle of 1% to stop motor
 //#define SPEED_MIN 	                389			// Duty Cycle of 38% is minimum value to get motor to move
 #define SPEED_MIN 	                    454			// Duty Cycle of 45% is minimum motor speed chosen
 //454 so that first rotation of knob sets the motor to 45% 460/1023
 #define SPEED_MAX	                    616		    // Duty Cycle of 60% is max motor speed
 //616 gives 27 rotary counts range
-#define RESOLUTION                      1023        // 10 bit resolution (absolute max duty cycle is 100% at 1023)
 #define SPEED_STEP	                    6			// gives 100 steps between min and max speed ~0.587% Duty Cycle
 #define ROT_BTN                         0x01        // mask for rotary push button
 #define ROT_SW                          0x02        // mask for rotary switch
 #define MIN_RPM                         38
+#define REPORT_SW                       0x8000      // SW15 on prints the control tick stats, and btnR the stage profile
+#define AUTOTUNE_SW                     0x4000      // SW14 on starts a relay auto-tune, off aborts it
+#define GAIN_MAX                        99          // most the buttons and display can show
+#define STREAM_SW_SHIFT                 7           // Switches[9:7] select the telemetry rate
+#define STREAM_SW_MASK                  0x7
+#define MOTOR_SW_SHIFT                  10          // Switches[13:10] pick the motor the UI works on
+#define MOTOR_SW_MASK                   0xF
 
 /********************Local File Variables********************/
-static uint8_t kp, kd, ki;
 enum _const_select {kd_sel, ki_sel, kp_sel};
 static uint8_t const_sel;
-static uint16_t setpoint;
-static bool pwmEnable = true;					// true to enable PWM output
-static uint8_t count = 0;
+static motor_ctrl_t motors[CTRL_NUM_MOTORS];
+static volatile uint8_t ui_motor = CTRL_UI_MOTOR;                   // the one the UI works on
+static motor_ctrl_t *volatile motor = &motors[CTRL_UI_MOTOR];       // &motors[ui_motor]
+static const ptr_motor_ctrl_t warm_motor = &motors[CTRL_UI_MOTOR];  // the one warm restart keeps
+static uint8_t count[CTRL_NUM_MOTORS];                              // knob count per motor
 static bool set_mode = true;
-static bool send_uart_data = false; 
-static bool curr_data_sent = false; 
+static volatile bool send_uart_data = false; 
 static uint8_t PID_control_sel = 0x00;
-static uint8_t set_rpm; 
-static uint8_t read_rpm; 
+static volatile uint32_t step_time_us;         // tb_now_us() at the last control step, low 32 bits
+static volatile uint16_t stream_decimation = 0; // control steps per streamed sample, 0 for 1 Hz
+// Switches[9:7] -> decimation, at CTRL_TICK_HZ 1000: 1 Hz (main loop), 1, 10, 20, 50, 100, 500, 1000 Hz
+static const uint16_t stream_rates[STREAM_SW_MASK + 1] = {0, 1000, 100, 50, 20, 10, 2, 1};
+static telemetry_autotune_t autotune_result;    // last result, sent with the next sample
+static volatile bool autotune_report = false;
+static bool warm_armed = false;                 // state is restored, the control step may save
+static warm_ctrl_t warm_saved;                  // what is in the warm restart store
+static bool regulated = false;                  // back within WARM_REG_BAND_RPM since reset
+static uint8_t regulated_samples = 0;
+
 /**
- * read_user_IO() - reads user IO
+ * load_pid_gains() - pushes every motor's gains into its fixed-point PID
  * 
- * @brief       Function that takes in a user IO struct and updates if state has changed.
- *              Passed along to display/processing system to handle
+ * @brief       Terms not selected by PID_control_sel get a zero gain.
+*/
+static void load_pid_gains(void) {
+    for(uint32_t i = 0; i < CTRL_NUM_MOTORS; i++) {
+        motor_ctrl_load_gains(&motors[i], PID_control_sel);
+    }
+}
+
+/**
+ * save_warm_state() - puts the controller state in the warm restart store
+ * when any of it changed, control step only
+*/
+static void save_warm_state(void) {
+    warm_ctrl_t now = {
+        .kp = warm_motor->kp, .ki = warm_motor->ki, .kd = warm_motor->kd,
+        .pid_sel = PID_control_sel,
+        .count = count[CTRL_UI_MOTOR],
+        .set_mode = set_mode,
+        .pwm_enable = warm_motor->pwm_enable,
+        .reserved = 0,
+        .setpoint = warm_motor->setpoint,
+        .pwm_out = warm_motor->pwm_out,
+        .integrator = warm_motor->pid.integrator,
+        .prev_error = warm_motor->pid.prev_error,
+        .correction = warm_motor->correction
+    };
+
+    if(memcmp(&now, &warm_saved, sizeof(now)) != 0) {
+        warm_start_save(&now);
+        warm_saved = now;
+    }
+}
+
+/**
+ * track_regulation() - times how long after reset the loop is back within
+ * WARM_REG_BAND_RPM of the setpoint, on each new sample until it is
+*/
+static void track_regulation(void) {
+    int32_t error = (int32_t)warm_motor->set_rpm - (int32_t)warm_motor->read_rpm;
+
+    if(warm_motor->setpoint == SPEED_OFF) {
+        regulated_samples = WARM_REG_SAMPLES;   // nothing to regulate
+    }
+    else if(warm_motor->autotune.state == AUTOTUNE_RUNNING) {
+        return;
+    }
+    else if(error <= WARM_REG_BAND_RPM && error >= -WARM_REG_BAND_RPM) {
+        regulated_samples++;
+    }
+    else {
+        regulated_samples = 0;
+    }
+    if(regulated_samples >= WARM_REG_SAMPLES) {
+        regulated = true;
+        warm_start_regulated(step_time_us);
+    }
+}
+
+/**
+ * fill_sample() - copies the current control state into a telemetry sample
  * 
- * @param       pointer to user IO struct
+ * @param       pointer to the sample to fill
+*/
+static void fill_sample(ptr_telemetry_sample_t sample) {
+    sample->timestamp_us = step_time_us;
+    sample->set_rpm = motor->set_rpm;
+    sample->read_rpm = (motor->set_rpm == 0) ? 0 : motor->read_rpm;
+    sample->kp = (PID_control_sel & MOTOR_SEL_P) ? motor->kp : 0; 
+    sample->ki = (PID_control_sel & MOTOR_SEL_I) ? motor->ki : 0; 
+    sample->kd = (PID_control_sel & MOTOR_SEL_D) ? motor->kd : 0; 
+    sample->pid_sel = PID_control_sel | (motor->relay_on ? TELEMETRY_SEL_AUTOTUNE : 0);
+    sample->pwm = motor->pwm_out;
+    sample->error = motor->pid.prev_error;
+    sample->integrator = motor->pid.integrator;
+#if HB3_FABRIC_PID
+    if(motor->fabric_on) {
+        sample->pwm = HB3_getPIDOutput(motor->hb3);
+        sample->error = HB3_getPIDError(motor->hb3);
+        sample->integrator = HB3_getPIDIntegrator(motor->hb3);
+    }
+#endif
+}
+
+/**
+ * gain_from_q16() - rounds a Q16.16 gain scaled by mult to a button gain
+*/
+static uint8_t gain_from_q16(q16_t gain, uint32_t mult) {
+    uint32_t g = ((uint32_t)gain * mult + (Q16_ONE >> 1)) >> Q16_SHIFT;
+    return (g > GAIN_MAX) ? GAIN_MAX : g;
+}
+
+/**
+ * autotune_apply() - loads the gains from a finished auto-tune
  * 
- * @returns     updated user IO struct if anything has changed
+ * @brief       Runs from the main loop. Kp and Kd are whole numbers and
+ *              Ki is in tenths like the buttons, so the gains are rounded
+ *              to what the display can show and the user can still trim
+ *              them from there. Switches to set mode so the new gains are
+ *              on the display, and queues the result for telemetry.
 */
-void read_user_IO(ptr_user_io_t uIO) {
-    uint8_t btns = NX4IO_getBtns();
-    uint16_t sw = NX4IO_getSwitches();
-    uint8_t count = PMODENC544_getRotaryCount();
-    uint8_t encBnSw = PMODENC544_getBtnSwReg();
-
-    // check if push buttons have changed
-    if(uIO->button_state != btns) {
-        uIO->button_state = btns;
-        uIO->has_changed = true;
+static void autotune_apply(void) {
+    autotune_result.timestamp_us = step_time_us;
+    autotune_result.set_rpm = motor->autotune.set_rpm;
+    autotune_result.relay_rpm = AUTOTUNE_RELAY_RPM;
+    if(motor->autotune.state == AUTOTUNE_DONE) {
+        motor->kp = gain_from_q16(motor->autotune.kp, 1);
+        motor->ki = gain_from_q16(motor->autotune.ki, 10);
+        motor->kd = gain_from_q16(motor->autotune.kd, 1);
+        load_pid_gains();
+        set_mode = true;
+        autotune_result.status = TELEMETRY_AUTOTUNE_OK;
+        xil_printf("Auto-tune: Ku %d/65536  Tu %d us  step %d us -> Kp %d  Ki %d/10  Kd %d\r\n",
+                   motor->autotune.ku, motor->autotune.tu_us, motor->autotune.ts_us,
+                   motor->kp, motor->ki, motor->kd);
     }
+    else {
+        autotune_result.status = TELEMETRY_AUTOTUNE_FAILED;
+        xil_printf("Auto-tune: no steady oscillation, gains unchanged\r\n");
+    }
+    autotune_result.kp = motor->kp;
+    autotune_result.ki = motor->ki;
+    autotune_result.kd = motor->kd;
+    autotune_result.ts_us = (motor->autotune.ts_us > UINT16_MAX) ? UINT16_MAX : motor->autotune.ts_us;
+    autotune_result.ku = motor->autotune.ku;
+    autotune_result.tu_us = motor->autotune.tu_us;
+    autotune_report = true;
+    motor->autotune.state = AUTOTUNE_IDLE;
+}
 
-    // check if switches have changed
-    if(uIO->switch_state != sw) {
-        uIO->switch_state = sw;
-        uIO->has_changed = true;
+/**
+ * send_autotune_report() - sends a pending auto-tune result ahead of a
+ * sample, from whichever of the control step or main loop is sending
+*/
+static void send_autotune_report(void) {
+    if(autotune_report) {
+        send_autotune(&autotune_result);
+        autotune_report = false;
     }
+}
 
-    // check if rotary has changed
-    if(uIO->rotary_count != count) {
-        uIO->rotary_count = count;
-        uIO->has_changed = true;
+/**
+ * stream_sample() - sends every stream_decimation'th control step
+ * 
+ * @brief       Runs at the end of the control step, so in tick mode the
+ *              sample goes out from the timer interrupt and the main loop
+ *              does not send at the same time.
+*/
+static void stream_sample(void) {
+    static uint16_t steps = 0;
+    telemetry_sample_t sample;
+
+    if(!send_uart_data || stream_decimation == 0) {
+        steps = 0;
+        return;
     }
+    if(++steps < stream_decimation) {
+        return;
+    }
+    steps = 0;
+    send_autotune_report();
+    fill_sample(&sample);
+    send_data(&sample);
+}
+/**
+ * read_user_IO() - applies the next queued input event
+ * 
+ * @brief       Takes one event from the input queue (input_events.h) and
+ *              folds it into the user IO struct for update_pid(). Nothing
+ *              here goes out on the bus, the nexys4io and PmodENC544
+ *              interrupts already read the new state.
+ * 
+ * @param       pointer to user IO struct
+ * 
+ * @returns     false if there was no event
+*/
+static bool read_user_IO(ptr_user_io_t uIO) {
+    input_event_t ev;
 
-    // check if rotary switch or pbtn has
-    // changed
-    if(uIO->enc_BtnSw_state != encBnSw) {
-        uIO->enc_BtnSw_state = encBnSw;
-        uIO->has_changed = true;
+    if(!input_event_pop(&ev)) {
+        return false;
     }
+    switch(ev.source) {
+        case INPUT_BTNSW:
+            uIO->button_state = (ev.state & NEXYS4IO_ALLBTNS_MASK) >> 16;
+            uIO->switch_state = ev.state & NEXYS4IO_ALLSWITCHES_MASK;
+            break;
+        case INPUT_ROTARY:
+            uIO->rotary_delta = ev.delta;
+            break;
+        case INPUT_ENC_BTNSW:
+            uIO->enc_BtnSw_state = ev.state;
+            break;
+        default:
+            break;
+    }
+    return true;
 }
 
 /**
@@ -105,12 +314,39 @@ void read_user_IO(ptr_user_io_t uIO) {
 void init_IO_struct(ptr_user_io_t uIO) {
     uIO->button_state = 0x00;
     uIO->switch_state = 0x0000;
-    uIO->rotary_count = 0x00;
+    uIO->rotary_delta = 0;
     uIO->enc_BtnSw_state = 0x00;
-    uIO->has_changed = true;
-    ki = kp = kd = 0;
+    // the knob starts at 0, which is off
+    for(uint32_t i = 0; i < CTRL_NUM_MOTORS; i++) {
+        motor_ctrl_init(&motors[i], &HB3_Inst[i / HB3_CHANNELS], i % HB3_CHANNELS);
+    }
     const_sel = kp_sel;
     wdt_crash = false;
+
+    // after a watchdog reset pick up where the loop left off, with the
+    // integrator and the last output so the duty cycle does not jump
+    warm_ctrl_t saved;
+    if(warm_start_get(&saved)) {
+        warm_motor->kp = saved.kp;
+        warm_motor->ki = saved.ki;
+        warm_motor->kd = saved.kd;
+        PID_control_sel = saved.pid_sel;
+        count[CTRL_UI_MOTOR] = saved.count;
+        set_mode = saved.set_mode;
+        warm_motor->pwm_enable = saved.pwm_enable;
+        warm_motor->setpoint = saved.setpoint;
+        warm_motor->set_rpm = (warm_motor->setpoint == SPEED_OFF) ? 0 : rpm_lut_from_count(warm_motor->setpoint);
+        load_pid_gains();
+        warm_motor->pid.integrator = saved.integrator;
+        warm_motor->pid.prev_error = saved.prev_error;
+        warm_motor->correction = saved.correction;
+        warm_motor->pwm_out = saved.pwm_out;
+        HB3_setChannelPWM(warm_motor->hb3, warm_motor->channel, warm_motor->pwm_enable, warm_motor->pwm_out);
+        warm_saved = saved;
+        xil_printf("Warm restart: setpoint %d  Kp %d  Ki %d  Kd %d\r\n", warm_motor->setpoint,
+                   warm_motor->kp, warm_motor->ki, warm_motor->kd);
+    }
+    warm_armed = true;
 }
 
 /**
@@ -120,9 +356,9 @@ void init_IO_struct(ptr_user_io_t uIO) {
  * 
  * @brief       Function that controls the user interfaces for
  *              changing functionality for the PID controller.
- *              Consumes a user IO struct to see if state has changed
- *              in either the switches, buttons, or encoder and
- *              updates for appropriate functionality.
+ *              Consumes the queued input events one at a time, so
+ *              every press and knob detent since the last call is
+ *              seen, and updates for appropriate functionality.
  * 
  * @param       pointer to a user IO struct
 */
@@ -131,13 +367,66 @@ void update_pid(ptr_user_io_t uIO) {
     static uint16_t prev_sw = 0xffff;       // holds previous switches state
     static uint8_t step_val = 1;            // step value for the k-constants
     static uint8_t step_val_enc = 1;        // step value for the set point
-    static uint8_t prev_count = 0xff;       // previous encoder count
     static uint8_t prev_enc_BtnSw = 0xff;   // previous encoder btn/switch state
+    static bool regulated_shown = false;
+
+    // a finished auto-tune is picked up here rather than in the control step
+    if(motor->autotune.state == AUTOTUNE_DONE || motor->autotune.state == AUTOTUNE_FAILED) {
+        autotune_apply();
+    }
+    // time to regulation after a warm restart, printed once
+    if(regulated && !regulated_shown && warm_start_resumed()) {
+        regulated_shown = true;
+        xil_printf("Warm restart: regulating %d us after reset\r\n", warm_start_regulated_us());
+    }
 
-    // if user interface has changed process the change
-    if(uIO->has_changed) {
+    // process each change the interrupts queued
+    while(read_user_IO(uIO)) {
         // if switches have changed process the new switch state
         if(prev_sw != uIO->switch_state) {
+            if(uIO->switch_state & ~prev_sw & REPORT_SW) {
+                ctrl_tick_report();
+                sched_report();
+                wdt_report();
+                xil_printf("Telemetry: sent %d  dropped %d\r\n",
+                           logger_get_sent(), logger_get_dropped());
+                xil_printf("Input events dropped: %d\r\n", input_events_dropped());
+                xil_printf("Regulating %d us after reset%s\r\n", warm_start_regulated_us(),
+                           warm_start_resumed() ? " (warm restart)" : "");
+            }
+#if CTRL_NUM_MOTORS > 1
+            // the buttons, knob, display and telemetry follow Switches[13:10]
+            uint8_t sel = (uIO->switch_state >> MOTOR_SW_SHIFT) & MOTOR_SW_MASK;
+            if(sel < CTRL_NUM_MOTORS && sel != ui_motor) {
+                if(motor->autotune.state != AUTOTUNE_IDLE) {
+                    motor->autotune.state = AUTOTUNE_IDLE;
+                    xil_printf("Auto-tune: aborted, motor changed\r\n");
+                }
+                ui_motor = sel;
+                motor = &motors[sel];
+                xil_printf("UI on motor %d\r\n", sel);
+            }
+#endif
+            if(uIO->switch_state & ~prev_sw & AUTOTUNE_SW) {
+                if(motor->setpoint == SPEED_OFF) {
+                    xil_printf("Auto-tune: set a speed with the knob first\r\n");
+                }
+                else {
+                    xil_printf("Auto-tune: relay +/-%d rpm around %d rpm\r\n",
+                               AUTOTUNE_RELAY_RPM, rpm_lut_from_count(motor->setpoint));
+                    set_mode = false;
+                    autotune_start(&motor->autotune, rpm_lut_from_count(motor->setpoint), step_time_us);
+                }
+            }
+            else if((~uIO->switch_state & prev_sw & AUTOTUNE_SW) &&
+                    motor->autotune.state == AUTOTUNE_RUNNING) {
+                motor->autotune.state = AUTOTUNE_IDLE;
+                xil_printf("Auto-tune: aborted\r\n");
+            }
+            if(((uIO->switch_state ^ prev_sw) >> STREAM_SW_SHIFT) & STREAM_SW_MASK) {
+                stream_decimation = stream_rates[(uIO->switch_state >> STREAM_SW_SHIFT) & STREAM_SW_MASK];
+                xil_printf("Telemetry every %d control steps (0 is once a second)\r\n", stream_decimation);
+            }
             prev_sw = uIO->switch_state;
             // updates the LEDs without interfering with the WDT
             // LED status
@@ -220,6 +509,13 @@ void update_pid(ptr_user_io_t uIO) {
                 // look at the buttons one at a time. If a button was pushed
                 // we run control loop logic
                 if (prev_btn & (btnMask << i)) {
+#ifdef STAGE_PROFILE
+                    // SW15 turns btnR into the profile dump
+                    if((uIO->switch_state & REPORT_SW) && (btnMask << i) == PROF_BTN) {
+                        profile_report();
+                        continue;
+                    }
+#endif
                     // check btn[i] for changes
                     switch (i) {
                         //iterate through the buttons and modify global PID
@@ -246,19 +542,19 @@ void update_pid(ptr_user_io_t uIO) {
                             if(set_mode) { // only do it when we are in set mode
                                 switch(const_sel) { // choice based on FSM state
                                     case kd_sel:
-                                        kd -= step_val;
-                                        if(kd > 99) // we rolled over
-                                            kd = 99;
+                                        motor->kd -= step_val;
+                                        if(motor->kd > 99) // we rolled over
+                                            motor->kd = 99;
                                         break;
                                     case ki_sel:
-                                        ki -= step_val;
-                                        if(ki > 99) // we rolled over
-                                            ki = 99;
+                                        motor->ki -= step_val;
+                                        if(motor->ki > 99) // we rolled over
+                                            motor->ki = 99;
                                         break;
                                     case kp_sel:
-                                        kp -= step_val;
-                                        if(kp > 99) // we rolled over
-                                            kp = 99;
+                                        motor->kp -= step_val;
+                                        if(motor->kp > 99) // we rolled over
+                                            motor->kp = 99;
                                         break;
                                     default:
                                         break;
@@ -270,19 +566,19 @@ void update_pid(ptr_user_io_t uIO) {
                             if(set_mode) { // only do it when we are in set mode
                                 switch(const_sel) { // choice based on FSM state
                                     case kd_sel:
-                                        kd += step_val;
-                                        if(kd > 99) // we rolled over
-                                            kd = 1;
+                                        motor->kd += step_val;
+                                        if(motor->kd > 99) // we rolled over
+                                            motor->kd = 1;
                                         break;
                                     case ki_sel:
-                                        ki += step_val;
-                                        if(ki > 99)  // we rolled over
-                                            ki = 1;
+                                        motor->ki += step_val;
+                                        if(motor->ki > 99)  // we rolled over
+                                            motor->ki = 1;
                                         break;
                                     case kp_sel:
-                                        kp += step_val;
-                                        if(kp > 99)  // we rolled over 
-                                            kp = 1;
+                                        motor->kp += step_val;
+                                        if(motor->kp > 99)  // we rolled over 
+                                            motor->kp = 1;
                                         break;
                                     default:
                                         break;
@@ -301,51 +597,50 @@ void update_pid(ptr_user_io_t uIO) {
             }
         }
         // process knob rotation
-        if(prev_count != uIO->rotary_count) {
-            if((prev_count + 1) == uIO->rotary_count){
-            	count += step_val_enc;
-        	}
-            if((prev_count - 1) == uIO->rotary_count){
-            	count -= step_val_enc;
+        if(uIO->rotary_delta != 0) {
+            // a fast turn comes in as several detents at once
+            count[ui_motor] += uIO->rotary_delta * step_val_enc;
+            uIO->rotary_delta = 0;
+            // the tune is only good for the speed it was started at
+            if(motor->autotune.state == AUTOTUNE_RUNNING) {
+                motor->autotune.state = AUTOTUNE_IDLE;
+                xil_printf("Auto-tune: aborted, setpoint changed\r\n");
             }
-            prev_count = uIO->rotary_count;
-    		if(count == 0){
-    			setpoint = SPEED_OFF;
-    			pwmEnable = false;
+    		if(count[ui_motor] == 0){
+    			motor->setpoint = SPEED_OFF;
+    			motor->pwm_enable = false;
     		}
-    		else if((count > 0) && (count <= 27)){//limit count to MAX_SPEED value
-    			setpoint = SPEED_MIN + (count * SPEED_STEP);
-    			pwmEnable = true;
+    		else if((count[ui_motor] > 0) && (count[ui_motor] <= 27)){//limit count to MAX_SPEED value
+    			motor->setpoint = SPEED_MIN + (count[ui_motor] * SPEED_STEP);
+    			motor->pwm_enable = true;
     		}
     		else{ // if negative count or count rolled over max, reset to 0
-    			PMODENC544_clearRotaryCount();
-    			setpoint = SPEED_OFF;
-    			pwmEnable = false;
-    			count = 0;
-                set_rpm = 0;
+    			input_clear_rotary();
+    			motor->setpoint = SPEED_OFF;
+    			motor->pwm_enable = false;
+    			count[ui_motor] = 0;
+                motor->set_rpm = 0;
     		}
-    		xil_printf("Updated Rotary Count %d, setpoint: %d\r\n", count, setpoint);
+    		xil_printf("Updated Rotary Count %d, setpoint: %d\r\n", count[ui_motor], motor->setpoint);
         }
         // process encoder button or switch
         if(prev_enc_BtnSw != uIO->enc_BtnSw_state){
         	prev_enc_BtnSw = uIO->enc_BtnSw_state;
     		if(prev_enc_BtnSw & ROT_BTN){
-    			PMODENC544_clearRotaryCount(); // set rotary count to 0
-    			setpoint = SPEED_OFF;
-    			pwmEnable = false; // specifically stated in project description
-    			count = 0;
-                kp = 1;
-                kd = ki = 0;
-                set_rpm = 0;  
+    			input_clear_rotary(); // set rotary count to 0
+    			motor->setpoint = SPEED_OFF;
+    			motor->pwm_enable = false; // specifically stated in project description
+    			count[ui_motor] = 0;
+                motor->kp = 1;
+                motor->kd = motor->ki = 0;
+                motor->set_rpm = 0;  
     		}
     		if(prev_enc_BtnSw & ROT_SW) {
     			xil_printf("forced WDT crash\n\r");
                 wdt_crash = true;
             }
         }
-        // change state back to unchanged, want to be in this loop
-        // as little as possible
-        uIO->has_changed = false;
+        load_pid_gains();
     }
 }
 
@@ -358,44 +653,61 @@ void update_pid(ptr_user_io_t uIO) {
  */
 void control_pid()
 {
-    static uint8_t preverror = 0; 
-    static uint8_t i = 0; 
+    control_pid_step();
+}
 
-    if(setpoint == SPEED_OFF)
+/**
+ * control_pid_step
+ * @brief one control step, run from the control tick
+ * steps every motor's controller on its own new sample flag,
+ * set by its myHB3ip new sample interrupt, which also fires
+ * when the window closes on a steady speed or the period
+ * drops to 0 on a stall. A multi-channel myHB3ip is latched
+ * once and gives every channel's speed and flag together
+ * 
+ * @return true if the UI motor had a new measurement
+ */
+bool control_pid_step(void)
+{
+    bool new_sample = false;
+    bool warm_sample = false;
+
+    step_time_us = (uint32_t)tb_now_us();
+    wdt_heartbeat(SCHED_CONTROL);
+    for(uint32_t n = 0; n < HB3_NUM_IP; n++)
     {
-    	set_rpm = 0;
-    	HB3_setPWM(pwmEnable, setpoint); //change the motor speed by set PWM
-        return;
+#if HB3_CHANNELS > 1
+        uint32_t fresh_mask = HB3_latchChannels(&HB3_Inst[n]);
+#else
+        uint32_t fresh_mask = HB3_isNewSample(&HB3_Inst[n]);
+#endif
+
+        for(uint32_t ch = 0; ch < HB3_CHANNELS; ch++)
+        {
+            uint32_t i = n * HB3_CHANNELS + ch;
+            bool fresh = (fresh_mask >> ch) & 1;
+
+            motor_ctrl_step(&motors[i], fresh, step_time_us);
+            if(i == ui_motor)
+            {
+                new_sample = fresh;
+            }
+            if(i == CTRL_UI_MOTOR)
+            {
+                warm_sample = fresh;
+            }
+        }
     }
-    else
+    if(warm_armed)
     {
-        
-        uint8_t i_control = 10; 
-        uint8_t duty_cycle = setpoint_to_duty_cycle(setpoint); 
-        set_rpm = duty_cycle_to_rpm(duty_cycle); 
-        read_rpm = HB3_getRPM(); 
-        int8_t error = set_rpm - read_rpm; 
-        int8_t d = error - preverror; 
-        preverror = error; 
-        i = (error < set_rpm/i_control) ? i + error : 0; 
-
-       
-        int8_t GP = (PID_control_sel && 0x4) ? kp * error : 0;  //proportional control 
-        GP = ((GP > 0) && (GP < 70)) ? GP : 0; 
-        int8_t GI = (PID_control_sel && 0x2) ? (ki/i_control) * i  : 0;     //integral control
-        GI = ((GI > 0) && (GI < 70)) ? GP : 0; 
-        int8_t GD = (PID_control_sel && 0x1) ? kd * d : 0;      //derivative control
-        GD = ((GD > 0) && (GD < 70)) ? GD : 0; 
-
-        uint8_t output_rpm = set_rpm + GP + GI + GD; 
-        uint16_t output_setpoint = setpoint_from_rpm(output_rpm); 
-        // clamp max output to 100% duty cycle
-        if(output_setpoint > RESOLUTION)
+        if(warm_sample && !regulated)
         {
-        	output_setpoint = RESOLUTION;
+            track_regulation();
         }
-        HB3_setPWM(pwmEnable, output_setpoint); //change the motor speed by set PWM
+        save_warm_state();
     }
+    stream_sample();
+    return new_sample;
 }
 
 /**
@@ -404,73 +716,57 @@ void control_pid()
  * @brief       displays either the setpoint and current RPM
  *              when in run mode or shows the Kp/Ki/Kd values
  *              and which will be run during run mode when in
- *              set mode.
+ *              set mode. Both banks are built here and
+ *              sseg_show() only writes the ones that changed.
 */
 void display(void) {
+    uint32_t hi, lo;
+
 	if(!set_mode){ // run mode
-		uint32_t HB3_RPM = HB3_getRPM();
-		// turn off decimal points
-        NX4IO_SSEG_setDecPt(SSEGHI, DIGIT6, false);
-        NX4IO_SSEG_setDecPt(SSEGLO, DIGIT3, false);
-        NX4IO_SSEG_setDecPt(SSEGLO, DIGIT0, false);
         // display read rpm on left and set rpm on right
-	    NX4IO_SSEG_setDigit(SSEGHI, DIGIT7, CC_BLANK);
-	    NX4IO_SSEG_setDigit(SSEGHI, DIGIT6, CC_BLANK);
-	    NX4IO_SSEG_setDigit(SSEGHI, DIGIT5, HB3_RPM/10);
-	    NX4IO_SSEG_setDigit(SSEGHI, DIGIT4, HB3_RPM%10);
-	    NX4IO_SSEG_setDigit(SSEGLO, DIGIT3, CC_BLANK);
-	    NX4IO_SSEG_setDigit(SSEGLO, DIGIT2, CC_BLANK);
-	    NX4IO_SSEG_setDigit(SSEGLO, DIGIT1, set_rpm/10);
-	    NX4IO_SSEG_setDigit(SSEGLO, DIGIT0, set_rpm%10);
+        hi = SSEG_DIGIT(3, CC_BLANK) | SSEG_DIGIT(2, CC_BLANK) | sseg_dec2(motor_ctrl_speed(motor));
+	    // an A in front of the set rpm while the auto-tune relay is running
+        lo = SSEG_DIGIT(3, (motor->autotune.state == AUTOTUNE_RUNNING) ? CC_A : CC_BLANK)
+           | SSEG_DIGIT(2, CC_BLANK) | sseg_dec2(motor->set_rpm);
 	}
 	else{ // set mode -- display K-constants
-	    NX4IO_SSEG_setDigit(SSEGHI, DIGIT7, kp/10);
-	    NX4IO_SSEG_setDigit(SSEGHI, DIGIT6, kp%10);
-	    NX4IO_SSEG_setDigit(SSEGHI, DIGIT5, CC_SPACE);
-	    NX4IO_SSEG_setDigit(SSEGHI, DIGIT4, ki/10);
-	    NX4IO_SSEG_setDigit(SSEGLO, DIGIT3, ki%10);
-	    NX4IO_SSEG_setDigit(SSEGLO, DIGIT2, CC_BLANK);
-	    NX4IO_SSEG_setDigit(SSEGLO, DIGIT1, kd/10);
-	    NX4IO_SSEG_setDigit(SSEGLO, DIGIT0, kd%10);
+        // ki straddles the banks, tens on DIGIT4 and ones on DIGIT3
+        uint32_t ki_digits = sseg_dec2(motor->ki);
+        hi = (sseg_dec2(motor->kp) << (2 * SSEG_DIGIT_BITS)) | SSEG_DIGIT(1, CC_SPACE)
+           | (ki_digits >> SSEG_DIGIT_BITS);
+        lo = ((ki_digits & SSEG_DIGIT(0, 0x3F)) << (3 * SSEG_DIGIT_BITS))
+           | SSEG_DIGIT(2, CC_BLANK) | sseg_dec2(motor->kd);
 	    // display decimal point on selected value to change
 	    if(const_sel == ki_sel) {
-            NX4IO_SSEG_setDecPt(SSEGHI, DIGIT6, false);
-            NX4IO_SSEG_setDecPt(SSEGLO, DIGIT3, true);
-            NX4IO_SSEG_setDecPt(SSEGLO, DIGIT0, false);
+            lo |= SSEG_DP(3);
         }
         else if(const_sel == kp_sel) {
-            NX4IO_SSEG_setDecPt(SSEGHI, DIGIT6, true);
-            NX4IO_SSEG_setDecPt(SSEGLO, DIGIT3, false);
-            NX4IO_SSEG_setDecPt(SSEGLO, DIGIT0, false);
+            hi |= SSEG_DP(2);
         }
         else if(const_sel == kd_sel){
-            NX4IO_SSEG_setDecPt(SSEGHI, DIGIT6, false);
-            NX4IO_SSEG_setDecPt(SSEGLO, DIGIT3, false);
-            NX4IO_SSEG_setDecPt(SSEGLO, DIGIT0, true);
+            lo |= SSEG_DP(0);
         }
 	}
+    sseg_show(hi, lo);
 }
 
 /**
  * send_uartlite_data
- * @brief sends uartlite data every second
- * if BtnL has been changed to true 
+ * @brief sends one uartlite sample, the scheduler runs it
+ * every SCHED_TELEMETRY_PERIOD_US. Only if BtnL has been
+ * changed to true and streaming is off, otherwise the
+ * control step sends
  */
 void send_uartlite_data()
 {
-    if (send_uart_data == true && second_counter == 1 && curr_data_sent == false)
+    if (send_uart_data == true && stream_decimation == 0)
     {   
-        uint8_t send_kp = (PID_control_sel & 0x4) ? kp : 0; 
-        uint8_t send_ki = (PID_control_sel & 0x2) ? ki : 0; 
-        uint8_t send_kd = (PID_control_sel & 0x1) ? kd : 0; 
-        uint8_t send_read_rpm = (set_rpm == 0) ? 0 : read_rpm;
-        send_data(set_rpm, send_read_rpm, send_kp, send_ki, send_kd); 
-        curr_data_sent = true; 
+        telemetry_sample_t sample;
+
+        send_autotune_report();
+        fill_sample(&sample);
+        send_data(&sample); 
     }
-    else if (second_counter != 1)
-    {
-        curr_data_sent = false; 
-    } 
 } 
 
 /**
@@ -482,21 +778,20 @@ void send_uartlite_data()
  */
 uint8_t setpoint_to_duty_cycle(uint16_t setpoint)
 {
-    float duty = (((float)setpoint / RESOLUTION) * 100);
-    uint8_t duty_cycle = (uint8_t)(duty); 
-    return duty_cycle; 
+    return pid_fixed_count_to_duty(setpoint); // (setpoint * 100) / MOTOR_PWM_MAX
 }
 
 /**
  * duty_cycle_to_rpm
- * @brief duty cycle to rpm 
+ * @brief duty cycle to steady state rpm, interpolated from the
+ * characterization table
  * 
  * @param duty_cycle 
  * @return uint8_t 
  */
 uint8_t duty_cycle_to_rpm(uint8_t duty_cycle)
 {
-    return duty_cycle - 4; //from characterization between duty cycle and rpm
+    return rpm_lut_from_count(pid_fixed_duty_to_count(duty_cycle));
 }
 
 /**
@@ -506,8 +801,5 @@ uint8_t duty_cycle_to_rpm(uint8_t duty_cycle)
  */
 uint16_t setpoint_from_rpm(uint8_t rpm)
 {
-    uint8_t duty_cycle = rpm + 4; //from characterization between duty cycle and rpm
-    uint16_t setpoint = (uint16_t)((float)(duty_cycle) / 100 * RESOLUTION); 
-
-    return setpoint; 
+    return rpm_lut_to_count(rpm); // interpolated from the characterization table
 }
@@ -13,6 +13,14 @@
  * Ver  Who Date    Changes
  * -----------------------------------
  * 1.00a SW 23-Feb-2023 First release
+ * 1.01a DS 17-Oct-2026 user IO is fed from the input event queue,
+ *                      read_user_IO() is internal to cntrl_logic.c
+ * 1.02a DS 17-Oct-2026 HB3_FABRIC_PID hands the P/I/D to myHB3ip
+ * 1.03a DS 17-Oct-2026 Added HB3_PWM_CARRIER_HZ
+ * 1.04a DS 17-Oct-2026 One myHB3ip instance per motor, CTRL_NUM_MOTORS of
+ *                      them. control_pid_step() reads the new sample flags
+ * 1.05a DS 17-Oct-2026 HB3_CHANNELS motors per myHB3ip, read through its
+ *                      latched snapshot
  * </pre>
 ************************************************************/
 
@@ -33,30 +41,57 @@
 // Definitions for PMOD Encoder
 #define 	PMODENC_ID 	XPAR_PMODENC544_0_DEVICE_ID
 #define 	PMODENC_BA	XPAR_PMODENC544_0_S00_AXI_BASEADDR
-// Definitions for PMOD HB3
-#define HB3_BA 					XPAR_MYHB3IP_0_S00_AXI_BASEADDR
+// Definitions for PMOD HB3. A myHB3ip runs HB3_CHANNELS motors, its
+// NUM_CHANNELS (1 to 4). Each one added to the block design gets its base
+// address and sample interrupt in the lists and CTRL_NUM_MOTORS goes up by
+// HB3_CHANNELS. Motor i is channel i % HB3_CHANNELS of myHB3ip
+// i / HB3_CHANNELS. With more than one channel the control step latches
+// each myHB3ip once and reads every motor's speed back to back, in place
+// of the new sample interrupt
+#define HB3_CHANNELS            1
+#define CTRL_NUM_MOTORS         1       // a multiple of HB3_CHANNELS
+#define CTRL_UI_MOTOR           0       // the motor the UI starts on and warm restart keeps
+#define HB3_NUM_IP              (CTRL_NUM_MOTORS / HB3_CHANNELS)
+#define HB3_BA_LIST             { XPAR_MYHB3IP_0_S00_AXI_BASEADDR }
+#define HB3_INTR_LIST           { XPAR_MICROBLAZE_0_AXI_INTC_MYHB3IP_0_SAMPLE_IRQ_INTR }
+// PWM carrier set at startup, 0 keeps the ~977 Hz pmodhb3 comes out of
+// reset with. rpm_lut.h was characterized at that carrier and the duty
+// cycle to rpm curve moves with it, so rerun logger/gen_rpm_lut.py on a
+// characterization at the new carrier before setting one (25000 is above
+// hearing)
+#define HB3_PWM_CARRIER_HZ      0
+// 1 reads motor speed from the tach period (new value every tach edge),
+// 0 from the 0.25s tick window
+#define HB3_SPEED_FROM_PERIOD   1
+#if HB3_SPEED_FROM_PERIOD
+#define HB3_SAMPLE_SOURCE       HB3_IRQ_PERIOD
+#define HB3_PID_SOURCE          HB3_PID_SRC_PERIOD
+#else
+#define HB3_SAMPLE_SOURCE       HB3_IRQ_WINDOW
+#define HB3_PID_SOURCE          0
+#endif
+// 1 runs the P/I/D in myHB3ip (pid_accel.v) on every tach sample and the
+// control step only configures it, 0 runs it in pid_fixed.c from the
+// control step. Needs myHB3ip built with PID_ACCEL = 1, which is off by
+// default; sys_init() stops if it is missing
+#ifndef HB3_FABRIC_PID
+#define HB3_FABRIC_PID          0
+#endif
 
 
 /*********Control Structs****************************/
 typedef struct user_io {
     uint8_t button_state;
     uint16_t switch_state;
-    uint8_t rotary_count;
+    int16_t rotary_delta;       // knob detents not yet applied
     uint8_t enc_BtnSw_state;
-    bool has_changed;
 } user_io_t, *ptr_user_io_t;
 
 /***********Shared Global Variables******************/
 bool wdt_crash; // used for the wdt
 
-/**
- * read_user_IO() - reads and returns user IO data
- * 
- * @param       pointer to a user IO struct
- * 
- * @return      updates user IO struct with current data used for updating display values
-*/
-void read_user_IO(ptr_user_io_t uIO);
+/********** AXI Peripheral Instances **********/
+extern hb3_t HB3_Inst[HB3_NUM_IP];     // myHB3ip, HB3_CHANNELS motors each, in sys_init.c
 
 /**
  * init_IO_struct() - setus up IO struct for user
@@ -83,8 +118,10 @@ void update_pid(ptr_user_io_t uIO);
 
 /**
  * send_uartlite_data
- * @brief sends uartlite data every second
- * if BtnL has been changed to true 
+ * @brief sends one uartlite sample, the scheduler runs it
+ * every SCHED_TELEMETRY_PERIOD_US. Only if BtnL has been
+ * changed to true and streaming is off, otherwise the
+ * control step sends
  */
 void send_uartlite_data(); 
 
@@ -99,7 +136,7 @@ uint8_t setpoint_to_duty_cycle(uint16_t setpoint);
 
 /**
  * duty_cycle_to_rpm
- * @brief duty cycle to rpm 
+ * @brief duty cycle to steady state rpm, 0 below the break-away duty
  * 
  * @param duty_cycle 
  * @return uint8_t 
@@ -107,7 +144,8 @@ uint8_t setpoint_to_duty_cycle(uint16_t setpoint);
 uint8_t duty_cycle_to_rpm(uint8_t duty_cycle); 
 
 /**
- * @brief convert from error rpm to setpoint 
+ * @brief convert from rpm to setpoint, the 10 bit PWM count the
+ * characterization says runs the motor at that speed
  * @param rpm  
  * @return uint16_t setpoint 
  */
@@ -120,5 +158,14 @@ uint16_t setpoint_from_rpm(uint8_t rpm);
  */
 void control_pid(); 
 
+/**
+ * control_pid_step
+ * @brief one control step, run from the control tick
+ * steps every motor's controller
+ * 
+ * @return true if the UI motor had a new measurement
+ */
+bool control_pid_step(void); 
+
 
 #endif
@@ -0,0 +1,142 @@
+/**
+ * @file ctrl_tick.c
+ *
+ * @authors Stephen, Drew, Noah
+ * @copyright Portland State University, 2023
+ *
+ * @brief
+ * This is the source file for the fixed-rate control tick. The timer counts
+ * down from CTRL_TICK_PERIOD and auto-reloads, so on entry to the handler
+ * (CTRL_TICK_PERIOD - counter) is how late the step started.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ * ---------------------
+ * Ver  Who Date    Changes
+ * -----------------------------------
+ * 1.00a DS 17-Oct-2026 First release
+ * 1.01a DS 17-Oct-2026 Control step is a profiled stage with STAGE_PROFILE
+ * 1.02a DS 17-Oct-2026 Removed ctrl_tick_timer(), the profiler uses timebase.h
+ * 1.03a DS 17-Oct-2026 The control step reads each motor's new sample flag
+ * </pre>
+************************************************************/
+
+#include "xtmrctr.h"
+#include "xil_printf.h"
+#include "ctrl_tick.h"
+#include "cntrl_logic.h"
+#include "profile.h"
+
+/********** AXI Peripheral Instances **********/
+static XTmrCtr CTRL_TMR_Inst;       // control tick timer instance
+
+/********************Local File Variables********************/
+static volatile ctrl_tick_stats_t tick_stats;
+
+/**
+ * CTRL_TICK_Handler() - control tick timer callback
+ *
+ * @brief       Runs one control step and records how late it started,
+ *              how long it took, and whether it ran into the next tick.
+ *
+ * @note        Called from XTmrCtr_InterruptHandler, registered in
+ *              ctrl_tick_init()
+*/
+static void CTRL_TICK_Handler(void *CallBackRef, u8 TmrCtrNumber) {
+    XTmrCtr *tmr = (XTmrCtr *)CallBackRef;
+    uint32_t count_in = XTmrCtr_GetValue(tmr, TmrCtrNumber);
+    uint32_t latency = CTRL_TICK_PERIOD - count_in;
+    bool fresh;
+
+    PROFILE_STAGE(PROF_CONTROL, fresh = control_pid_step());
+
+    uint32_t count_out = XTmrCtr_GetValue(tmr, TmrCtrNumber);
+    uint32_t exec = count_in - count_out;
+    // the driver only acks the interrupt after we return, so the expired
+    // bit is always set here. A down counter that went up instead means it
+    // reloaded while the step was running
+    if(count_out > count_in) {
+        exec += CTRL_TICK_PERIOD;
+        tick_stats.overruns++;
+    }
+    tick_stats.ticks++;
+    if(fresh) {
+        tick_stats.samples++;
+    }
+    tick_stats.latency_last = latency;
+    if(latency < tick_stats.latency_min) {
+        tick_stats.latency_min = latency;
+    }
+    if(latency > tick_stats.latency_max) {
+        tick_stats.latency_max = latency;
+    }
+    if(exec > tick_stats.exec_max) {
+        tick_stats.exec_max = exec;
+    }
+}
+
+/**
+ * ctrl_tick_init() - sets up the control tick timer and connects its handler
+ *
+ * @param       pointer to the initialized interrupt controller
+ *
+ * @return      XST_SUCCESS if the timer is ready to start
+*/
+int ctrl_tick_init(XIntc *intc) {
+    int status;
+
+    status = XTmrCtr_Initialize(&CTRL_TMR_Inst, CTRL_TMR_DEVICE_ID);
+    if(status != XST_SUCCESS) {
+        return XST_FAILURE;
+    }
+
+    status = XIntc_Connect(intc, CTRL_TMR_INTR_NUM,
+                           (XInterruptHandler)XTmrCtr_InterruptHandler,
+                           (void *)&CTRL_TMR_Inst);
+    if(status != XST_SUCCESS) {
+        return XST_FAILURE;
+    }
+
+    XTmrCtr_SetHandler(&CTRL_TMR_Inst, CTRL_TICK_Handler, &CTRL_TMR_Inst);
+    XTmrCtr_SetOptions(&CTRL_TMR_Inst, CTRL_TMR_NUM,
+                       XTC_INT_MODE_OPTION | XTC_AUTO_RELOAD_OPTION | XTC_DOWN_COUNT_OPTION);
+    XTmrCtr_SetResetValue(&CTRL_TMR_Inst, CTRL_TMR_NUM, CTRL_TICK_PERIOD);
+
+    tick_stats.latency_min = UINT32_MAX;
+    return XST_SUCCESS;
+}
+
+/**
+ * ctrl_tick_start() - starts the control tick
+*/
+void ctrl_tick_start(void) {
+    XTmrCtr_Start(&CTRL_TMR_Inst, CTRL_TMR_NUM);
+}
+
+/**
+ * ctrl_tick_get_stats() - copies out the jitter and overrun counters
+ *
+ * @param       pointer to a stats struct to fill
+*/
+void ctrl_tick_get_stats(ptr_ctrl_tick_stats_t stats) {
+    stats->ticks = tick_stats.ticks;
+    stats->samples = tick_stats.samples;
+    stats->overruns = tick_stats.overruns;
+    stats->latency_last = tick_stats.latency_last;
+    stats->latency_min = tick_stats.latency_min;
+    stats->latency_max = tick_stats.latency_max;
+    stats->exec_max = tick_stats.exec_max;
+}
+
+/**
+ * ctrl_tick_report() - prints the jitter and overrun counters to the console
+*/
+void ctrl_tick_report(void) {
+    ctrl_tick_stats_t stats;
+
+    ctrl_tick_get_stats(&stats);
+    xil_printf("Control tick @ %d Hz: ticks %d  samples %d  overruns %d\r\n",
+               CTRL_TICK_HZ, stats.ticks, stats.samples, stats.overruns);
+    xil_printf("  latency (clks) last %d  min %d  max %d   step max %d\r\n",
+               stats.latency_last, stats.latency_min, stats.latency_max, stats.exec_max);
+}
@@ -0,0 +1,85 @@
+/**
+ * @file ctrl_tick.h
+ *
+ * @authors Stephen, Drew, Noah
+ * @copyright Portland State University, 2023
+ *
+ * @brief
+ * This is the header file for the fixed-rate control tick. An AXI timer
+ * interrupt runs the control step at CTRL_TICK_HZ so the control rate no
+ * longer depends on how long the rest of the main loop takes.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ * ---------------------
+ * Ver  Who Date    Changes
+ * -----------------------------------
+ * 1.00a DS 17-Oct-2026 First release
+ * 1.01a DS 17-Oct-2026 Hand out the timer instance for timer 1
+ * 1.02a DS 17-Oct-2026 Timer 1 is free again, the profiler uses timebase.h
+ * </pre>
+************************************************************/
+
+#ifndef CTRL_TICK_H
+#define CTRL_TICK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "xparameters.h"
+#include "xstatus.h"
+#include "xintc.h"
+#include "xtmrctr.h"
+
+/*********Peripheral Device Constants****************************/
+// Definitions for the AXI timer driving the control tick - timer 0 of
+// axi_timer_0, 100 MHz input clock
+#define CTRL_TMR_DEVICE_ID          XPAR_TMRCTR_0_DEVICE_ID
+#define CTRL_TMR_INTR_NUM           XPAR_MICROBLAZE_0_AXI_INTC_AXI_TIMER_0_INTERRUPT_INTR
+#define CTRL_TMR_CLOCK_FREQ_HZ      XPAR_TMRCTR_0_CLOCK_FREQ_HZ
+#define CTRL_TMR_NUM                0
+
+/*********Control Tick Configuration****************************/
+// 1 runs control_pid_step() from the timer interrupt, 0 runs control_pid()
+// once per pass of the main loop like the original firmware
+#define CTRL_TICK_MODE              1
+#define CTRL_TICK_HZ                1000        // control step rate
+#define CTRL_TICK_PERIOD            (CTRL_TMR_CLOCK_FREQ_HZ / CTRL_TICK_HZ)
+
+/*********Control Tick Structs****************************/
+typedef struct ctrl_tick_stats {
+    uint32_t ticks;             // timer interrupts serviced
+    uint32_t samples;           // ticks that ran the P/I/D update
+    uint32_t overruns;          // ticks where the step outlasted the period
+    uint32_t latency_last;      // timer expiry to step start, in clocks
+    uint32_t latency_min;
+    uint32_t latency_max;
+    uint32_t exec_max;          // longest step, in clocks
+} ctrl_tick_stats_t, *ptr_ctrl_tick_stats_t;
+
+/**
+ * ctrl_tick_init() - sets up the control tick timer and connects its handler
+ *
+ * @param       pointer to the initialized interrupt controller
+ *
+ * @return      XST_SUCCESS if the timer is ready to start
+*/
+int ctrl_tick_init(XIntc *intc);
+
+/**
+ * ctrl_tick_start() - starts the control tick
+*/
+void ctrl_tick_start(void);
+
+/**
+ * ctrl_tick_get_stats() - copies out the jitter and overrun counters
+ *
+ * @param       pointer to a stats struct to fill
+*/
+void ctrl_tick_get_stats(ptr_ctrl_tick_stats_t stats);
+
+/**
+ * ctrl_tick_report() - prints the jitter and overrun counters to the console
+*/
+void ctrl_tick_report(void);
+
+#endif
@@ -13,18 +13,24 @@
  * Ver  Who Date    Changes
  * -----------------------------------
  * 1.00a SW 23-Feb-2023 First release
+ * 1.01a DS 17-Oct-2026 dp7 goes through the sseg.h framebuffer
+ * 1.02a DS 17-Oct-2026 Only the heartbeat, timing is in timebase.h
+ * 1.03a DS 17-Oct-2026 Runs the wdt.h task heartbeat check
  * </pre>
 ************************************************************/
 
 #include <stdbool.h>
 #include <stdint.h>
 #include "fit.h"
+#include "sseg.h"
+#include "wdt.h"
 
 /**
  * FIT_Handler() - Fixed Interval interrupt handler
  * 
  * Blinks dp7 every 0.5 seconds, as proof to the systems operation.
- * Will stop if watchdog timer fails
+ * Will stop if watchdog timer fails. Also checks the task heartbeats,
+ * from here so a hung main loop cannot skip the check
  * 
  * @note    Registered in sys_init.c
  * 
@@ -37,13 +43,9 @@ void FIT_Handler(void) {
     if (!isInitialized) {
         dpOn = true;
         isInitialized = true;
-        second_counter = 0; 
     }
 
     dpOn = (dpOn) ? false : true;
-    NX4IO_SSEG_setDecPt (SSEGHI, DIGIT7, dpOn);
-
-    second_counter++; 
-    if (second_counter == 2)//4)
-        second_counter = 0;
+    sseg_set_heartbeat(dpOn); // shown by the next display()
+    wdt_supervise();
 }
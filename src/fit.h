@@ -13,6 +13,7 @@
  * Ver  Who Date    Changes
  * -----------------------------------
  * 1.00a SW 23-Feb-2023 First release
+ * 1.01a DS 17-Oct-2026 second_counter replaced by timebase.h
  * </pre>
 ************************************************************/
 
@@ -29,8 +30,6 @@
 #define FIT_CLOCK_FREQ_HZ		4
 #define FIT_INTR_NUM			XPAR_MICROBLAZE_0_AXI_INTC_FIT_TIMER_0_INTERRUPT_INTR
 
-uint8_t second_counter;
-
 /**
  * FIT_Handler() - blinks heartbeat LED every 0.25 seconds
  * 
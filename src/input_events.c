@@ -0,0 +1,157 @@
+/**
+ * @file input_events.c
+ *
+ * @authors Stephen, Drew, Noah
+ * @copyright Portland State University, 2023
+ *
+ * @brief
+ * This is the source file for the interrupt driven user input queue. See
+ * input_events.h.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ * ---------------------
+ * Ver  Who Date    Changes
+ * -----------------------------------
+ * 1.00a DS 17-Oct-2026 First release
+ * </pre>
+************************************************************/
+
+#include "input_events.h"
+#include "nexys4io.h"
+#include "PmodENC544.h"
+#include "timebase.h"
+
+/*********Local Constants****************************/
+#define INPUT_DELTA_MAX             INT16_MAX
+
+/********************Local File Variables********************/
+static input_event_t evq[INPUT_EVQ_SIZE];
+static volatile uint32_t evq_head = 0;     // next free slot, written by the handlers only
+static volatile uint32_t evq_tail = 0;     // next event to take, written by the main loop only
+static volatile uint32_t evq_dropped = 0;
+static uint32_t last_count = 0;            // encoder count at the last rotary event
+static XIntc *input_intc;
+
+/**
+ * evq_push() - queues one event, from a handler
+*/
+static void evq_push(input_source_t source, uint32_t state, int16_t delta) {
+    uint32_t head = evq_head;
+    uint32_t next = (head + 1) & INPUT_EVQ_MASK;
+
+    if(next == evq_tail) {
+        evq_dropped++;
+        return;
+    }
+    evq[head].time_us = (uint32_t)tb_now_us();
+    evq[head].source = source;
+    evq[head].state = state;
+    evq[head].delta = delta;
+    evq_head = next;
+}
+
+/**
+ * n4io_handler() - nexys4io input_irq, a button or switch changed
+*/
+static void n4io_handler(void *CallBackRef) {
+    // acknowledge first so a change after the read interrupts again
+    if(NX4IO_ackInputInterrupt()) {
+        evq_push(INPUT_BTNSW, NX4IO_getBTNSW_IN(), 0);
+    }
+}
+
+/**
+ * enc_handler() - PmodENC544 enc_irq, the knob moved or its button or
+ * switch changed
+ *
+ * @brief       The knob is sent as the count moved since the last rotary
+ *              event, so detents that came in while this was held off are
+ *              not lost.
+*/
+static void enc_handler(void *CallBackRef) {
+    ptr_pmodenc544_t enc = (ptr_pmodenc544_t)CallBackRef;
+    uint32_t status = PMODENC544_ackInterrupt(enc);
+
+    if(status & PMODENC544_IRQ_ROTARY) {
+        uint32_t count = PMODENC544_getRotaryCount(enc);
+        int32_t delta = (int32_t)(count - last_count);
+
+        if(delta > INPUT_DELTA_MAX) {
+            delta = INPUT_DELTA_MAX;
+        }
+        else if(delta < -INPUT_DELTA_MAX) {
+            delta = -INPUT_DELTA_MAX;
+        }
+        last_count = count;
+        if(delta != 0) {
+            evq_push(INPUT_ROTARY, count, delta);
+        }
+    }
+    if(status & PMODENC544_IRQ_BTNSW) {
+        evq_push(INPUT_ENC_BTNSW, PMODENC544_getBtnSwReg(enc), 0);
+    }
+}
+
+/**
+ * input_events_init() - connects the nexys4io and PmodENC544 handlers
+*/
+int input_events_init(XIntc *intc) {
+    int status;
+
+    input_intc = intc;
+    status = XIntc_Connect(intc, INPUT_N4IO_INTR_NUM, (XInterruptHandler)n4io_handler, (void *)0);
+    if(status != XST_SUCCESS) {
+        return XST_FAILURE;
+    }
+    return XIntc_Connect(intc, INPUT_ENC_INTR_NUM, (XInterruptHandler)enc_handler, &ENC_Inst);
+}
+
+/**
+ * input_events_start() - queues the current inputs and turns on both
+ * interrupts
+*/
+void input_events_start(void) {
+    // enabling drops anything already latched, so a change from here on
+    // comes after the state read below and is queued behind it
+    NX4IO_enableInputInterrupt(true);
+    PMODENC544_enableInterrupt(&ENC_Inst, PMODENC544_IRQ_ROTARY | PMODENC544_IRQ_BTNSW);
+
+    // interrupts are still off in system_init(), so this is the only producer
+    last_count = PMODENC544_getRotaryCount(&ENC_Inst);
+    evq_push(INPUT_BTNSW, NX4IO_getBTNSW_IN(), 0);
+    evq_push(INPUT_ENC_BTNSW, PMODENC544_getBtnSwReg(&ENC_Inst), 0);
+    XIntc_Enable(input_intc, INPUT_N4IO_INTR_NUM);
+    XIntc_Enable(input_intc, INPUT_ENC_INTR_NUM);
+}
+
+/**
+ * input_event_pop() - takes the oldest event, main loop only
+*/
+bool input_event_pop(ptr_input_event_t ev) {
+    uint32_t tail = evq_tail;
+
+    if(tail == evq_head) {
+        return false;
+    }
+    *ev = evq[tail];
+    evq_tail = (tail + 1) & INPUT_EVQ_MASK;
+    return true;
+}
+
+/**
+ * input_clear_rotary() - zeroes the encoder count
+*/
+void input_clear_rotary(void) {
+    XIntc_Disable(input_intc, INPUT_ENC_INTR_NUM);
+    PMODENC544_clearRotaryCount(&ENC_Inst);
+    last_count = 0;
+    XIntc_Enable(input_intc, INPUT_ENC_INTR_NUM);
+}
+
+/**
+ * input_events_dropped() - events lost to a full queue
+*/
+uint32_t input_events_dropped(void) {
+    return evq_dropped;
+}
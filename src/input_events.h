@@ -0,0 +1,102 @@
+/**
+ * @file input_events.h
+ *
+ * @authors Stephen, Drew, Noah
+ * @copyright Portland State University, 2023
+ *
+ * @brief
+ * This is the header file for the interrupt driven user input queue.
+ * nexys4io raises input_irq when the debounced buttons or switches change
+ * and PmodENC544 raises enc_irq once per knob detent or when its button or
+ * switch changes. The handlers read the new state and push it as a
+ * timestamped event; update_pid() pops them from the main loop, so nothing
+ * polls the inputs and every detent between two passes is counted.
+ *
+ * The queue is a single producer/single consumer ring. Both handlers run
+ * with interrupts off, so between them they are one producer and only
+ * move evq_head; the main loop only moves evq_tail.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ * ---------------------
+ * Ver  Who Date    Changes
+ * -----------------------------------
+ * 1.00a DS 17-Oct-2026 First release
+ * </pre>
+************************************************************/
+
+#ifndef INPUT_EVENTS_H
+#define INPUT_EVENTS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "xparameters.h"
+#include "xstatus.h"
+#include "xintc.h"
+#include "PmodENC544.h"
+
+/*********Peripheral Device Constants****************************/
+#define INPUT_N4IO_INTR_NUM         XPAR_MICROBLAZE_0_AXI_INTC_NEXYS4IO_0_INPUT_IRQ_INTR
+#define INPUT_ENC_INTR_NUM          XPAR_MICROBLAZE_0_AXI_INTC_PMODENC544_0_ENC_IRQ_INTR
+
+/*********Input Queue Constants****************************/
+// must be a power of 2, one slot is always left empty
+#define INPUT_EVQ_SIZE              32
+#define INPUT_EVQ_MASK              (INPUT_EVQ_SIZE - 1)
+
+/*********Input Event Structs****************************/
+typedef enum input_source {
+    INPUT_BTNSW = 0,            // Nexys A7 buttons and switches, state is BTNSW_IN
+    INPUT_ROTARY,               // knob turned, delta is the detents since the last one
+    INPUT_ENC_BTNSW             // PmodENC button/switch, state is ROT_BTN | ROT_SW
+} input_source_t;
+
+typedef struct input_event {
+    uint32_t time_us;           // tb_now_us() when the handler ran, low 32 bits
+    uint32_t state;
+    int16_t delta;
+    uint8_t source;
+} input_event_t, *ptr_input_event_t;
+
+/********** AXI Peripheral Instances **********/
+extern pmodenc544_t ENC_Inst;   // PmodENC544, defined and initialized in sys_init.c
+
+/**
+ * input_events_init() - connects the nexys4io and PmodENC544 handlers
+ *
+ * @param       intc        interrupt controller, not started yet
+ *
+ * @return      XST_SUCCESS if both handlers are connected
+*/
+int input_events_init(XIntc *intc);
+
+/**
+ * input_events_start() - queues the current inputs and turns on both
+ * interrupts
+ *
+ * @brief       The first events carry the state at power up, so the
+ *              switch settings are applied without anything changing.
+*/
+void input_events_start(void);
+
+/**
+ * input_event_pop() - takes the oldest event, main loop only
+ *
+ * @return      false if the queue is empty
+*/
+bool input_event_pop(ptr_input_event_t ev);
+
+/**
+ * input_clear_rotary() - zeroes the encoder count
+ *
+ * @brief       Use this rather than PMODENC544_clearRotaryCount() so the
+ *              handler's last count is zeroed with it.
+*/
+void input_clear_rotary(void);
+
+/**
+ * input_events_dropped() - events lost to a full queue
+*/
+uint32_t input_events_dropped(void);
+
+#endif
@@ -7,68 +7,186 @@
  * @brief
  * This is the source file for the uartlite to graphing functionality 
  * 
+ * send_data() only copies a sample into a single producer/single consumer
+ * ring buffer. The uartlite interrupt, which fires when the TX FIFO goes
+ * empty, refills the FIFO from the ring. The main loop only ever moves
+ * tx_head and the interrupt only ever moves tx_tail, so neither needs a
+ * lock. If the ring has no room the whole sample is dropped and counted
+ * instead of waiting on the 9600 baud link.
+ * 
  * <pre>
  * MODIFICATION HISTORY:
  * ---------------------
  * Ver  Who Date    Changes
  * -----------------------------------
  * 1.00a SW 23-Feb-2023 First release
+ * 1.01a DS 17-Oct-2026 Interrupt driven TX ring buffer, send_data() no longer blocks
+ * 1.02a DS 17-Oct-2026 send_data() sends a binary telemetry frame
+ * 1.03a DS 17-Oct-2026 send_autotune() for the auto-tune result frame
+ * 1.04a DS 17-Oct-2026 logger_time_us() replaced by timebase.h
+ * 1.05a DS 17-Oct-2026 Only kick the UART when the ring still has bytes,
+ *                      the handler leaves an idle UART alone
+ * 1.06a DS 17-Oct-2026 The kick runs with the uartlite interrupt masked
  * </pre>
 ************************************************************/
+#include <stdbool.h>
 #include "logger.h"
+#include "xuartlite_l.h"
+#include "timebase.h"
 
 XUartLite UartLite;		/* Instance of the UartLite Device */
-uint8_t ControlBuffer[CONTROL_BUFFER_SIZE] = {'D', 'B', ' '};
-uint8_t DataBuffer[DATA_BUFFER_SIZE];	/* Buffer for Transmitting Data */
+
+static uint8_t tx_ring[LOGGER_TX_RING_SIZE];
+static volatile uint32_t tx_head = 0;      // next free slot, written by the main loop only
+static volatile uint32_t tx_tail = 0;      // next byte to send, written by whoever owns the UART
+static volatile bool tx_busy = false;      // the interrupt owns the UART until the ring drains
+static volatile uint32_t tx_sent = 0;
+static volatile uint32_t tx_dropped = 0;
+static uint8_t tx_seq = 0;
+static XIntc *tx_intc = NULL;              // set once the handler is connected
 
 /**
- * @function send_data
- * @brief sends data to console using
- * polled uartlite methodology 
+ * @function uartlite_handler
+ * @brief TX FIFO empty (or RX data) interrupt
+ * refills the TX FIFO from the ring. When the ring is empty the
+ * UART is handed back to the main loop to restart
+ */
+static void uartlite_handler(void *CallBackRef)
+{
+    uint32_t tail = tx_tail;
+
+    // nothing listens on RX, drain it so it does not hold the interrupt
+    while (XUartLite_GetStatusReg(UARTLITE_BASEADDR) & XUL_SR_RX_FIFO_VALID_DATA)
+    {
+        (void)XUartLite_ReadReg(UARTLITE_BASEADDR, XUL_RX_FIFO_OFFSET);
+    }
+
+    // an RX interrupt while the UART is idle leaves tx_tail to the sender
+    if (!tx_busy)
+    {
+        return;
+    }
+
+    while (tail != tx_head &&
+           !(XUartLite_GetStatusReg(UARTLITE_BASEADDR) & XUL_SR_TX_FIFO_FULL))
+    {
+        XUartLite_WriteReg(UARTLITE_BASEADDR, XUL_TX_FIFO_OFFSET, tx_ring[tail]);
+        tail = (tail + 1) & LOGGER_TX_RING_MASK;
+    }
+    tx_tail = tail;
+
+    // the interrupt only comes back once the FIFO empties, so if nothing
+    // is left the main loop has to kick the next transfer
+    if (tail == tx_head)
+    {
+        tx_busy = false;
+    }
+}
+
+/**
+ * @function logger_enqueue
+ * @brief copies bytes into the TX ring, never blocks
+ * 
+ * @param data bytes to send
+ * @param len number of bytes
+ * 
+ * @return XST_SUCCESS, or XST_FAILURE if there was no room
+ * and nothing was queued
  */
-void send_data(uint8_t set_rpm, uint8_t read_rpm, uint8_t Kp, uint8_t Ki, uint8_t Kd)
+int logger_enqueue(const uint8_t *data, uint32_t len)
 {
-    DataBuffer[0] =  set_rpm/10 % 10 + '0';
-    DataBuffer[1] =  set_rpm % 10 + '0';
-    DataBuffer[2] =  ' '; 
-    DataBuffer[3] =  read_rpm/10 % 10 + '0';
-    DataBuffer[4] =  read_rpm % 10 + '0';
-    DataBuffer[5] =  ' '; 
-    DataBuffer[6] =  Kp/10 % 10 + '0';
-    DataBuffer[7] =  Kp % 10 + '0';
-    DataBuffer[8] =  ' '; 
-    DataBuffer[9] =  Ki/10 % 10 + '0';
-    DataBuffer[10] = Ki % 10 + '0';
-    DataBuffer[11] = ' '; 
-    DataBuffer[12] = Kd/10 % 10 + '0';
-    DataBuffer[13] = Kd % 10 + '0';
-    DataBuffer[14] = '\n'; 
-   
-
-
-    uint32_t numSent;
-    numSent = XUartLite_Send(&UartLite, ControlBuffer, CONTROL_BUFFER_SIZE); 
-    if (numSent != CONTROL_BUFFER_SIZE)
+    uint32_t head = tx_head;
+    uint32_t room = (tx_tail - head - 1) & LOGGER_TX_RING_MASK;
+
+    if (len > room)
+    {
+        tx_dropped++;
+        return XST_FAILURE;
+    }
+
+    for (uint32_t n = 0; n < len; n++)
     {
-        return XST_FAILURE; 
+        tx_ring[head] = data[n];
+        head = (head + 1) & LOGGER_TX_RING_MASK;
     }
-    
-    //block until first message is sent 
-    while (XUartLite_IsSending(&UartLite)){};
+    tx_head = head;
+    tx_sent++;
 
-    numSent = XUartLite_Send(&UartLite, DataBuffer, DATA_BUFFER_SIZE); 
-    if (numSent != DATA_BUFFER_SIZE)
+    // the handler also moves tx_tail, so the check and kick run with its
+    // interrupt masked at the controller, which holds it pending. One byte
+    // is enough, the empty interrupt after it sends the rest
+    if (tx_intc != NULL)
     {
-        return XST_FAILURE; 
+        XIntc_Disable(tx_intc, UARTLITE_INTR_NUM);
+    }
+    if (!tx_busy && tx_tail != head)
+    {
+        uint32_t tail = tx_tail;
+
+        tx_busy = true;
+        tx_tail = (tail + 1) & LOGGER_TX_RING_MASK;
+        XUartLite_WriteReg(UARTLITE_BASEADDR, XUL_TX_FIFO_OFFSET, tx_ring[tail]);
     }
+    if (tx_intc != NULL)
+    {
+        XIntc_Enable(tx_intc, UARTLITE_INTR_NUM);
+    }
+    return XST_SUCCESS;
+}
+
+/**
+ * @function send_data
+ * @brief queues one telemetry frame for the plotter
+ * stamps the sequence number, encodes the frame (see telemetry.h)
+ * and hands it to the TX ring, the uartlite interrupt sends it out.
+ * The sequence number advances on drops too so the host can count them
+ * 
+ * @return XST_FAILURE if the ring was full and the frame dropped
+ */
+int send_data(ptr_telemetry_sample_t sample)
+{
+    uint8_t frame[TELEMETRY_FRAME_MAX];
+    uint32_t len;
 
-     //block until second message is sent 
-    while (XUartLite_IsSending(&UartLite)){};
+    sample->seq = tx_seq++;
+    len = telemetry_encode(sample, frame);
+    return logger_enqueue(frame, len);
+}
+
+/**
+ * @function send_autotune
+ * @brief queues an auto-tune result frame for the plotter
+ * shares the sequence number with send_data(), so the same
+ * single sender rule applies
+ * 
+ * @return XST_FAILURE if the ring was full and the frame dropped
+ */
+int send_autotune(ptr_telemetry_autotune_t result)
+{
+    uint8_t frame[TELEMETRY_FRAME_MAX];
+    uint32_t len;
 
-    //clear the FIFOs 
-    XUartLite_ResetFifos(&UartLite); 
-	/* Could use this instead */
-    //xil_printf("DB %d %d %d %d %d\n\r", set_rpm, read_rpm, Kp, Ki, Kd);
+    result->seq = tx_seq++;
+    len = telemetry_encode_autotune(result, frame);
+    return logger_enqueue(frame, len);
+}
+
+/**
+ * @function logger_get_sent
+ * @brief returns how many sends were queued
+ */
+uint32_t logger_get_sent(void)
+{
+    return tx_sent;
+}
+
+/**
+ * @function logger_get_dropped
+ * @brief returns how many sends were dropped on a full ring
+ */
+uint32_t logger_get_dropped(void)
+{
+    return tx_dropped;
 }
 
 /**
@@ -77,7 +195,7 @@ void send_data(uint8_t set_rpm, uint8_t read_rpm, uint8_t Kp, uint8_t Ki, uint8_
  * @brief function initializes initializes the uartlite instance
  * 
  */
-void uartlite_init()
+int uartlite_init(void)
 {
     uint32_t Status;
 
@@ -93,4 +211,69 @@ void uartlite_init()
 		return XST_FAILURE;
 	}
 
+    return XST_SUCCESS;
+}
+
+/**
+ * @function uartlite_intr_init
+ * 
+ * @brief connects the TX ring handler and enables the uartlite interrupt
+ * the interrupt controller still has to enable UARTLITE_INTR_NUM.
+ * logger_enqueue() masks it there around the TX kick
+ * 
+ * @param intc pointer to the initialized interrupt controller
+ */
+int uartlite_intr_init(XIntc *intc)
+{
+    int Status;
+
+    Status = XIntc_Connect(intc, UARTLITE_INTR_NUM,
+                           (XInterruptHandler)uartlite_handler,
+                           (void *)0);
+    if (Status != XST_SUCCESS)
+    {
+        return XST_FAILURE;
+    }
+    tx_intc = intc;
+
+    XUartLite_ResetFifos(&UartLite);
+    XUartLite_EnableIntr(UARTLITE_BASEADDR);
+    return XST_SUCCESS;
+}
+
+#ifdef LOGGER_BENCHMARK
+#define BENCH_SENDS 1000
+
+/**
+ * @function logger_benchmark
+ * @brief times send_data() over the console
+ * half the calls land on a full ring so both the queue and drop
+ * paths are measured. Run with interrupts enabled
+ * 
+ * @note the timebase counts AXI clocks, which is also the CPU clock
+ */
+void logger_benchmark(void)
+{
+    uint32_t worst = 0, total = 0;
+    uint32_t dropped = tx_dropped;
+    telemetry_sample_t sample = {0};
+
+    for (uint32_t n = 0; n < BENCH_SENDS; n++)
+    {
+        sample.set_rpm = n % 100;
+        sample.read_rpm = n % 97;
+        uint32_t start = tb_clocks32();
+        send_data(&sample);
+        uint32_t cycles = tb_clocks32() - start;
+
+        total += cycles;
+        if (cycles > worst)
+        {
+            worst = cycles;
+        }
+    }
+    xil_printf("\r\nsend_data benchmark (%d calls, %d dropped)\r\n",
+               BENCH_SENDS, tx_dropped - dropped);
+    xil_printf("  worst %d clocks  mean %d clocks\r\n", worst, total / BENCH_SENDS);
 }
+#endif
@@ -13,6 +13,10 @@
  * Ver  Who Date    Changes
  * -----------------------------------
  * 1.00a SW 23-Feb-2023 First release
+ * 1.01a DS 17-Oct-2026 Interrupt driven TX ring buffer, send_data() no longer blocks
+ * 1.02a DS 17-Oct-2026 send_data() sends a binary telemetry frame
+ * 1.03a DS 17-Oct-2026 send_autotune() for the auto-tune result frame
+ * 1.04a DS 17-Oct-2026 logger_time_us() replaced by timebase.h
  * </pre>
 ************************************************************/
 
@@ -21,17 +25,43 @@
 
 #include "xparameters.h"
 #include "xstatus.h"
+#include "xintc.h"
 #include "xuartlite.h"
 #include "xil_printf.h"
+#include "telemetry.h"
 
 #define UARTLITE_DEVICE_ID	XPAR_UARTLITE_0_DEVICE_ID
-#define DATA_BUFFER_SIZE 15
-#define CONTROL_BUFFER_SIZE 3
+#define UARTLITE_BASEADDR	XPAR_UARTLITE_0_BASEADDR
+#define UARTLITE_INTR_NUM	XPAR_MICROBLAZE_0_AXI_INTC_AXI_UARTLITE_0_INTERRUPT_INTR
 
-/* send data */
-void send_data(uint8_t set_rpm, uint8_t read_rpm, uint8_t Kp, uint8_t Ki, uint8_t Kd);
+// TX ring buffer, must be a power of 2. One slot is always left empty
+// so a full ring can be told apart from an empty one
+#define LOGGER_TX_RING_SIZE 512
+#define LOGGER_TX_RING_MASK (LOGGER_TX_RING_SIZE - 1)
+#define LOGGER_UART_FIFO_DEPTH 16
+
+/* send one telemetry frame, XST_FAILURE if the ring was full and it was dropped */
+int send_data(ptr_telemetry_sample_t sample);
+
+/* send an auto-tune result frame, same rules as send_data() */
+int send_autotune(ptr_telemetry_autotune_t result);
+
+/* queue raw bytes for transmit, all or nothing */
+int logger_enqueue(const uint8_t *data, uint32_t len);
+
+/* number of send_data()/logger_enqueue() calls queued / dropped on a full ring */
+uint32_t logger_get_sent(void);
+uint32_t logger_get_dropped(void);
 
 /* configure the uart_light*/
-void uartlite_init(); 
+int uartlite_init(void); 
+
+/* connect the TX empty interrupt that drains the ring */
+int uartlite_intr_init(XIntc *intc);
+
+#ifdef LOGGER_BENCHMARK
+/* prints the worst case send_data() time in clocks */
+void logger_benchmark(void);
+#endif
 
 #endif
@@ -14,6 +14,14 @@
  * Ver  Who Date    Changes
  * -----------------------------------
  * 1.00a SW 23-Feb-2023 First release
+ * 1.01a DS 17-Oct-2026 Stage profiling probes (STAGE_PROFILE)
+ * 1.02a DS 17-Oct-2026 User IO comes from the input interrupts, nothing
+ *                      polls it from the loop
+ * 1.03a DS 17-Oct-2026 init_IO_struct() runs before interrupts are on so
+ *                      the control tick never sees a half restored state
+ * 1.04a DS 17-Oct-2026 The loop runs the task_sched.h task table, each job at
+ *                      its own rate
+ * 1.05a DS 17-Oct-2026 Heartbeat windows for the watchdog supervisor
  * </pre>
 ******************************************************************************/
 
@@ -40,10 +48,35 @@
 #include "cntrl_logic.h"
 #include "logger.h"
 #include "wdt.h"
+#include "pid_fixed.h"
+#include "ctrl_tick.h"
+#include "profile.h"
+#include "input_events.h"
+#include "task_sched.h"
 
 
 /*****************PID Control Instances*****************/
-static ptr_user_io_t uIO;
+static user_io_t uIO;
+
+/*****************Main Loop Tasks*****************/
+static void input_task(void) {
+    update_pid(&uIO);
+}
+
+// indexed by sched_task_id_t. The main loop windows allow for a console
+// report blocking the loop; the control tick's is its real deadline
+static sched_task_t tasks[SCHED_NUM_TASKS] = {
+    // name         run                 period                      prio budget  window(us) stage
+#if CTRL_TICK_MODE
+    // period 0, the control tick runs it rather than the main loop
+    { "control",   control_pid,        0,                          0,   200,  20000,   PROF_CONTROL },
+#else
+    { "control",   control_pid,        SCHED_CONTROL_PERIOD_US,    0,   200,  2000000, PROF_CONTROL },
+#endif
+    { "input",     input_task,         SCHED_INPUT_PERIOD_US,      1,   1000, 2000000, PROF_UPDATE_PID },
+    { "display",   display,            SCHED_DISPLAY_PERIOD_US,    2,   500,  2000000, PROF_DISPLAY },
+    { "telemetry", send_uartlite_data, SCHED_TELEMETRY_PERIOD_US,  3,   500,  4000000, PROF_SEND },
+};
 
 
 int main()
@@ -57,17 +90,29 @@ int main()
     }
   
 
+#ifdef PID_FIXED_BENCHMARK
+    pid_fixed_benchmark();
+#endif
+
+    init_IO_struct(&uIO); // resumes a warm restart state, before the control tick runs
     microblaze_enable_interrupts();
-    init_IO_struct(uIO);
+#ifdef LOGGER_BENCHMARK
+    logger_benchmark(); // needs the uartlite interrupt to drain the ring
+#endif
     NX4IO_setLEDs(0x00000000); // clear LEDs, odd behavior where they turn on
-    PMODENC544_clearRotaryCount(); // set rotary count to 0
+    input_clear_rotary(); // set rotary count to 0
+    sched_init(tasks, SCHED_NUM_TASKS);
     while(1)
     {
-        read_user_IO(uIO);
-        update_pid(uIO);
-        control_pid(); 
-        display();
-        send_uartlite_data();
+#ifdef STAGE_PROFILE
+        uint32_t loop_start = profile_now();
+        // only passes that ran a task, idle passes would swamp the table
+        if(sched_run()) {
+            profile_record(PROF_LOOP, profile_now() - loop_start);
+        }
+#else
+        sched_run();
+#endif
     }
     
     microblaze_disable_interrupts();
@@ -0,0 +1,193 @@
+/**
+ * @file motor_ctrl.c
+ *
+ * @authors Stephen, Drew, Noah
+ * @copyright Portland State University, 2023
+ *
+ * @brief
+ * This is the source file for the per motor speed controller. See
+ * motor_ctrl.h. Nothing in here is static, so any number of controllers
+ * can be stepped back to back.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ * ---------------------
+ * Ver  Who Date    Changes
+ * -----------------------------------
+ * 1.00a DS 17-Oct-2026 First release
+ * </pre>
+************************************************************/
+
+#include <string.h>
+#include "motor_ctrl.h"
+#include "rpm_lut.h"
+
+#if HB3_FABRIC_PID
+/**
+ * fabric_pid_config() - hands the P/I/D to myHB3ip, or updates it
+ *
+ * @brief       The fabric PID steps on every tach sample and sets the
+ *              duty cycle itself, so this only goes out on the bus when
+ *              the setpoint or gains changed. It takes the same Q16.16
+ *              gains and limits as pid_fixed. The correction is in rpm, so
+ *              the IP also gets the feedforward count for set_rpm and the
+ *              counts per rpm of rpm_lut.h over the next table step to turn
+ *              it into a duty cycle.
+*/
+static void fabric_pid_config(ptr_motor_ctrl_t ctrl) {
+    if(!ctrl->fabric_on || ctrl->set_rpm != ctrl->fabric_set_rpm) {
+        uint8_t lo = (ctrl->set_rpm > RPM_LUT_MAX_RPM - (1 << RPM_LUT_RPM_STEP_LOG2))
+                     ? RPM_LUT_MAX_RPM - (1 << RPM_LUT_RPM_STEP_LOG2) : ctrl->set_rpm;
+        uint16_t ff = rpm_lut_to_count(ctrl->set_rpm);
+        // the top step is flat past RPM_LUT_MAX_RPM, so take the one below
+        q16_t slope = (q16_t)(rpm_lut_to_count(lo + (1 << RPM_LUT_RPM_STEP_LOG2))
+                              - rpm_lut_to_count(lo)) << (Q16_SHIFT - RPM_LUT_RPM_STEP_LOG2);
+
+        HB3_setPIDSetpoint(ctrl->hb3, (uint32_t)ctrl->set_rpm * HB3_RPM100_SCALE, ff, slope);
+        HB3_setPWM(ctrl->hb3, ctrl->pwm_enable, ff);
+        ctrl->fabric_set_rpm = ctrl->set_rpm;
+    }
+    if(!ctrl->fabric_on || ctrl->pid.kp != ctrl->fabric_kp || ctrl->pid.ki != ctrl->fabric_ki ||
+       ctrl->pid.kd != ctrl->fabric_kd) {
+        HB3_setPIDGains(ctrl->hb3, ctrl->pid.kp, ctrl->pid.ki, ctrl->pid.kd);
+        ctrl->fabric_kp = ctrl->pid.kp;
+        ctrl->fabric_ki = ctrl->pid.ki;
+        ctrl->fabric_kd = ctrl->pid.kd;
+    }
+    if(!ctrl->fabric_on) {
+        HB3_setPIDLimits(ctrl->hb3, ctrl->pid.i_max, ctrl->pid.out_max);
+        HB3_setPIDMode(ctrl->hb3, HB3_PID_FABRIC | HB3_PID_SOURCE);
+        ctrl->fabric_on = true;
+    }
+}
+
+/**
+ * fabric_pid_stop() - takes the duty cycle back from myHB3ip, which also
+ * clears its integrator
+*/
+static void fabric_pid_stop(ptr_motor_ctrl_t ctrl) {
+    if(ctrl->fabric_on) {
+        HB3_setPIDMode(ctrl->hb3, 0);
+        ctrl->fabric_on = false;
+    }
+}
+#endif
+
+/**
+ * motor_ctrl_init() - sets up a stopped controller with zero gains
+*/
+void motor_ctrl_init(ptr_motor_ctrl_t ctrl, ptr_hb3_t hb3, uint8_t channel) {
+    memset(ctrl, 0, sizeof(*ctrl));
+    ctrl->hb3 = hb3;
+    ctrl->channel = channel;
+    ctrl->setpoint = MOTOR_SPEED_OFF;
+    ctrl->pwm_enable = false;
+    ctrl->autotune.state = AUTOTUNE_IDLE;
+#if HB3_FABRIC_PID
+    ctrl->fabric_pid = HB3_hasFabricPID(hb3) && channel == HB3_PID_CHANNEL;
+#endif
+    pid_fixed_init(&ctrl->pid, Q16_FROM_INT(-MOTOR_OUT_LIMIT_RPM), Q16_FROM_INT(MOTOR_OUT_LIMIT_RPM),
+                   Q16_FROM_INT(MOTOR_I_LIMIT_RPM));
+}
+
+/**
+ * motor_ctrl_load_gains() - pushes the button gains into the PID
+*/
+void motor_ctrl_load_gains(ptr_motor_ctrl_t ctrl, uint8_t pid_sel) {
+    q16_t gp = (pid_sel & MOTOR_SEL_P) ? Q16_FROM_INT(ctrl->kp) : 0;
+    q16_t gi = (pid_sel & MOTOR_SEL_I) ? (q16_t)ctrl->ki * Q16_TENTH : 0;
+    q16_t gd = (pid_sel & MOTOR_SEL_D) ? Q16_FROM_INT(ctrl->kd) : 0;
+    pid_fixed_set_gains(&ctrl->pid, gp, gi, gd);
+}
+
+/**
+ * motor_ctrl_reset() - drops the loop history, keeps the setpoint and gains
+*/
+void motor_ctrl_reset(ptr_motor_ctrl_t ctrl) {
+#if HB3_FABRIC_PID
+    fabric_pid_stop(ctrl);
+#endif
+    pid_fixed_reset(&ctrl->pid);
+    ctrl->correction = 0;
+    ctrl->relay_on = false;
+}
+
+/**
+ * motor_ctrl_step() - one control step
+*/
+void motor_ctrl_step(ptr_motor_ctrl_t ctrl, bool new_sample, uint32_t now_us) {
+    if(ctrl->setpoint == MOTOR_SPEED_OFF)
+    {
+        motor_ctrl_reset(ctrl);
+        ctrl->set_rpm = 0;
+        ctrl->pwm_out = ctrl->setpoint;
+        HB3_setChannelPWM(ctrl->hb3, ctrl->channel, ctrl->pwm_enable, ctrl->setpoint); //change the motor speed by set PWM
+    }
+#if HB3_FABRIC_PID
+    else if(ctrl->fabric_pid && ctrl->autotune.state != AUTOTUNE_RUNNING)
+    {
+        // myHB3ip steps the P/I/D on every tach sample and sets the duty
+        // cycle, this only keeps it configured
+        ctrl->set_rpm = rpm_lut_from_count(ctrl->setpoint);
+        if(new_sample)
+        {
+            ctrl->read_rpm = motor_ctrl_speed(ctrl);
+        }
+        ctrl->relay_on = false;
+        fabric_pid_config(ctrl);
+    }
+#endif
+    else
+    {
+#if HB3_FABRIC_PID
+        fabric_pid_stop(ctrl); // the relay below drives the duty cycle
+#endif
+        // feedforward straight from the PWM count, the PID only corrects
+        // what the characterization does not predict
+        ctrl->set_rpm = rpm_lut_from_count(ctrl->setpoint);
+        if(ctrl->autotune.state == AUTOTUNE_RUNNING)
+        {
+            // relay in place of the P/I/D correction
+            if(new_sample)
+            {
+                ctrl->read_rpm = motor_ctrl_speed(ctrl);
+                ctrl->correction = autotune_step(&ctrl->autotune, ctrl->read_rpm, now_us);
+            }
+            else
+            {
+                ctrl->correction = autotune_relay(&ctrl->autotune);
+            }
+            ctrl->relay_on = true;
+        }
+        else if(new_sample)
+        {
+            if(ctrl->relay_on)
+            {
+                // start the new gains without history from before the relay
+                motor_ctrl_reset(ctrl);
+            }
+            ctrl->read_rpm = motor_ctrl_speed(ctrl);
+            q16_t error = Q16_FROM_INT((int32_t)ctrl->set_rpm - (int32_t)ctrl->read_rpm);
+            ctrl->correction = Q16_TO_INT(pid_fixed_step(&ctrl->pid, error));
+        }
+        int32_t output_rpm = ctrl->set_rpm + ctrl->correction;
+
+        // clamp to what rpm_lut_to_count() can represent
+        if(output_rpm < 0)
+        {
+            output_rpm = 0;
+        }
+        else if(output_rpm > MOTOR_MAX_RPM)
+        {
+            output_rpm = MOTOR_MAX_RPM;
+        }
+        uint16_t output_setpoint = rpm_lut_to_count(output_rpm);
+        // clamp max output to 100% duty cycle
+        if(output_setpoint > MOTOR_PWM_MAX)
+        {
+            output_setpoint = MOTOR_PWM_MAX;
+        }
+        ctrl->pwm_out = output_setpoint;
+        HB3_setChannelPWM(ctrl->hb3, ctrl->channel, ctrl->pwm_enable, output_setpoint); //change the motor speed by set PWM
+    }
+}
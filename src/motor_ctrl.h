@@ -0,0 +1,127 @@
+/**
+ * @file motor_ctrl.h
+ *
+ * @authors Stephen, Drew, Noah
+ * @copyright Portland State University, 2023
+ *
+ * @brief
+ * This is the header file for the per motor speed controller. Everything
+ * one control loop needs (its myHB3ip, the Q16.16 PID, the auto-tuner, the
+ * setpoint, its gains and what the last step drove) is in a motor_ctrl_t,
+ * so the same code runs one loop per motor. cntrl_logic.c keeps one per
+ * motor and steps them all from the control step; the buttons, knob and
+ * display work on the one picked on the switches.
+ *
+ * The setpoint, enable and gains are written from the main loop and read by
+ * the step, which runs in the control tick interrupt in CTRL_TICK_MODE. They
+ * are single stores, the same as when they were file statics.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ * ---------------------
+ * Ver  Who Date    Changes
+ * -----------------------------------
+ * 1.00a DS 17-Oct-2026 First release
+ * </pre>
+************************************************************/
+
+#ifndef MOTOR_CTRL_H
+#define MOTOR_CTRL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "cntrl_logic.h"
+#include "pid_fixed.h"
+#include "autotune.h"
+
+/*********Motor Control Constants****************************/
+#define MOTOR_SPEED_OFF             1           // PWM count that stops the motor
+#define MOTOR_PWM_MAX               1023        // 10 bit PWM count, 100% duty cycle
+#define MOTOR_OUT_LIMIT_RPM         70          // max rpm correction the PID may add or remove
+#define MOTOR_I_LIMIT_RPM           50          // integrator clamp in rpm
+#define MOTOR_MAX_RPM               UINT8_MAX   // rpm_lut_to_count() saturates past RPM_LUT_MAX_RPM
+#define MOTOR_SEL_P                 0x4         // pid_sel bits, terms left out get a zero gain
+#define MOTOR_SEL_I                 0x2
+#define MOTOR_SEL_D                 0x1
+
+/*********Motor Control Structs****************************/
+typedef struct motor_ctrl {
+    ptr_hb3_t hb3;              // the motor's myHB3ip
+    uint8_t channel;            // its channel on the myHB3ip
+    uint8_t kp, ki, kd;         // button gains, Ki in tenths, see motor_ctrl_load_gains()
+    pid_fixed_t pid;
+    autotune_t autotune;        // relay experiment, runs in place of the P/I/D
+    uint16_t setpoint;          // PWM count asked for, MOTOR_SPEED_OFF is off
+    bool pwm_enable;            // true to enable PWM output
+    uint8_t set_rpm;            // setpoint through the characterization
+    uint16_t read_rpm;          // speed at the last new sample
+    uint16_t pwm_out;           // PWM count from the last step
+    int32_t correction;         // rpm correction from the last P/I/D update
+    bool relay_on;              // the last step drove the relay
+#if HB3_FABRIC_PID
+    bool fabric_pid;            // the channel has the myHB3ip fabric PID
+    bool fabric_on;             // myHB3ip is driving the duty cycle
+    uint8_t fabric_set_rpm;     // what the fabric PID was last loaded with
+    q16_t fabric_kp, fabric_ki, fabric_kd;
+#endif
+} motor_ctrl_t, *ptr_motor_ctrl_t;
+
+/**
+ * motor_ctrl_init() - sets up a stopped controller with zero gains
+ *
+ * @param       ctrl        controller state
+ * @param       hb3         the motor's myHB3ip, already initialized
+ * @param       channel     the motor's channel on it
+*/
+void motor_ctrl_init(ptr_motor_ctrl_t ctrl, ptr_hb3_t hb3, uint8_t channel);
+
+/**
+ * motor_ctrl_reset() - drops the loop history: the integrator, the last
+ * correction and the relay, and takes the duty cycle back from the fabric
+ * PID. The setpoint and gains are kept
+*/
+void motor_ctrl_reset(ptr_motor_ctrl_t ctrl);
+
+/**
+ * motor_ctrl_load_gains() - pushes the button gains into the PID
+ *
+ * @brief       Kp and Kd are whole numbers, Ki is scaled by 1/10 with a
+ *              reciprocal multiply. The step hands them to the fabric PID
+ *              when they changed.
+ *
+ * @param       ctrl        controller state
+ * @param       pid_sel     MOTOR_SEL_* terms to run
+*/
+void motor_ctrl_load_gains(ptr_motor_ctrl_t ctrl, uint8_t pid_sel);
+
+/**
+ * motor_ctrl_step() - one control step
+ *
+ * @brief       The set rpm feedforward is applied every step, the P/I/D
+ *              (or relay) correction is only recomputed when there is a
+ *              new speed sample. With HB3_FABRIC_PID the step only keeps
+ *              myHB3ip configured on the motor on HB3_PID_CHANNEL of an IP
+ *              that reports PID_ACCEL; the other channels run pid_fixed.c.
+ *
+ * @param       ctrl        controller state
+ * @param       new_sample  true if the tach has a new measurement
+ * @param       now_us      device time of the step, for the auto-tuner
+*/
+void motor_ctrl_step(ptr_motor_ctrl_t ctrl, bool new_sample, uint32_t now_us);
+
+/**
+ * motor_ctrl_speed() - the motor speed from the selected tach source
+ *
+ * @brief       converted once per sample by the myHB3ip new sample
+ *              interrupt, or once per step by the latch of a multi-channel
+ *              myHB3ip, so this does not touch the bus
+*/
+static inline uint32_t motor_ctrl_speed(const motor_ctrl_t *ctrl) {
+#if HB3_CHANNELS > 1
+    return HB3_getChannelRPM(ctrl->hb3, ctrl->channel);
+#else
+    return HB3_getCachedRPM(ctrl->hb3);
+#endif
+}
+
+#endif
@@ -0,0 +1,160 @@
+/**
+ * @file pid_fixed.c
+ *
+ * @authors Stephen, Drew, Noah
+ * @copyright Portland State University, 2023
+ *
+ * @brief
+ * This is the source file for the Q16.16 fixed-point PID engine. All
+ * terms saturate rather than wrap, the integrator is clamped so it cannot
+ * wind up while the motor is stalled in the dead-band, and the output is
+ * clamped to the limits given at init.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ * ---------------------
+ * Ver  Who Date    Changes
+ * -----------------------------------
+ * 1.00a DS 17-Oct-2026 First release
+ * </pre>
+************************************************************/
+
+#include "pid_fixed.h"
+
+/**
+ * pid_fixed_init() - clears state and sets the integrator and output limits
+ *
+ * @param       pid         pointer to a PID instance
+ * @param       out_min     lowest output the step may return
+ * @param       out_max     highest output the step may return
+ * @param       i_limit     integrator is held within [-i_limit, i_limit]
+*/
+void pid_fixed_init(ptr_pid_fixed_t pid, q16_t out_min, q16_t out_max, q16_t i_limit) {
+    pid->kp = pid->ki = pid->kd = 0;
+    pid->out_min = out_min;
+    pid->out_max = out_max;
+    pid->i_min = -i_limit;
+    pid->i_max = i_limit;
+    pid_fixed_reset(pid);
+}
+
+/**
+ * pid_fixed_reset() - clears the integrator and derivative history
+ *
+ * @param       pid         pointer to a PID instance
+*/
+void pid_fixed_reset(ptr_pid_fixed_t pid) {
+    pid->integrator = 0;
+    pid->prev_error = 0;
+}
+
+/**
+ * pid_fixed_set_gains() - loads new gains
+ *
+ * @brief       The integrator holds ki * error rather than the raw error sum
+ *              so changing ki from the buttons does not bump the output.
+ *
+ * @param       pid         pointer to a PID instance
+ * @param       kp, ki, kd  Q16.16 gains
+*/
+void pid_fixed_set_gains(ptr_pid_fixed_t pid, q16_t kp, q16_t ki, q16_t kd) {
+    pid->kp = kp;
+    pid->ki = ki;
+    pid->kd = kd;
+}
+
+/**
+ * pid_fixed_step() - runs one P/I/D update
+ *
+ * @param       pid         pointer to a PID instance
+ * @param       error       Q16.16 setpoint - measurement
+ *
+ * @return      Q16.16 controller output clamped to the output limits
+*/
+q16_t pid_fixed_step(ptr_pid_fixed_t pid, q16_t error) {
+    q16_t out = q16_sat_mul(pid->kp, error);
+
+    pid->integrator = q16_clamp(q16_sat_add(pid->integrator, q16_sat_mul(pid->ki, error)),
+                                pid->i_min, pid->i_max);
+    out = q16_sat_add(out, pid->integrator);
+
+    out = q16_sat_add(out, q16_sat_mul(pid->kd, q16_sat_sub(error, pid->prev_error)));
+    pid->prev_error = error;
+
+    return q16_clamp(out, pid->out_min, pid->out_max);
+}
+
+#ifdef PID_FIXED_BENCHMARK
+#include "xil_printf.h"
+#include "timebase.h"
+#include "myHB3ip.h"
+
+#define BENCH_ITERATIONS                1000
+#define BENCH_TICKS_PER_REV             823.13
+
+static volatile uint32_t bench_sink;    // keeps the compiler from dropping the loops
+
+/**
+ * legacy_step() - copy of the soft-float control_pid() math this module replaced
+*/
+static uint16_t legacy_step(uint16_t setpoint, uint32_t ticks) {
+    static uint8_t preverror = 0;
+    static uint8_t i = 0;
+    uint8_t i_control = 10;
+    uint8_t duty_cycle = (uint8_t)(((float)setpoint / PIDF_PWM_RESOLUTION) * 100);
+    uint8_t set_rpm = duty_cycle - PIDF_RPM_DUTY_OFFSET;
+    uint32_t rpm = ticks * 60;
+    rpm /= BENCH_TICKS_PER_REV;
+    uint8_t read_rpm = rpm;
+    int8_t error = set_rpm - read_rpm;
+    int8_t d = error - preverror;
+    preverror = error;
+    i = (error < set_rpm/i_control) ? i + error : 0;
+    int8_t GP = 2 * error;
+    int8_t GI = (2/i_control) * i;
+    int8_t GD = 2 * d;
+    uint8_t output_rpm = set_rpm + GP + GI + GD;
+    return (uint16_t)((float)(output_rpm + PIDF_RPM_DUTY_OFFSET) / 100 * PIDF_PWM_RESOLUTION);
+}
+
+/**
+ * fixed_step() - the same conversion and PID sequence using this module
+*/
+static uint16_t fixed_step(ptr_pid_fixed_t pid, uint16_t setpoint, uint32_t ticks) {
+    int32_t set_rpm = pid_fixed_count_to_duty(setpoint) - PIDF_RPM_DUTY_OFFSET;
+    int32_t read_rpm = (ticks * HB3_RPM_RECIP_Q20) >> HB3_RPM_SHIFT;
+    q16_t out = pid_fixed_step(pid, Q16_FROM_INT(set_rpm - read_rpm));
+    int32_t output_rpm = set_rpm + Q16_TO_INT(out);
+    return pid_fixed_duty_to_count((output_rpm < 0) ? 0 : output_rpm + PIDF_RPM_DUTY_OFFSET);
+}
+
+/**
+ * pid_fixed_benchmark() - times the legacy soft-float control path against
+ * the fixed-point path and prints cycles/iteration over the console
+ *
+ * @note        the timebase counts AXI clocks, which is also the CPU clock
+*/
+void pid_fixed_benchmark(void) {
+    pid_fixed_t pid;
+    uint32_t start, float_cycles, fixed_cycles;
+
+    pid_fixed_init(&pid, Q16_FROM_INT(-70), Q16_FROM_INT(70), Q16_FROM_INT(50));
+    pid_fixed_set_gains(&pid, Q16_FROM_INT(2), 2 * Q16_TENTH, Q16_FROM_INT(2));
+
+    start = tb_clocks32();
+    for (uint32_t n = 0; n < BENCH_ITERATIONS; n++) {
+        bench_sink = legacy_step(454 + (n & 0x7F), 500 + (n & 0x3F));
+    }
+    float_cycles = tb_clocks32() - start;
+
+    start = tb_clocks32();
+    for (uint32_t n = 0; n < BENCH_ITERATIONS; n++) {
+        bench_sink = fixed_step(&pid, 454 + (n & 0x7F), 500 + (n & 0x3F));
+    }
+    fixed_cycles = tb_clocks32() - start;
+
+    xil_printf("PID benchmark (%d iterations)\r\n", BENCH_ITERATIONS);
+    xil_printf("  soft-float path: %d cycles/iteration\r\n", float_cycles / BENCH_ITERATIONS);
+    xil_printf("  fixed-point path: %d cycles/iteration\r\n", fixed_cycles / BENCH_ITERATIONS);
+}
+#endif
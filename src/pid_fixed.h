@@ -0,0 +1,160 @@
+/**
+ * @file pid_fixed.h
+ *
+ * @authors Stephen, Drew, Noah
+ * @copyright Portland State University, 2023
+ *
+ * @brief
+ * This is the header file for the Q16.16 fixed-point PID engine. The
+ * MicroBlaze is built without an FPU, multiplier or divider so everything
+ * in here is done with integer adds, shifts and reciprocal multiplies.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ * ---------------------
+ * Ver  Who Date    Changes
+ * -----------------------------------
+ * 1.00a DS 17-Oct-2026 First release
+ * </pre>
+************************************************************/
+
+#ifndef PID_FIXED_H
+#define PID_FIXED_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*********Fixed-Point Constants****************************/
+#define Q16_SHIFT                       16
+#define Q16_ONE                         ((q16_t)1 << Q16_SHIFT)
+#define Q16_MAX                         INT32_MAX
+#define Q16_MIN                         INT32_MIN
+#define Q16_FROM_INT(x)                 ((q16_t)(x) * Q16_ONE)
+#define Q16_TO_INT(x)                   ((int32_t)(x) >> Q16_SHIFT)  // floors toward -inf
+#define Q16_TENTH                       6554        // round(0.1 * 2^16), reciprocal of 10
+
+// duty cycle (%) <-> 10 bit PWM count conversions, see pid_fixed.c
+#define PIDF_PWM_RESOLUTION             1023        // 10 bit PWM count at 100% duty cycle
+#define PIDF_DUTY_RECIP_Q24             1640002     // ceil(100 / 1023 * 2^24)
+#define PIDF_COUNT_RECIP_Q16            670434      // ceil(1023 / 100 * 2^16)
+// straight line rpm ~= duty - 4, kept for the benchmark; the firmware uses rpm_lut.h
+#define PIDF_RPM_DUTY_OFFSET            4
+
+/*********Fixed-Point Types****************************/
+typedef int32_t q16_t;          // signed Q16.16
+
+typedef struct pid_fixed {
+    q16_t kp, ki, kd;           // gains
+    q16_t integrator;           // accumulated ki * error
+    q16_t i_min, i_max;         // integrator clamp
+    q16_t out_min, out_max;     // output clamp
+    q16_t prev_error;           // error from the previous step for the D term
+} pid_fixed_t, *ptr_pid_fixed_t;
+
+/*********Saturating Arithmetic****************************/
+/**
+ * q16_sat_add() - adds two Q16.16 values, saturating instead of wrapping
+ */
+static inline q16_t q16_sat_add(q16_t a, q16_t b) {
+    q16_t sum = (q16_t)((uint32_t)a + (uint32_t)b);
+    // overflow only when both operands share a sign the result does not
+    if (((a ^ sum) & (b ^ sum)) < 0) {
+        sum = (a < 0) ? Q16_MIN : Q16_MAX;
+    }
+    return sum;
+}
+
+/**
+ * q16_sat_sub() - subtracts b from a, saturating instead of wrapping
+ */
+static inline q16_t q16_sat_sub(q16_t a, q16_t b) {
+    q16_t diff = (q16_t)((uint32_t)a - (uint32_t)b);
+    if (((a ^ b) & (a ^ diff)) < 0) {
+        diff = (a < 0) ? Q16_MIN : Q16_MAX;
+    }
+    return diff;
+}
+
+/**
+ * q16_sat_mul() - multiplies two Q16.16 values, saturating to the Q16.16 range
+ */
+static inline q16_t q16_sat_mul(q16_t a, q16_t b) {
+    int64_t prod = ((int64_t)a * b) >> Q16_SHIFT;
+    if (prod > Q16_MAX)
+        return Q16_MAX;
+    if (prod < Q16_MIN)
+        return Q16_MIN;
+    return (q16_t)prod;
+}
+
+/**
+ * q16_clamp() - limits x to [lo, hi]
+ */
+static inline q16_t q16_clamp(q16_t x, q16_t lo, q16_t hi) {
+    return (x < lo) ? lo : ((x > hi) ? hi : x);
+}
+
+/*********PID Engine****************************/
+/**
+ * pid_fixed_init() - clears state and sets the integrator and output limits
+ *
+ * @param       pid         pointer to a PID instance
+ * @param       out_min     lowest output the step may return
+ * @param       out_max     highest output the step may return
+ * @param       i_limit     integrator is held within [-i_limit, i_limit]
+*/
+void pid_fixed_init(ptr_pid_fixed_t pid, q16_t out_min, q16_t out_max, q16_t i_limit);
+
+/**
+ * pid_fixed_reset() - clears the integrator and derivative history
+ *
+ * @param       pid         pointer to a PID instance
+*/
+void pid_fixed_reset(ptr_pid_fixed_t pid);
+
+/**
+ * pid_fixed_set_gains() - loads new gains, integrator state is kept
+ *
+ * @param       pid         pointer to a PID instance
+ * @param       kp, ki, kd  Q16.16 gains
+*/
+void pid_fixed_set_gains(ptr_pid_fixed_t pid, q16_t kp, q16_t ki, q16_t kd);
+
+/**
+ * pid_fixed_step() - runs one P/I/D update
+ *
+ * @param       pid         pointer to a PID instance
+ * @param       error       Q16.16 setpoint - measurement
+ *
+ * @return      Q16.16 controller output clamped to the output limits
+*/
+q16_t pid_fixed_step(ptr_pid_fixed_t pid, q16_t error);
+
+/*********Unit Conversions****************************/
+/**
+ * pid_fixed_count_to_duty() - 10 bit PWM count to whole percent duty cycle,
+ * equal to (count * 100) / 1023 for every count in range
+*/
+static inline uint8_t pid_fixed_count_to_duty(uint16_t count) {
+    return (uint8_t)(((uint32_t)count * PIDF_DUTY_RECIP_Q24) >> 24);
+}
+
+/**
+ * pid_fixed_duty_to_count() - whole percent duty cycle to 10 bit PWM count,
+ * equal to (duty * 1023) / 100 for every duty in range
+*/
+static inline uint16_t pid_fixed_duty_to_count(uint32_t duty) {
+    return (uint16_t)((duty * PIDF_COUNT_RECIP_Q16) >> Q16_SHIFT);
+}
+
+#ifdef PID_FIXED_BENCHMARK
+/**
+ * pid_fixed_benchmark() - times the legacy soft-float control path against
+ * the fixed-point path and prints cycles/iteration over the console
+ *
+ * @note        needs the WDT timebase initialized in sys_init.c
+*/
+void pid_fixed_benchmark(void);
+#endif
+
+#endif
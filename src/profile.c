@@ -0,0 +1,79 @@
+/**
+ * @file profile.c
+ *
+ * @authors Stephen, Drew, Noah
+ * @copyright Portland State University, 2023
+ *
+ * @brief
+ * This is the source file for the main loop stage profiler. The probes
+ * are inline in profile.h; this keeps and prints the table.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ * ---------------------
+ * Ver  Who Date    Changes
+ * -----------------------------------
+ * 1.00a DS 17-Oct-2026 First release
+ * </pre>
+************************************************************/
+
+#include "profile.h"
+
+#ifdef STAGE_PROFILE
+
+#include "xil_printf.h"
+
+/********************Global Variables********************/
+profile_stats_t profile_stats[PROF_NUM_STAGES];
+
+/********************Local File Variables********************/
+static const char *const stage_names[PROF_NUM_STAGES] = {
+    "update_pid", "control", "display", "send_uart", "loop"
+};
+
+/**
+ * profile_reset() - empties the table
+*/
+void profile_reset(void) {
+    for(int i = 0; i < PROF_NUM_STAGES; i++) {
+        ptr_profile_stats_t s = &profile_stats[i];
+        s->count = 0;
+        s->min = UINT32_MAX;
+        s->max = 0;
+        s->sum = 0;
+        for(int b = 0; b < PROF_HIST_BINS; b++) {
+            s->hist[b] = 0;
+        }
+    }
+}
+
+/**
+ * profile_report() - prints the table to the console and empties it
+ *
+ * @brief       One line per stage with count, min, mean and max clocks,
+ *              then the non-empty histogram bins as "2^n:count".
+*/
+void profile_report(void) {
+    xil_printf("Stage profile (clocks @ %d Hz)\r\n", XPAR_CPU_CORE_CLOCK_FREQ_HZ);
+    xil_printf("  stage          count       min      mean       max\r\n");
+    for(int i = 0; i < PROF_NUM_STAGES; i++) {
+        const profile_stats_t *s = &profile_stats[i];
+        uint32_t mean = s->count ? (uint32_t)(s->sum / s->count) : 0;
+
+        xil_printf("  %-12s %7d %9d %9d %9d\r\n", stage_names[i], s->count,
+                   s->count ? s->min : 0, mean, s->max);
+        if(s->count == 0) {
+            continue;
+        }
+        xil_printf("   ");
+        for(int b = 0; b < PROF_HIST_BINS; b++) {
+            if(s->hist[b]) {
+                xil_printf(" 2^%d:%d", b, s->hist[b]);
+            }
+        }
+        xil_printf("\r\n");
+    }
+    profile_reset();
+}
+
+#endif
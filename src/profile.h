@@ -0,0 +1,110 @@
+/**
+ * @file profile.h
+ *
+ * @authors Stephen, Drew, Noah
+ * @copyright Portland State University, 2023
+ *
+ * @brief
+ * This is the header file for the main loop stage profiler. PROFILE_STAGE()
+ * reads the low word of the timebase.h counter straight off the bus before
+ * and after a stage, so a probe costs an AXI read and a store. Each stage
+ * keeps min/max, a sum for the mean and a log2 histogram of its clocks.
+ * With SW15 on, btnR prints the table and starts it over.
+ *
+ * Build with STAGE_PROFILE defined to turn it on, otherwise
+ * PROFILE_STAGE() is just the statement and none of this is compiled.
+ *
+ * In CTRL_TICK_MODE the control step runs in the timer interrupt and is
+ * profiled there, and a main loop stage it interrupts is charged for it.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ * ---------------------
+ * Ver  Who Date    Changes
+ * -----------------------------------
+ * 1.00a DS 17-Oct-2026 First release
+ * </pre>
+************************************************************/
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stdint.h>
+
+/*********Profiled Stages****************************/
+typedef enum profile_stage {
+    PROF_UPDATE_PID = 0,        // update_pid(), including draining the input queue
+    PROF_CONTROL,               // control_pid(), or control_pid_step() in the tick
+    PROF_DISPLAY,               // display()
+    PROF_SEND,                  // send_uartlite_data()
+    PROF_LOOP,                  // one whole pass of the main loop
+    PROF_NUM_STAGES
+} profile_stage_t;
+
+#ifdef STAGE_PROFILE
+
+#include "timebase.h"
+
+/*********Profile Constants****************************/
+#define PROF_HIST_BINS              32          // bin n holds 2^n <= clocks < 2^(n+1)
+#define PROF_BTN                    0x01        // btnR, with REPORT_SW on
+
+/*********Profile Structs****************************/
+typedef struct profile_stats {
+    uint32_t count;             // times the stage ran
+    uint32_t min;               // clocks
+    uint32_t max;
+    uint64_t sum;               // for the mean, divided at report time
+    uint32_t hist[PROF_HIST_BINS];
+} profile_stats_t, *ptr_profile_stats_t;
+
+extern profile_stats_t profile_stats[PROF_NUM_STAGES];
+
+/**
+ * profile_now() - free running timestamp, CPU clocks
+*/
+static inline uint32_t profile_now(void) {
+    return tb_clocks32();
+}
+
+/**
+ * profile_record() - adds one stage time to the table
+*/
+static inline void profile_record(profile_stage_t stage, uint32_t clocks) {
+    ptr_profile_stats_t s = &profile_stats[stage];
+
+    s->count++;
+    s->sum += clocks;
+    if(clocks < s->min) {
+        s->min = clocks;
+    }
+    if(clocks > s->max) {
+        s->max = clocks;
+    }
+    s->hist[31 - __builtin_clz(clocks | 1)]++;
+}
+
+#define PROFILE_STAGE(stage, stmt)                                  \
+    do {                                                            \
+        uint32_t prof_t0_ = profile_now();                          \
+        stmt;                                                       \
+        profile_record((stage), profile_now() - prof_t0_);          \
+    } while(0)
+
+/**
+ * profile_reset() - empties the table, timebase_init() must have run
+*/
+void profile_reset(void);
+
+/**
+ * profile_report() - prints the table to the console and empties it
+*/
+void profile_report(void);
+
+#else
+
+#define PROFILE_STAGE(stage, stmt)  stmt
+
+#endif
+
+#endif
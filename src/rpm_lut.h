@@ -0,0 +1,88 @@
+/**
+ * @file rpm_lut.h
+ *
+ * @authors Stephen, Drew, Noah
+ * @copyright Portland State University, 2023
+ *
+ * @brief
+ * Duty cycle <-> RPM feedforward tables. GENERATED by logger/gen_rpm_lut.py
+ * from logger/csv/duty_cycle_characterization.csv, do not edit by hand - rerun the script after
+ * recharacterizing the motor.
+ *
+ * rpm_lut_from_count() and rpm_lut_to_count() interpolate linearly between
+ * the table points with one multiply and a shift.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ * ---------------------
+ * Ver  Who Date    Changes
+ * -----------------------------------
+ * 1.00a DS 17-Oct-2026 First release
+ * </pre>
+************************************************************/
+
+#ifndef RPM_LUT_H
+#define RPM_LUT_H
+
+#include <stdint.h>
+
+/*********Table Constants****************************/
+#define RPM_LUT_COUNT_STEP_LOG2         4           // forward table point every 16 PWM counts
+#define RPM_LUT_RPM_STEP_LOG2           2           // reverse table point every 4 rpm
+#define RPM_LUT_FRAC_BITS               8           // forward table values are Q8 rpm
+#define RPM_LUT_MAX_COUNT               1023        // 100% duty cycle
+#define RPM_LUT_MAX_RPM                 76          // rpm at RPM_LUT_MAX_COUNT
+#define RPM_LUT_FWD_SIZE                65
+#define RPM_LUT_REV_SIZE                21
+
+/*********Tables****************************/
+/** Q8 rpm at PWM count i << RPM_LUT_COUNT_STEP_LOG2 */
+static const uint16_t rpm_lut_fwd[RPM_LUT_FWD_SIZE] = {
+        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+        0,     0,  5786,  9333,  9931, 10331, 10967, 11388, 11789, 12110, 12333, 12734,
+    13134, 13534, 13751, 14079, 14480, 14624, 14936, 15169, 15360, 15458, 15737, 16002,
+    16265, 16466, 16657, 16791, 16980, 17266, 17437, 17537, 17637, 17920, 18011, 18212,
+    18412, 18552, 18685, 19282, 19507,
+};
+
+/** PWM count for rpm i << RPM_LUT_RPM_STEP_LOG2 */
+static const uint16_t rpm_lut_rev[RPM_LUT_REV_SIZE] = {
+        0,    49,    99,   148,   197,   247,   296,   345,   395,   430,   460,   491,
+      542,   583,   634,   696,   777,   859,   962,  1020,  1023,
+};
+
+/*********Lookups****************************/
+/**
+ * rpm_lut_from_count() - steady state rpm for a 10 bit PWM count, rounded
+*/
+static inline uint8_t rpm_lut_from_count(uint16_t count) {
+    uint32_t idx, frac, rpm_q;
+
+    if(count >= RPM_LUT_MAX_COUNT) {
+        return RPM_LUT_MAX_RPM;
+    }
+    idx = count >> RPM_LUT_COUNT_STEP_LOG2;
+    frac = count & ((1 << RPM_LUT_COUNT_STEP_LOG2) - 1);
+    rpm_q = (rpm_lut_fwd[idx] << RPM_LUT_COUNT_STEP_LOG2)
+          + (rpm_lut_fwd[idx + 1] - rpm_lut_fwd[idx]) * frac;
+    return (uint8_t)((rpm_q + (1 << (RPM_LUT_COUNT_STEP_LOG2 + RPM_LUT_FRAC_BITS - 1)))
+                     >> (RPM_LUT_COUNT_STEP_LOG2 + RPM_LUT_FRAC_BITS));
+}
+
+/**
+ * rpm_lut_to_count() - 10 bit PWM count that runs the motor at an rpm,
+ * full scale for anything past RPM_LUT_MAX_RPM
+*/
+static inline uint16_t rpm_lut_to_count(uint8_t rpm) {
+    uint32_t idx = rpm >> RPM_LUT_RPM_STEP_LOG2;
+    uint32_t frac = rpm & ((1 << RPM_LUT_RPM_STEP_LOG2) - 1);
+
+    if(idx >= RPM_LUT_REV_SIZE - 1) {
+        return RPM_LUT_MAX_COUNT;
+    }
+    return (uint16_t)(rpm_lut_rev[idx]
+                      + (((rpm_lut_rev[idx + 1] - rpm_lut_rev[idx]) * frac) >> RPM_LUT_RPM_STEP_LOG2));
+}
+
+#endif
@@ -0,0 +1,64 @@
+/**
+ * @file sseg.c
+ *
+ * @authors Stephen, Drew, Noah
+ * @copyright Portland State University, 2023
+ *
+ * @brief
+ * This is the source file for the seven segment display framebuffer.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ * ---------------------
+ * Ver  Who Date    Changes
+ * -----------------------------------
+ * 1.00a DS 17-Oct-2026 First release
+ * </pre>
+************************************************************/
+
+#include "sseg.h"
+
+/*********Local Constants****************************/
+// bit 5 is not part of any digit, so no composed image matches this and
+// the first sseg_show() writes both banks
+#define SSEG_SHADOW_INVALID     0xFFFFFFFF
+
+#define SSEG_PAIR(t, o)         (SSEG_DIGIT(1, t) | SSEG_DIGIT(0, o))
+#define SSEG_DECADE(t)          SSEG_PAIR(t, 0), SSEG_PAIR(t, 1), SSEG_PAIR(t, 2), SSEG_PAIR(t, 3), \
+                                SSEG_PAIR(t, 4), SSEG_PAIR(t, 5), SSEG_PAIR(t, 6), SSEG_PAIR(t, 7), \
+                                SSEG_PAIR(t, 8), SSEG_PAIR(t, 9)
+
+/********************Global Variables********************/
+const uint16_t sseg_dec2_lut[SSEG_DEC2_MAX + 1] = {
+    SSEG_DECADE(0), SSEG_DECADE(1), SSEG_DECADE(2), SSEG_DECADE(3), SSEG_DECADE(4),
+    SSEG_DECADE(5), SSEG_DECADE(6), SSEG_DECADE(7), SSEG_DECADE(8), SSEG_DECADE(9)
+};
+
+/********************Local File Variables********************/
+static uint32_t shadow_hi = SSEG_SHADOW_INVALID;   // last written SSEGHI
+static uint32_t shadow_lo = SSEG_SHADOW_INVALID;   // last written SSEGLO
+static volatile bool heartbeat = false;
+
+/**
+ * sseg_show() - writes whichever banks changed since the last call
+*/
+void sseg_show(uint32_t hi, uint32_t lo) {
+    if(heartbeat) {
+        hi |= SSEG_DP(3);
+    }
+    if(hi != shadow_hi) {
+        NX4IO_SSEG_setSSEG_DATA(SSEGHI, hi);
+        shadow_hi = hi;
+    }
+    if(lo != shadow_lo) {
+        NX4IO_SSEG_setSSEG_DATA(SSEGLO, lo);
+        shadow_lo = lo;
+    }
+}
+
+/**
+ * sseg_set_heartbeat() - dp7 state, shown at the next sseg_show()
+*/
+void sseg_set_heartbeat(bool on) {
+    heartbeat = on;
+}
@@ -0,0 +1,68 @@
+/**
+ * @file sseg.h
+ *
+ * @authors Stephen, Drew, Noah
+ * @copyright Portland State University, 2023
+ *
+ * @brief
+ * This is the header file for the seven segment display framebuffer.
+ * display() composes both SSEG_DATA banks in RAM with the helpers below
+ * and hands them to sseg_show(), which writes a bank with one
+ * NX4IO_SSEG_setSSEG_DATA() only when it differs from what was last
+ * written. Two digit numbers come from a 0..99 table, so nothing here
+ * divides.
+ *
+ * The dp7 heartbeat from the FIT interrupt is kept here too and ORed in
+ * at sseg_show(), so nothing but sseg_show() writes the digits.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ * ---------------------
+ * Ver  Who Date    Changes
+ * -----------------------------------
+ * 1.00a DS 17-Oct-2026 First release
+ * </pre>
+************************************************************/
+
+#ifndef SSEG_H
+#define SSEG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "nexys4io.h"
+
+/*********Bank Image Helpers****************************/
+// pos is the digit within a bank, 0 (DIGIT0/DIGIT4) to 3 (DIGIT3/DIGIT7)
+#define SSEG_DIGIT_BITS         6
+#define SSEG_DIGIT(pos, cc)     ((uint32_t)(cc) << ((pos) * SSEG_DIGIT_BITS))
+#define SSEG_DP(pos)            ((uint32_t)NEXYS4IO_SSEG_DECPT0_MASK << (pos))
+#define SSEG_DEC2_MAX           99
+
+extern const uint16_t sseg_dec2_lut[SSEG_DEC2_MAX + 1];
+
+/**
+ * sseg_dec2() - a number as two decimal digits in bank positions 1 and 0,
+ * shift left by 2 * SSEG_DIGIT_BITS for positions 3 and 2
+ *
+ * @param       value       shown as 99 if it is larger
+*/
+static inline uint32_t sseg_dec2(uint32_t value) {
+    return sseg_dec2_lut[(value > SSEG_DEC2_MAX) ? SSEG_DEC2_MAX : value];
+}
+
+/**
+ * sseg_show() - writes whichever banks changed since the last call
+ *
+ * @param       hi          SSEGHI image, DIGIT7..DIGIT4
+ * @param       lo          SSEGLO image, DIGIT3..DIGIT0
+*/
+void sseg_show(uint32_t hi, uint32_t lo);
+
+/**
+ * sseg_set_heartbeat() - dp7 state, shown at the next sseg_show()
+ *
+ * @note        safe to call from an interrupt handler
+*/
+void sseg_set_heartbeat(bool on);
+
+#endif
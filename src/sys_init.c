@@ -14,6 +14,19 @@
  * Ver  Who Date    Changes
  * -----------------------------------
  * 1.00a SW 23-Feb-2023 First release
+ * 1.01a DS 17-Oct-2026 Start the stage profiler timestamp (STAGE_PROFILE)
+ * 1.02a DS 17-Oct-2026 Connect the nexys4io/PmodENC544 input interrupts
+ * 1.03a DS 17-Oct-2026 Set the PWM carrier to HB3_PWM_CARRIER_HZ
+ * 1.04a DS 17-Oct-2026 Look for a warm restart state
+ * 1.05a DS 17-Oct-2026 Start the timebase.h 64 bit clock first
+ * 1.06a DS 17-Oct-2026 Report the task behind a watchdog reset
+ * 1.07a DS 17-Oct-2026 Bring up a myHB3ip instance per motor and the
+ *                      PmodENC544 instance
+ * 1.08a DS 17-Oct-2026 Check each myHB3ip has HB3_CHANNELS, only take the
+ *                      sample interrupt from single channel ones
+ * 1.09a DS 17-Oct-2026 HB3_FABRIC_PID checks myHB3ip has the fabric PID
+ * 1.10a DS 17-Oct-2026 HB3_PWM_CARRIER_HZ 0 keeps the reset carrier
+ * 1.11a DS 17-Oct-2026 HB3_Inst and ENC_Inst are defined here
  * </pre>
 ************************************************************/
 
@@ -25,6 +38,11 @@
 #include "cntrl_logic.h"
 #include "logger.h"
 #include "wdt.h"
+#include "ctrl_tick.h"
+#include "profile.h"
+#include "input_events.h"
+#include "warm_start.h"
+#include "timebase.h"
 
 /*********Peripheral Device Constants****************************/
 //Definition for Interrupt Controller
@@ -33,6 +51,12 @@
 
 /********** AXI Peripheral Instances **********/
 XIntc 		INTC_Inst;		// Interrupt Controller instance
+hb3_t		HB3_Inst[HB3_NUM_IP];	// myHB3ip, HB3_CHANNELS motors each
+pmodenc544_t	ENC_Inst;		// PmodENC544
+
+/********************Local File Variables********************/
+static const uint32_t hb3_base[HB3_NUM_IP] = HB3_BA_LIST;
+static const uint8_t hb3_intr[HB3_NUM_IP] = HB3_INTR_LIST;
 
 
 /**
@@ -45,24 +69,62 @@ XIntc 		INTC_Inst;		// Interrupt Controller instance
 */
 int system_init(void) {
     uint32_t status;
+    wdt_fault_t fault;
 
     // initialize hardware specific setups
     init_platform();
 
+	// start the 64 bit clock everything else timestamps from
+	status = timebase_init();
+	if (status != XST_SUCCESS)
+	{
+		xil_printf("Timebase timer didn't initialize\r\n");
+		return XST_FAILURE;
+	}
+
 	// initialize uartlite
-    uartlite_init(); 
+    status = uartlite_init();
+	if (status != XST_SUCCESS)
+	{
+		xil_printf("Uartlite didn't initialize\r\n");
+		return XST_FAILURE;
+	}
 
     // init hardware peripherals
     // initialize the PMOD Encoder
-    status = PMODENC544_initialize(PMODENC_BA);
+    status = PMODENC544_initialize(&ENC_Inst, PMODENC_BA);
     if (status != XST_SUCCESS){
     	return XST_FAILURE;
     }
 
-	// initialize the PMOD HB3
-	status = HB3_initialize(HB3_BA);
-	if (status != XST_SUCCESS)
-		return XST_FAILURE;
+	// initialize the PMOD HB3s, HB3_CHANNELS motors each
+	for (uint32_t i = 0; i < HB3_NUM_IP; i++)
+	{
+		status = HB3_initialize(&HB3_Inst[i], hb3_base[i]);
+		if (status != XST_SUCCESS)
+			return XST_FAILURE;
+		if (HB3_getChannels(&HB3_Inst[i]) < HB3_CHANNELS)
+		{
+			xil_printf("myHB3ip %d has fewer than HB3_CHANNELS channels\r\n", i);
+			return XST_FAILURE;
+		}
+#if HB3_FABRIC_PID
+		if (!HB3_hasFabricPID(&HB3_Inst[i]))
+		{
+			xil_printf("myHB3ip %d was built without PID_ACCEL\r\n", i);
+			return XST_FAILURE;
+		}
+#endif
+#if HB3_PWM_CARRIER_HZ
+		HB3_setPWMCarrier(&HB3_Inst[i], HB3_PWM_CARRIER_HZ);
+#endif
+	}
+
+	// a state saved before a watchdog reset is resumed by init_IO_struct()
+	if (warm_start_boot())
+		xil_printf("Warm restart state found\r\n");
+	if (wdt_last_fault(&fault))
+		xil_printf("Watchdog reset: %s missed its heartbeat by %d us\r\n", fault.name, fault.late_us);
 
 	// initialize the Nexys4 driver
 	status = NX4IO_initialize(N4IO_BASEADDR);
@@ -104,6 +166,50 @@ int system_init(void) {
 		return XST_FAILURE;
 	}
 
+#if CTRL_TICK_MODE
+	// set up the control tick timer and connect its handler
+	status = ctrl_tick_init(&INTC_Inst);
+	if (status != XST_SUCCESS)
+	{
+		xil_printf("Control tick timer didn't initialize\r\n");
+		return XST_FAILURE;
+	}
+#endif
+
+#ifdef STAGE_PROFILE
+	// the stage profiler timestamps off the timebase
+	profile_reset();
+#endif
+
+	// connect the uartlite interrupt that drains the telemetry ring
+	status = uartlite_intr_init(&INTC_Inst);
+	if (status != XST_SUCCESS)
+	{
+		xil_printf("Uartlite handler didn't register\r\n");
+		return XST_FAILURE;
+	}
+
+	// connect the myHB3ip new sample interrupts, each with its own instance
+	for (uint32_t i = 0; i < HB3_NUM_IP; i++)
+	{
+		status = XIntc_Connect(&INTC_Inst, hb3_intr[i],
+							   (XInterruptHandler)HB3_SampleHandler,
+							   &HB3_Inst[i]);
+		if (status != XST_SUCCESS)
+		{
+			xil_printf("HB3 sample handler didn't register\r\n");
+			return XST_FAILURE;
+		}
+	}
+
+	// connect the nexys4io and PmodENC544 input change interrupts
+	status = input_events_init(&INTC_Inst);
+	if (status != XST_SUCCESS)
+	{
+		xil_printf("Input event handlers didn't register\r\n");
+		return XST_FAILURE;
+	}
+
 	// connect the interrupt handler for the WDT
 	status = XIntc_Connect(&INTC_Inst, WDT_INTR_NUM,
 							(XInterruptHandler)WDTHandler,
@@ -125,6 +231,21 @@ int system_init(void) {
     // enable/disable the interrupts
 	XIntc_Enable(&INTC_Inst, FIT_INTR_NUM);
 	XIntc_Enable(&INTC_Inst, WDT_INTR_NUM);
+	XIntc_Enable(&INTC_Inst, UARTLITE_INTR_NUM);
+	for (uint32_t i = 0; i < HB3_NUM_IP; i++)
+	{
+		// a multi-channel myHB3ip is latched by the control step instead,
+		// the enabled source still picks the speed it latches
+#if HB3_CHANNELS == 1
+		XIntc_Enable(&INTC_Inst, hb3_intr[i]);
+#endif
+		HB3_enableSampleInterrupt(&HB3_Inst[i], HB3_SAMPLE_SOURCE);
+	}
+	input_events_start();
+#if CTRL_TICK_MODE
+	XIntc_Enable(&INTC_Inst, CTRL_TMR_INTR_NUM);
+	ctrl_tick_start();
+#endif
 
 	XWdtTb_Start(&WDTTB_Inst); // restart the timer for the watchdog timer
 	return XST_SUCCESS;
@@ -0,0 +1,116 @@
+/**
+ * @file task_sched.c
+ *
+ * @authors Stephen, Drew, Noah
+ * @copyright Portland State University, 2023
+ *
+ * @brief
+ * This is the source file for the main loop task scheduler. See task_sched.h.
+ * Execution times are taken in clocks off the timebase low word, release
+ * times in clocks off the whole 64 bits.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ * ---------------------
+ * Ver  Who Date    Changes
+ * -----------------------------------
+ * 1.00a DS 17-Oct-2026 First release
+ * </pre>
+************************************************************/
+
+#include "xil_printf.h"
+#include "task_sched.h"
+#include "timebase.h"
+#include "wdt.h"
+
+/********************Local File Variables********************/
+static ptr_sched_task_t sched_tasks = NULL;
+static uint32_t sched_num_tasks = 0;
+
+/**
+ * sched_init() - takes the task table, releases every task now and
+ * starts the watchdog on the ones with a heartbeat window
+*/
+void sched_init(ptr_sched_task_t tasks, uint32_t num_tasks) {
+    uint64_t now = tb_clocks();
+
+    sched_tasks = tasks;
+    sched_num_tasks = num_tasks;
+    for(uint32_t i = 0; i < num_tasks; i++) {
+        tasks[i].period_clks = (uint32_t)tb_us_to_clocks(tasks[i].period_us);
+        tasks[i].budget_clks = (uint32_t)tb_us_to_clocks(tasks[i].budget_us);
+        tasks[i].release = now;
+        tasks[i].stats = (sched_stats_t){0};
+        wdt_watch(i, tasks[i].name, tasks[i].window_us);
+    }
+}
+
+/**
+ * sched_run() - runs the highest priority released task, if any
+*/
+bool sched_run(void) {
+    uint64_t now = tb_clocks();
+    ptr_sched_task_t task = NULL;
+
+    for(uint32_t i = 0; i < sched_num_tasks; i++) {
+        ptr_sched_task_t t = &sched_tasks[i];
+
+        if(t->period_clks != 0 && !tb_before(now, t->release) &&
+           (task == NULL || t->priority < task->priority)) {
+            task = t;
+        }
+    }
+    if(task == NULL) {
+        return false;
+    }
+
+    ptr_sched_stats_t s = &task->stats;
+    uint32_t late = (uint32_t)(now - task->release);
+    uint32_t start = tb_clocks32();
+
+    PROFILE_STAGE(task->stage, task->run());
+
+    uint32_t exec = tb_clocks32() - start;
+    wdt_heartbeat(task - sched_tasks);
+    s->runs++;
+    s->exec_last = exec;
+    if(exec > s->exec_max) {
+        s->exec_max = exec;
+    }
+    if(late > s->late_max) {
+        s->late_max = late;
+    }
+    if(exec > task->budget_clks) {
+        s->overruns++;
+    }
+    if(tb_before(task->release + task->period_clks, tb_clocks())) {
+        s->misses++;
+    }
+    s->skipped += tb_deadline_next(&task->release, task->period_clks);
+    return true;
+}
+
+/**
+ * sched_get_stats() - copies out one task's counters
+*/
+void sched_get_stats(uint32_t id, ptr_sched_stats_t stats) {
+    *stats = sched_tasks[id].stats;
+}
+
+/**
+ * sched_report() - prints every task's counters to the console
+*/
+void sched_report(void) {
+    xil_printf("Tasks:      period(us)  runs  exec max(clks)  late max(us)  misses  overruns  skipped\r\n");
+    for(uint32_t i = 0; i < sched_num_tasks; i++) {
+        ptr_sched_task_t t = &sched_tasks[i];
+        sched_stats_t s;
+
+        if(t->period_us == 0) {
+            continue;
+        }
+        sched_get_stats(i, &s);
+        xil_printf("  %-10s %8d %6d %14d %13d %7d %9d %8d\r\n", t->name, t->period_us, s.runs,
+                   s.exec_max, (uint32_t)tb_clocks_to_us(s.late_max), s.misses, s.overruns, s.skipped);
+    }
+}
@@ -0,0 +1,116 @@
+/**
+ * @file task_sched.h
+ *
+ * @authors Stephen, Drew, Noah
+ * @copyright Portland State University, 2023
+ *
+ * @brief
+ * This is the header file for the main loop task scheduler. main.c keeps a
+ * static table of tasks, each with a period, a priority and an execution
+ * budget, and the main loop calls sched_run() over and over. A call runs
+ * at most one task: the highest priority one whose release time has come,
+ * so a low priority task can hold up the control task for at most one run
+ * of itself. Nothing is preempted; the control tick interrupt still runs
+ * over the top of all of it in CTRL_TICK_MODE.
+ *
+ * Each task's next release is its last release plus its period, so rates
+ * do not drift with how late a task started. A task still running when its
+ * next release came is a deadline miss, and releases it fell a whole
+ * period behind on are skipped and counted rather than run back to back.
+ * Running longer than its budget is counted as an overrun. With SW15 on
+ * the per task counters go to the console next to the control tick ones.
+ *
+ * The table is written in us. sched_init() turns the period and budget
+ * into clocks, and releases, lateness and execution times are kept in
+ * clocks, so a pass never converts; only the report does.
+ *
+ * A task with a heartbeat window is watched by wdt.h and beats each time
+ * it runs. A task the scheduler does not run (the control step in
+ * CTRL_TICK_MODE) beats from wherever it does run.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ * ---------------------
+ * Ver  Who Date    Changes
+ * -----------------------------------
+ * 1.00a DS 17-Oct-2026 First release
+ * </pre>
+************************************************************/
+
+#ifndef TASK_SCHED_H
+#define TASK_SCHED_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ctrl_tick.h"
+#include "profile.h"
+
+/*********Task Rates****************************/
+#define SCHED_CONTROL_PERIOD_US     (1000000 / CTRL_TICK_HZ)    // control_pid(), !CTRL_TICK_MODE only
+#define SCHED_INPUT_PERIOD_US       20000       // 50 Hz, applying queued input events
+#define SCHED_DISPLAY_PERIOD_US     50000       // 20 Hz, seven segment and LEDs
+#define SCHED_TELEMETRY_PERIOD_US   500000      // main loop telemetry send, 2 Hz
+
+/*********Scheduler Structs****************************/
+typedef enum sched_task_id {
+    SCHED_CONTROL = 0,
+    SCHED_INPUT,
+    SCHED_DISPLAY,
+    SCHED_TELEMETRY,
+    SCHED_NUM_TASKS
+} sched_task_id_t;
+
+typedef struct sched_stats {
+    uint32_t runs;
+    uint32_t exec_last;         // clocks
+    uint32_t exec_max;
+    uint32_t late_max;          // release to start, clocks
+    uint32_t misses;            // still running at its next release
+    uint32_t overruns;          // ran past its budget
+    uint32_t skipped;           // releases dropped after falling behind
+} sched_stats_t, *ptr_sched_stats_t;
+
+typedef struct sched_task {
+    const char *name;
+    void (*run)(void);
+    uint32_t period_us;         // 0 never releases it
+    uint8_t priority;           // 0 is the highest
+    uint32_t budget_us;
+    uint32_t window_us;         // wdt.h heartbeat window, 0 unwatched
+    profile_stage_t stage;      // STAGE_PROFILE stage it is charged to
+    uint32_t period_clks;       // set by sched_init()
+    uint32_t budget_clks;
+    uint64_t release;           // next release, tb_clocks() time
+    sched_stats_t stats;
+} sched_task_t, *ptr_sched_task_t;
+
+/**
+ * sched_init() - takes the task table, releases every task now and
+ * starts the watchdog on the ones with a heartbeat window
+ *
+ * @param       tasks       the table, kept for good
+ * @param       num_tasks   entries in it
+*/
+void sched_init(ptr_sched_task_t tasks, uint32_t num_tasks);
+
+/**
+ * sched_run() - runs the highest priority released task, if any
+ *
+ * @return      true if a task ran
+*/
+bool sched_run(void);
+
+/**
+ * sched_get_stats() - copies out one task's counters
+ *
+ * @param       id          task table index
+ * @param       stats       filled in
+*/
+void sched_get_stats(uint32_t id, ptr_sched_stats_t stats);
+
+/**
+ * sched_report() - prints every task's counters to the console
+*/
+void sched_report(void);
+
+#endif
@@ -0,0 +1,159 @@
+/**
+ * @file telemetry.c
+ *
+ * @authors Stephen, Drew, Noah
+ * @copyright Portland State University, 2023
+ *
+ * @brief
+ * This is the source file for the binary telemetry frame. The payload is
+ * packed a byte at a time so the layout does not depend on struct padding.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ * ---------------------
+ * Ver  Who Date    Changes
+ * -----------------------------------
+ * 1.00a DS 17-Oct-2026 First release
+ * </pre>
+************************************************************/
+
+#include "telemetry.h"
+
+// CRC-16/CCITT-FALSE a nibble at a time, small enough to keep in BRAM
+static const uint16_t crc16_nibble[16] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+/**
+ * put_u16()/put_u32() - store little-endian
+*/
+static uint8_t *put_u16(uint8_t *p, uint16_t v) {
+    p[0] = v;
+    p[1] = v >> 8;
+    return p + 2;
+}
+
+static uint8_t *put_u32(uint8_t *p, uint32_t v) {
+    p[0] = v;
+    p[1] = v >> 8;
+    p[2] = v >> 16;
+    p[3] = v >> 24;
+    return p + 4;
+}
+
+/**
+ * telemetry_crc16() - CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF)
+ *
+ * @param       data, len   bytes to check
+ *
+ * @return      the crc
+*/
+uint16_t telemetry_crc16(const uint8_t *data, uint32_t len) {
+    uint16_t crc = 0xFFFF;
+
+    for (uint32_t n = 0; n < len; n++) {
+        crc = (crc << 4) ^ crc16_nibble[(crc >> 12) ^ (data[n] >> 4)];
+        crc = (crc << 4) ^ crc16_nibble[(crc >> 12) ^ (data[n] & 0x0F)];
+    }
+    return crc;
+}
+
+/**
+ * telemetry_cobs_encode() - COBS encodes a buffer, no sync byte is added
+ *
+ * @brief       each zero is replaced by the distance to the next zero, with
+ *              a leading code byte for the first run
+ *
+ * @param       src, len    bytes to encode, len < 254
+ * @param       dst         output, at least len + 1 bytes
+ *
+ * @return      encoded length
+*/
+uint32_t telemetry_cobs_encode(const uint8_t *src, uint32_t len, uint8_t *dst) {
+    uint32_t code_idx = 0;          // where the current run's code byte goes
+    uint32_t out = 1;
+    uint8_t code = 1;
+
+    for (uint32_t n = 0; n < len; n++) {
+        if (src[n] == 0) {
+            dst[code_idx] = code;
+            code_idx = out++;
+            code = 1;
+        }
+        else {
+            dst[out++] = src[n];
+            code++;
+        }
+    }
+    dst[code_idx] = code;
+    return out;
+}
+
+/**
+ * telemetry_frame() - adds the CRC to a filled payload, COBS encodes it
+ * and ends it with the sync byte
+*/
+static uint32_t telemetry_frame(uint8_t *payload, uint8_t *frame) {
+    uint32_t len;
+
+    put_u16(payload + TELEMETRY_PAYLOAD_SIZE, telemetry_crc16(payload, TELEMETRY_PAYLOAD_SIZE));
+    len = telemetry_cobs_encode(payload, TELEMETRY_PAYLOAD_SIZE + TELEMETRY_CRC_SIZE, frame);
+    frame[len++] = TELEMETRY_SYNC;
+    return len;
+}
+
+/**
+ * telemetry_encode() - builds a complete frame for one sample
+ *
+ * @param       sample      sample to send
+ * @param       frame       output, at least TELEMETRY_FRAME_MAX bytes
+ *
+ * @return      frame length including the sync byte
+*/
+uint32_t telemetry_encode(const telemetry_sample_t *sample, uint8_t *frame) {
+    uint8_t payload[TELEMETRY_PAYLOAD_SIZE + TELEMETRY_CRC_SIZE];
+    uint8_t *p = payload;
+
+    *p++ = TELEMETRY_VERSION;
+    *p++ = sample->seq;
+    p = put_u32(p, sample->timestamp_us);
+    p = put_u16(p, sample->set_rpm);
+    p = put_u16(p, sample->read_rpm);
+    *p++ = sample->kp;
+    *p++ = sample->ki;
+    *p++ = sample->kd;
+    *p++ = sample->pid_sel;
+    p = put_u16(p, sample->pwm);
+    p = put_u32(p, (uint32_t)sample->error);
+    p = put_u32(p, (uint32_t)sample->integrator);
+    return telemetry_frame(payload, frame);
+}
+
+/**
+ * telemetry_encode_autotune() - builds a complete frame for an auto-tune result
+ *
+ * @param       result      result to send
+ * @param       frame       output, at least TELEMETRY_FRAME_MAX bytes
+ *
+ * @return      frame length including the sync byte
+*/
+uint32_t telemetry_encode_autotune(const telemetry_autotune_t *result, uint8_t *frame) {
+    uint8_t payload[TELEMETRY_PAYLOAD_SIZE + TELEMETRY_CRC_SIZE];
+    uint8_t *p = payload;
+
+    *p++ = TELEMETRY_AUTOTUNE;
+    *p++ = result->seq;
+    p = put_u32(p, result->timestamp_us);
+    p = put_u16(p, result->set_rpm);
+    *p++ = result->status;
+    *p++ = result->relay_rpm;
+    *p++ = result->kp;
+    *p++ = result->ki;
+    *p++ = result->kd;
+    *p++ = 0;
+    p = put_u16(p, result->ts_us);
+    p = put_u32(p, (uint32_t)result->ku);
+    p = put_u32(p, result->tu_us);
+    return telemetry_frame(payload, frame);
+}
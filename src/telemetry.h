@@ -0,0 +1,136 @@
+/**
+ * @file telemetry.h
+ *
+ * @authors Stephen, Drew, Noah
+ * @copyright Portland State University, 2023
+ *
+ * @brief
+ * This is the header file for the binary telemetry frame sent to
+ * logger/plot_display.py. A frame is the little-endian payload below
+ * followed by a CRC-16/CCITT-FALSE of the payload, COBS encoded so it
+ * contains no zero bytes, then a 0x00 sync byte that ends the frame.
+ *
+ * Payload, version 1 (24 bytes):
+ *  off size field
+ *    0   1  version (TELEMETRY_VERSION)
+ *    1   1  sequence number, wraps
+ *    2   4  device timestamp in us, wraps
+ *    6   2  set rpm
+ *    8   2  read rpm
+ *   10   1  Kp
+ *   11   1  Ki
+ *   12   1  Kd
+ *   13   1  PID select bits (Kp 0x4, Ki 0x2, Kd 0x1), 0x80 while auto-tuning
+ *   14   2  PWM count sent to the HB3
+ *   16   4  error, Q16.16 rpm
+ *   20   4  integrator, Q16.16 rpm
+ *
+ * Auto-tune result, same size so the host reads every frame alike, told
+ * apart by TELEMETRY_AUTOTUNE where a sample has its version:
+ *  off size field
+ *    0   1  TELEMETRY_AUTOTUNE
+ *    1   1  sequence number, shared with the samples
+ *    2   4  device timestamp in us
+ *    6   2  set rpm tuned at
+ *    8   1  status (TELEMETRY_AUTOTUNE_OK / _FAILED)
+ *    9   1  relay amplitude, rpm
+ *   10   1  Kp loaded
+ *   11   1  Ki loaded (tenths)
+ *   12   1  Kd loaded
+ *   13   1  reserved, 0
+ *   14   2  mean time between PID steps, us
+ *   16   4  ultimate gain Ku, Q16.16
+ *   20   4  ultimate period Tu, us
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ * ---------------------
+ * Ver  Who Date    Changes
+ * -----------------------------------
+ * 1.00a DS 17-Oct-2026 First release
+ * 1.01a DS 17-Oct-2026 Auto-tune result frame
+ * </pre>
+************************************************************/
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdint.h>
+
+/*********Telemetry Frame Constants****************************/
+#define TELEMETRY_VERSION           1
+#define TELEMETRY_AUTOTUNE          0x41        // first byte of an auto-tune result frame
+#define TELEMETRY_AUTOTUNE_OK       0
+#define TELEMETRY_AUTOTUNE_FAILED   1
+#define TELEMETRY_SEL_AUTOTUNE      0x80        // pid_sel bit, relay experiment running
+#define TELEMETRY_SYNC              0x00        // ends every frame, never appears inside one
+#define TELEMETRY_PAYLOAD_SIZE      24
+#define TELEMETRY_CRC_SIZE          2
+// COBS adds one byte per 254, plus the sync byte
+#define TELEMETRY_FRAME_MAX         (TELEMETRY_PAYLOAD_SIZE + TELEMETRY_CRC_SIZE + 2)
+
+/*********Telemetry Structs****************************/
+typedef struct telemetry_sample {
+    uint8_t seq;
+    uint32_t timestamp_us;
+    uint16_t set_rpm;
+    uint16_t read_rpm;
+    uint8_t kp, ki, kd;
+    uint8_t pid_sel;
+    uint16_t pwm;
+    int32_t error;              // Q16.16
+    int32_t integrator;         // Q16.16
+} telemetry_sample_t, *ptr_telemetry_sample_t;
+
+typedef struct telemetry_autotune {
+    uint8_t seq;
+    uint32_t timestamp_us;
+    uint16_t set_rpm;
+    uint8_t status;
+    uint8_t relay_rpm;
+    uint8_t kp, ki, kd;
+    uint16_t ts_us;
+    int32_t ku;                 // Q16.16
+    uint32_t tu_us;
+} telemetry_autotune_t, *ptr_telemetry_autotune_t;
+
+/**
+ * telemetry_crc16() - CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF)
+ *
+ * @param       data, len   bytes to check
+ *
+ * @return      the crc
+*/
+uint16_t telemetry_crc16(const uint8_t *data, uint32_t len);
+
+/**
+ * telemetry_cobs_encode() - COBS encodes a buffer, no sync byte is added
+ *
+ * @param       src, len    bytes to encode, len < 254
+ * @param       dst         output, at least len + 1 bytes
+ *
+ * @return      encoded length
+*/
+uint32_t telemetry_cobs_encode(const uint8_t *src, uint32_t len, uint8_t *dst);
+
+/**
+ * telemetry_encode() - builds a complete frame for one sample
+ *
+ * @param       sample      sample to send
+ * @param       frame       output, at least TELEMETRY_FRAME_MAX bytes
+ *
+ * @return      frame length including the sync byte
+*/
+uint32_t telemetry_encode(const telemetry_sample_t *sample, uint8_t *frame);
+
+/**
+ * telemetry_encode_autotune() - builds a complete frame for an auto-tune result
+ *
+ * @param       result      result to send
+ * @param       frame       output, at least TELEMETRY_FRAME_MAX bytes
+ *
+ * @return      frame length including the sync byte
+*/
+uint32_t telemetry_encode_autotune(const telemetry_autotune_t *result, uint8_t *frame);
+
+#endif
@@ -0,0 +1,57 @@
+/**
+ * @file timebase.c
+ *
+ * @authors Stephen, Drew, Noah
+ * @copyright Portland State University, 2023
+ *
+ * @brief
+ * This is the source file for the system timebase. The reads are inline in
+ * timebase.h; this starts the counter.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ * ---------------------
+ * Ver  Who Date    Changes
+ * -----------------------------------
+ * 1.00a DS 17-Oct-2026 First release
+ * </pre>
+************************************************************/
+
+#include "timebase.h"
+
+/********** AXI Peripheral Instances **********/
+static XTmrCtr TB_TMR_Inst;         // axi_timer_1
+
+/**
+ * tb_deadline_next() - moves a periodic deadline on by one period
+*/
+uint32_t tb_deadline_next(uint64_t *deadline, uint32_t period_clks) {
+    uint64_t now = tb_clocks();
+    uint32_t skipped = 0;
+
+    *deadline += period_clks;
+    if(tb_before(*deadline, now)) {
+        uint64_t behind = now - *deadline;
+
+        // only divides after falling behind. A stall of over 2^32 clocks
+        // (43 s) is just counted as all of them
+        skipped = (behind >> 32) ? UINT32_MAX : (uint32_t)behind / period_clks + 1;
+        *deadline = now + period_clks;
+    }
+    return skipped;
+}
+
+/**
+ * timebase_init() - starts the 64 bit counter from 0
+*/
+int timebase_init(void) {
+    if(XTmrCtr_Initialize(&TB_TMR_Inst, TB_TMR_DEVICE_ID) != XST_SUCCESS) {
+        return XST_FAILURE;
+    }
+    // timer 1 counts timer 0 carries, both count up from 0 and wrap
+    XTmrCtr_SetOptions(&TB_TMR_Inst, 0, XTC_CASCADE_MODE_OPTION | XTC_AUTO_RELOAD_OPTION);
+    XTmrCtr_SetResetValue(&TB_TMR_Inst, 0, 0);
+    XTmrCtr_SetResetValue(&TB_TMR_Inst, 1, 0);
+    XTmrCtr_Start(&TB_TMR_Inst, 0);
+    return XST_SUCCESS;
+}
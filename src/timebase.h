@@ -0,0 +1,191 @@
+/**
+ * @file timebase.h
+ *
+ * @authors Stephen, Drew, Noah
+ * @copyright Portland State University, 2023
+ *
+ * @brief
+ * This is the header file for the system timebase. axi_timer_1 runs its two
+ * timers cascaded as one 64 bit up counter at the AXI clock, started once
+ * by timebase_init() and never reloaded, so it does not wrap in the life
+ * of the board. Everything that needs the time (telemetry stamps, the
+ * once a second send, profiling, rate measurements) reads it from here.
+ *
+ * A read is three bus reads and no interrupt, so it is safe from handlers
+ * and the main loop alike. There is no divider, so tb_now_us() scales by
+ * the clock rate with reciprocal multiplies, no libgcc divide. Anything
+ * run every pass (task releases, heartbeats) stays in clocks and only
+ * converts for reports.
+ *
+ * Times are uint64_t us and never wrap. Telemetry carries the low 32 bits,
+ * which wrap every ~71 minutes; compare those with tb_before32().
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ * ---------------------
+ * Ver  Who Date    Changes
+ * -----------------------------------
+ * 1.00a DS 17-Oct-2026 First release
+ * </pre>
+************************************************************/
+
+#ifndef TIMEBASE_H
+#define TIMEBASE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "xparameters.h"
+#include "xstatus.h"
+#include "xil_io.h"
+#include "xtmrctr.h"
+
+/*********Peripheral Device Constants****************************/
+// axi_timer_1, both timers cascaded, no interrupt
+#define TB_TMR_DEVICE_ID            XPAR_TMRCTR_1_DEVICE_ID
+#define TB_CLOCK_FREQ_HZ            XPAR_TMRCTR_1_CLOCK_FREQ_HZ
+#define TB_COUNT_LO_ADDR            (XPAR_TMRCTR_1_BASEADDR + XTC_TCR_OFFSET)
+#define TB_COUNT_HI_ADDR            (XPAR_TMRCTR_1_BASEADDR + XTC_TIMER_COUNTER_OFFSET + XTC_TCR_OFFSET)
+
+/*********Timebase Constants****************************/
+#define TB_CLKS_PER_US              (TB_CLOCK_FREQ_HZ / 1000000)
+// 2^32 = TB_WRAP_US * TB_CLKS_PER_US + TB_WRAP_REM, for tb_clocks_to_us()
+#define TB_WRAP_US                  (uint32_t)(0x100000000ULL / TB_CLKS_PER_US)
+#define TB_WRAP_REM                 (uint32_t)(0x100000000ULL % TB_CLKS_PER_US)
+
+/**
+ * tb_clocks() - AXI clocks since timebase_init()
+ *
+ * @brief       Reads the high word on both sides of the low word, so a
+ *              carry between the two reads is not torn.
+*/
+static inline uint64_t tb_clocks(void) {
+    uint32_t hi = Xil_In32(TB_COUNT_HI_ADDR);
+    uint32_t lo = Xil_In32(TB_COUNT_LO_ADDR);
+    uint32_t hi2 = Xil_In32(TB_COUNT_HI_ADDR);
+
+    if(hi2 != hi) {
+        // the low word wrapped, it is near 0 again
+        lo = Xil_In32(TB_COUNT_LO_ADDR);
+    }
+    return ((uint64_t)hi2 << 32) | lo;
+}
+
+/**
+ * tb_clocks32() - low word of tb_clocks(), for timing short intervals
+*/
+static inline uint32_t tb_clocks32(void) {
+    return Xil_In32(TB_COUNT_LO_ADDR);
+}
+
+/**
+ * tb_div_clks() - n / TB_CLKS_PER_US without a divide
+ *
+ * @brief       n * (2^32 / C) >> 32 is the quotient or one short of it,
+ *              the remainder says which.
+ *
+ * @param       n           32 bit dividend
+ * @param       rem         n % TB_CLKS_PER_US
+*/
+static inline uint32_t tb_div_clks(uint32_t n, uint32_t *rem) {
+    uint32_t q = (uint32_t)(((uint64_t)n * TB_WRAP_US) >> 32);
+    uint32_t r = n - q * TB_CLKS_PER_US;
+
+    if(r >= TB_CLKS_PER_US) {
+        q++;
+        r -= TB_CLKS_PER_US;
+    }
+    *rem = r;
+    return q;
+}
+
+/**
+ * tb_clocks_to_us() - clocks to us, rounded down
+ *
+ * @brief       hi:lo / C as (hi / C) << 32 + (hi % C) * (2^32 / C) +
+ *              lo / C + ((hi % C) * (2^32 % C) + lo % C) / C, each of the
+ *              three divides a tb_div_clks().
+*/
+static inline uint64_t tb_clocks_to_us(uint64_t clocks) {
+    uint32_t hi_rem, lo_rem, tail_rem;
+    uint32_t hi_q = tb_div_clks((uint32_t)(clocks >> 32), &hi_rem);
+    uint32_t lo_q = tb_div_clks((uint32_t)clocks, &lo_rem);
+    uint32_t tail_q = tb_div_clks(hi_rem * TB_WRAP_REM + lo_rem, &tail_rem);
+
+    // hi_rem * TB_WRAP_US is below 2^32
+    return ((uint64_t)hi_q << 32) + hi_rem * TB_WRAP_US + lo_q + tail_q;
+}
+
+/**
+ * tb_us_to_clocks() - us to clocks
+*/
+static inline uint64_t tb_us_to_clocks(uint64_t us) {
+    return us * TB_CLKS_PER_US;
+}
+
+/**
+ * tb_now_us() - us since timebase_init()
+*/
+static inline uint64_t tb_now_us(void) {
+    return tb_clocks_to_us(tb_clocks());
+}
+
+/**
+ * tb_before() - a is earlier than b
+*/
+static inline bool tb_before(uint64_t a, uint64_t b) {
+    return (int64_t)(a - b) < 0;
+}
+
+/**
+ * tb_before32() - a is earlier than b for 32 bit us stamps, right as long
+ * as they are within ~35 minutes of each other
+*/
+static inline bool tb_before32(uint32_t a, uint32_t b) {
+    return (int32_t)(a - b) < 0;
+}
+
+/**
+ * tb_elapsed_us() - us since an earlier tb_now_us()
+*/
+static inline uint64_t tb_elapsed_us(uint64_t since) {
+    return tb_now_us() - since;
+}
+
+/**
+ * tb_deadline() - the tb_now_us() time us from now
+*/
+static inline uint64_t tb_deadline(uint64_t us) {
+    return tb_now_us() + us;
+}
+
+/**
+ * tb_expired() - true once a deadline has been reached
+*/
+static inline bool tb_expired(uint64_t deadline) {
+    return !tb_before(tb_now_us(), deadline);
+}
+
+/**
+ * tb_deadline_next() - moves a periodic deadline on by one period
+ *
+ * @brief       Steps from the old deadline rather than from now so the
+ *              period does not drift. If the caller fell more than a
+ *              period behind, the missed periods are skipped and it
+ *              restarts a period from now instead of firing back to back.
+ *
+ * @param       deadline    the deadline that expired, tb_clocks() time,
+ *                          updated
+ * @param       period_clks period in clocks
+ *
+ * @return      periods skipped, 0 if it kept up
+*/
+uint32_t tb_deadline_next(uint64_t *deadline, uint32_t period_clks);
+
+/**
+ * timebase_init() - starts the 64 bit counter from 0
+ *
+ * @return      XST_SUCCESS if the timer is running
+*/
+int timebase_init(void);
+
+#endif
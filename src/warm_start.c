@@ -0,0 +1,152 @@
+/**
+ * @file warm_start.c
+ *
+ * @authors Stephen, Drew, Noah
+ * @copyright Portland State University, 2023
+ *
+ * @brief
+ * This is the source file for the warm restart store. See warm_start.h.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ * ---------------------
+ * Ver  Who Date    Changes
+ * -----------------------------------
+ * 1.00a DS 17-Oct-2026 First release
+ * </pre>
+************************************************************/
+
+#include <stddef.h>
+#include "warm_start.h"
+
+/*********Local Constants****************************/
+#define WARM_SUM_WORDS      (offsetof(warm_store_t, checksum) / sizeof(uint16_t))
+
+/********************Global Variables********************/
+warm_store_t warm_store[WARM_COPIES] WARM_RETAINED;
+
+/********************Local File Variables********************/
+static int32_t active = -1;                 // copy holding the current state, -1 for none
+static bool resumed = false;
+static volatile uint32_t regulated_us = 0;
+
+/**
+ * warm_checksum() - Fletcher-32 over a copy, folded instead of taking a
+ * modulo since there is no divider
+*/
+static uint32_t warm_checksum(const warm_store_t *s) {
+    const uint16_t *w = (const uint16_t *)s;
+    uint32_t a = 0xFFFF;
+    uint32_t b = 0xFFFF;
+
+    for(uint32_t i = 0; i < WARM_SUM_WORDS; i++) {
+        a += w[i];
+        b += a;
+        // keep both below 2^17 so they never overflow
+        a = (a & 0xFFFF) + (a >> 16);
+        b = (b & 0xFFFF) + (b >> 16);
+    }
+    a = (a & 0xFFFF) + (a >> 16);
+    b = (b & 0xFFFF) + (b >> 16);
+    return (b << 16) | a;
+}
+
+/**
+ * warm_valid() - magic and checksum both good
+*/
+static bool warm_valid(const warm_store_t *s) {
+    return s->magic == WARM_MAGIC && s->checksum == warm_checksum(s);
+}
+
+/**
+ * warm_write() - rewrites one copy and seals it with the checksum
+*/
+static void warm_write(uint32_t copy, uint32_t seq, uint32_t restarts, const warm_ctrl_t *ctrl) {
+    warm_store_t *s = &warm_store[copy];
+
+    // a reset part way through leaves a checksum that does not match
+    s->seq = seq;
+    s->restarts = restarts;
+    s->ctrl = *ctrl;
+    s->magic = WARM_MAGIC;
+    s->checksum = warm_checksum(s);
+    active = copy;
+}
+
+/**
+ * warm_start_boot() - looks for a saved state, from system_init()
+*/
+bool warm_start_boot(void) {
+    active = -1;
+    resumed = false;
+    regulated_us = 0;
+    for(int32_t i = 0; i < WARM_COPIES; i++) {
+        if(warm_valid(&warm_store[i]) &&
+           (active < 0 || (int32_t)(warm_store[i].seq - warm_store[active].seq) > 0)) {
+            active = i;
+        }
+    }
+    if(active < 0) {
+        return false;
+    }
+    if(warm_store[active].restarts >= WARM_MAX_RESTARTS) {
+        // it keeps resetting from this state, start cold and forget it
+        for(int32_t i = 0; i < WARM_COPIES; i++) {
+            warm_store[i].magic = 0;
+        }
+        active = -1;
+        return false;
+    }
+    // count this restart against the state so a reset loop ends
+    warm_write(active ^ 1, warm_store[active].seq + 1, warm_store[active].restarts + 1,
+               &warm_store[active].ctrl);
+    resumed = true;
+    return true;
+}
+
+/**
+ * warm_start_get() - the state warm_start_boot() found
+*/
+bool warm_start_get(ptr_warm_ctrl_t ctrl) {
+    if(!resumed) {
+        return false;
+    }
+    *ctrl = warm_store[active].ctrl;
+    return true;
+}
+
+/**
+ * warm_start_save() - stores a new controller state, control step only
+*/
+void warm_start_save(const warm_ctrl_t *ctrl) {
+    if(active < 0) {
+        warm_write(0, 0, 0, ctrl);
+    }
+    else {
+        warm_write(active ^ 1, warm_store[active].seq + 1, warm_store[active].restarts, ctrl);
+    }
+}
+
+/**
+ * warm_start_regulated() - the loop is back in regulation
+*/
+void warm_start_regulated(uint32_t us) {
+    regulated_us = us;
+    if(active >= 0 && warm_store[active].restarts != 0) {
+        warm_write(active ^ 1, warm_store[active].seq + 1, 0, &warm_store[active].ctrl);
+    }
+}
+
+/**
+ * warm_start_regulated_us() - device time from reset to regulation
+*/
+uint32_t warm_start_regulated_us(void) {
+    return regulated_us;
+}
+
+/**
+ * warm_start_resumed() - true if this boot resumed a saved state
+*/
+bool warm_start_resumed(void) {
+    return resumed;
+}
@@ -0,0 +1,123 @@
+/**
+ * @file warm_start.h
+ *
+ * @authors Stephen, Drew, Noah
+ * @copyright Portland State University, 2023
+ *
+ * @brief
+ * This is the header file for the warm restart store. The control step
+ * saves the controller state (gains, PID select, setpoint, integrator and
+ * output) here whenever it changes, and after a watchdog reset
+ * system_init() finds it again so init_IO_struct() resumes where the loop
+ * left off instead of starting with everything zeroed.
+ *
+ * The store is in the .noinit section of the local BRAM. A WDT reset only
+ * resets the logic, so BRAM keeps its contents and crt0 does not clear
+ * .noinit like it does .bss. Reprogramming the FPGA or a power cycle
+ * loses it. lscript.ld should place it as
+ *     .noinit (NOLOAD) : { *(.noinit) } > <the local BRAM region>
+ * so an ELF download does not overwrite it either.
+ *
+ * There are two copies with a sequence number and a Fletcher-32 checksum.
+ * A save writes the older copy, so a reset part way through a save still
+ * leaves the previous state. After WARM_MAX_RESTARTS warm restarts in a
+ * row that never got back into regulation the store is ignored, so a
+ * state that keeps tripping the watchdog cannot loop forever.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ * ---------------------
+ * Ver  Who Date    Changes
+ * -----------------------------------
+ * 1.00a DS 17-Oct-2026 First release
+ * </pre>
+************************************************************/
+
+#ifndef WARM_START_H
+#define WARM_START_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pid_fixed.h"
+
+/*********Warm Start Constants****************************/
+#define WARM_MAGIC                  0x57524D31  // "WRM1", change with the layout
+#define WARM_COPIES                 2
+#define WARM_MAX_RESTARTS           3           // cold start after this many in a row
+#define WARM_REG_BAND_RPM           2           // regulating when |error| is within this
+#define WARM_REG_SAMPLES            8           // for this many tach samples in a row
+#define WARM_RETAINED               __attribute__((section(".noinit")))
+
+/*********Warm Start Structs****************************/
+/** controller state, filled in and applied by cntrl_logic.c */
+typedef struct warm_ctrl {
+    uint8_t kp, ki, kd;
+    uint8_t pid_sel;            // PID_control_sel
+    uint8_t count;              // rotary count the setpoint came from
+    uint8_t set_mode;
+    uint8_t pwm_enable;
+    uint8_t reserved;
+    uint16_t setpoint;          // PWM count
+    uint16_t pwm_out;           // PWM count the control step last drove
+    q16_t integrator;
+    q16_t prev_error;
+    int32_t correction;         // rpm, last P/I/D correction
+} warm_ctrl_t, *ptr_warm_ctrl_t;
+
+typedef struct warm_store {
+    uint32_t magic;
+    uint32_t seq;               // the newer valid copy wins
+    uint32_t restarts;          // warm restarts since the loop last regulated
+    warm_ctrl_t ctrl;
+    uint32_t checksum;          // Fletcher-32 over everything above
+} warm_store_t, *ptr_warm_store_t;
+
+extern warm_store_t warm_store[WARM_COPIES];
+
+/**
+ * warm_start_boot() - looks for a saved state, from system_init()
+ *
+ * @brief       Picks the newest copy with a good magic and checksum and
+ *              counts the restart against it.
+ *
+ * @return      true if init_IO_struct() should resume from it
+*/
+bool warm_start_boot(void);
+
+/**
+ * warm_start_get() - the state warm_start_boot() found
+ *
+ * @param       ctrl        filled in if there is one
+ *
+ * @return      true if there is a state to resume from
+*/
+bool warm_start_get(ptr_warm_ctrl_t ctrl);
+
+/**
+ * warm_start_save() - stores a new controller state, control step only
+ *
+ * @brief       Writes the older copy and leaves the newer one alone until
+ *              the write is finished and checksummed.
+*/
+void warm_start_save(const warm_ctrl_t *ctrl);
+
+/**
+ * warm_start_regulated() - the loop is back in regulation, clears the
+ * restart count and records when, control step only
+ *
+ * @param       us          device time since reset
+*/
+void warm_start_regulated(uint32_t us);
+
+/**
+ * warm_start_regulated_us() - device time from reset to regulation, 0 if
+ * it has not got there yet
+*/
+uint32_t warm_start_regulated_us(void);
+
+/**
+ * warm_start_resumed() - true if this boot resumed a saved state
+*/
+bool warm_start_resumed(void);
+
+#endif
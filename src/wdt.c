@@ -1,11 +1,12 @@
 /**
- * @file wdt.h
+ * @file wdt.c
  * 
  * @authors Stephen, Drew, Noah
  * @copyright Portland State University, 2023
  * 
  * @brief
- * This is the header file for the watchdog timer functionality
+ * This is the source file for the watchdog timer functionality and the
+ * task heartbeat supervisor. See wdt.h.
  * 
  * <pre>
  * MODIFICATION HISTORY:
@@ -13,16 +14,43 @@
  * Ver  Who Date    Changes
  * -----------------------------------
  * 1.00a SW 23-Feb-2023 First release
+ * 1.01a DS 17-Oct-2026 Only kick while every task heartbeats in its window
+ * 1.02a DS 17-Oct-2026 Stop every motor on expiry
+ * 1.03a DS 17-Oct-2026 Stop every channel of a multi-channel myHB3ip
+ * 1.04a DS 17-Oct-2026 Heartbeats and windows in timebase clocks
  * </pre>
 ************************************************************/
 
 #include <stdbool.h>
+#include <string.h>
+#include "xil_printf.h"
 #include "wdt.h"
 #include "nexys4io.h"
 #include "cntrl_logic.h" // need this for encoder switch value in handler
+#include "timebase.h"
+#include "warm_start.h"
 
 /*************Local File Defines*********************/
 #define WDT_LED         0x00008000
+#define WDT_WINDOW_MAX_CLKS     (UINT32_MAX / 2)    // ~21 s at 100 MHz, gaps stay well short of a wrap
+
+/********************Local File Variables********************/
+// heartbeats are tb_clocks32(), one bus read and an atomic store. Gaps and
+// windows are in clocks and only turned into us for the report and the
+// fault record
+static volatile uint32_t last_beat[WDT_MAX_TASKS];
+static volatile uint32_t window_clks[WDT_MAX_TASKS];   // 0 is not watched
+static uint32_t worst_gap[WDT_MAX_TASKS];               // longest gap seen by wdt_supervise(), clocks
+static const char *task_names[WDT_MAX_TASKS];
+static volatile bool task_fault = false;               // latched until the reset
+static wdt_fault_t wdt_fault WARM_RETAINED;            // survives the reset, like warm_store
+
+/**
+ * wdt_fault_valid() - the record holds a fault from before this boot
+*/
+static bool wdt_fault_valid(const wdt_fault_t *f) {
+    return f->magic == WDT_FAULT_MAGIC && f->check == ~(f->task ^ f->late_us);
+}
 
 /**
  * WDTHandler() - turns on LED15 and restarts WDT
@@ -43,7 +71,7 @@ void WDTHandler(void) {
         NX4IO_setLEDs(WDT_LED | prv_led);
     }
 
-    if(!wdt_crash) {
+    if(!wdt_crash && !task_fault) {
         XWdtTb_RestartWdt(&WDTTB_Inst);
     }
 
@@ -51,6 +79,90 @@ void WDTHandler(void) {
             NX4IO_setLEDs(0x0000FFFF);
             NX410_SSEG_setAllDigits(SSEGHI, CC_BLANK, CC_B, CC_LCY, CC_E, DP_NONE);
             NX410_SSEG_setAllDigits(SSEGLO, CC_B, CC_LCY, CC_E, CC_BLANK, DP_NONE);
-            HB3_setPWM(true, 1); //turn off motor
+            for(uint32_t i = 0; i < CTRL_NUM_MOTORS; i++) {
+                HB3_setChannelPWM(&HB3_Inst[i / HB3_CHANNELS], i % HB3_CHANNELS, true, 1); //turn off motor
+            }
+    }
+}
+
+/**
+ * wdt_watch() - starts watching a task, its window starts now
+*/
+void wdt_watch(uint32_t id, const char *name, uint32_t window) {
+    uint64_t clks = tb_us_to_clocks(window);
+
+    if(id >= WDT_MAX_TASKS) {
+        return;
+    }
+    // the heartbeat first, so the supervisor never sees a stale one
+    task_names[id] = name;
+    worst_gap[id] = 0;
+    last_beat[id] = tb_clocks32();
+    window_clks[id] = (clks > WDT_WINDOW_MAX_CLKS) ? WDT_WINDOW_MAX_CLKS : (uint32_t)clks;
+}
+
+/**
+ * wdt_heartbeat() - the task ran, from the task itself
+*/
+void wdt_heartbeat(uint32_t id) {
+    if(id >= WDT_MAX_TASKS) {
+        return;
+    }
+    last_beat[id] = tb_clocks32();
+}
+
+/**
+ * wdt_supervise() - checks every watched task's last heartbeat, from the
+ * FIT handler
+*/
+void wdt_supervise(void) {
+    uint32_t now = tb_clocks32();
+
+    for(uint32_t i = 0; i < WDT_MAX_TASKS; i++) {
+        uint32_t window = window_clks[i];
+        uint32_t gap = now - last_beat[i];
+
+        if(window == 0) {
+            continue;
+        }
+        if(gap > worst_gap[i]) {
+            worst_gap[i] = gap;
+        }
+        if(gap > window && !task_fault) {
+            // the first one late is the one reported
+            task_fault = true;
+            wdt_fault.task = i;
+            wdt_fault.late_us = (uint32_t)tb_clocks_to_us(gap - window);
+            strncpy(wdt_fault.name, task_names[i], WDT_NAME_LEN - 1);
+            wdt_fault.name[WDT_NAME_LEN - 1] = '\0';
+            wdt_fault.check = ~(wdt_fault.task ^ wdt_fault.late_us);
+            wdt_fault.magic = WDT_FAULT_MAGIC;
+        }
+    }
+}
+
+/**
+ * wdt_last_fault() - the task that caused the last watchdog reset
+*/
+bool wdt_last_fault(ptr_wdt_fault_t fault) {
+    if(!wdt_fault_valid(&wdt_fault)) {
+        return false;
+    }
+    *fault = wdt_fault;
+    wdt_fault.magic = 0;
+    return true;
+}
+
+/**
+ * wdt_report() - prints each watched task's window and longest gap
+*/
+void wdt_report(void) {
+    xil_printf("Heartbeats: window(us)  longest gap(us)%s\r\n",
+               task_fault ? "  FAULT, not kicking" : "");
+    for(uint32_t i = 0; i < WDT_MAX_TASKS; i++) {
+        if(window_clks[i] != 0) {
+            xil_printf("  %-10s %10d %16d\r\n", task_names[i], (uint32_t)tb_clocks_to_us(window_clks[i]),
+                       (uint32_t)tb_clocks_to_us(worst_gap[i]));
+        }
     }
 }
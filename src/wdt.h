@@ -7,15 +7,30 @@
  * @brief
  * This is the header file for the watchdog timer functionality
  * 
+ * The dog is only kicked while every watched task is alive. Each task
+ * calls wdt_heartbeat() when it runs, and wdt_supervise() checks from the
+ * FIT interrupt that none has gone longer than its window without one.
+ * The first task found late latches a fault: WDTHandler() stops kicking,
+ * so the next expiry stops the motor and the one after resets the board,
+ * and the task is written to BRAM so the next boot can say which one it
+ * was. A hung main loop or a stalled control tick then ends in a reset
+ * even though the WDT interrupt itself still fires.
+ * 
  * <pre>
  * MODIFICATION HISTORY:
  * ---------------------
  * Ver  Who Date    Changes
  * -----------------------------------
  * 1.00a SW 23-Feb-2023 First release
+ * 1.01a DS 17-Oct-2026 Only kick while every task heartbeats in its window
  * </pre>
 ************************************************************/
 
+#ifndef WDT_H
+#define WDT_H
+
+#include <stdint.h>
+#include <stdbool.h>
 #include "xparameters.h"
 #include "xwdttb.h"
 
@@ -23,13 +38,67 @@
 #define WDT_INTR_NUM        XPAR_MICROBLAZE_0_AXI_INTC_AXI_TIMEBASE_WDT_0_WDT_INTERRUPT_INTR
 #define WDT_DEVICE_ID       XPAR_AXI_TIMEBASE_WDT_0_DEVICE_ID
 
+/*********Supervisor Constants****************************/
+#define WDT_MAX_TASKS       8
+#define WDT_NAME_LEN        12
+#define WDT_FAULT_MAGIC     0x57444654  // "WDFT"
+
+/*********Supervisor Structs****************************/
+/** the task that stopped the kicks, kept across the reset */
+typedef struct wdt_fault {
+    uint32_t magic;
+    uint32_t task;              // wdt_watch() id
+    uint32_t late_us;           // past its window when it was caught
+    char name[WDT_NAME_LEN];
+    uint32_t check;             // ~(task ^ late_us)
+} wdt_fault_t, *ptr_wdt_fault_t;
+
 /********** AXI Peripheral Instances **********/
 XWdtTb WDTTB_Inst;
 
 /**
  * WDTHandler() - turns on LED15 and restarts WDT
- * unless kill switch is flipped
+ * unless kill switch is flipped or a task missed its heartbeat
  * 
  * @note: tied to INTC in sys_init.c
 */
 void WDTHandler(void);
+
+/**
+ * wdt_watch() - starts watching a task, its window starts now
+ *
+ * @param       id          task number, below WDT_MAX_TASKS
+ * @param       name        for the console and the fault record
+ * @param       window_us   longest gap allowed between heartbeats, 0 stops
+ *                          watching it. Held to ~21 s at 100 MHz
+*/
+void wdt_watch(uint32_t id, const char *name, uint32_t window_us);
+
+/**
+ * wdt_heartbeat() - the task ran, from the task itself
+ *
+ * @param       id          task number, ignored unless below WDT_MAX_TASKS
+*/
+void wdt_heartbeat(uint32_t id);
+
+/**
+ * wdt_supervise() - checks every watched task's last heartbeat, from the
+ * FIT handler
+*/
+void wdt_supervise(void);
+
+/**
+ * wdt_last_fault() - the task that caused the last watchdog reset
+ *
+ * @param       fault       filled in if there is one
+ *
+ * @return      true once after a reset caused by a late task
+*/
+bool wdt_last_fault(ptr_wdt_fault_t fault);
+
+/**
+ * wdt_report() - prints each watched task's window and longest gap
+*/
+void wdt_report(void);
+
+#endif